@@ -25,6 +25,7 @@
 #include <trace_helpers.h>
 #include <config_params.h>
 #include <paths.h>
+#include <core/trace_events.h>
 
 #include <wx/app.h>
 #include <wx/config.h>
@@ -144,6 +145,10 @@ static const wxChar ScreenDPI[] = wxT( "ScreenDPI" );
 static const wxChar EnableUseAuiPerspective[] = wxT( "EnableUseAuiPerspective" );
 static const wxChar HistoryLockStaleTimeout[] = wxT( "HistoryLockStaleTimeout" );
 static const wxChar ZoneFillIterativeRefill[] = wxT( "ZoneFillIterativeRefill" );
+static const wxChar ZoneFillHatchScanline[] = wxT( "ZoneFillHatchScanline" );
+static const wxChar AutoplaceRefinementPasses[] = wxT( "AutoplaceRefinementPasses" );
+static const wxChar MoveDeferredItemThreshold[] = wxT( "MoveDeferredItemThreshold" );
+static const wxChar TraceEventsFile[] = wxT( "TraceEventsFile" );
 
 } // namespace AC_KEYS
 
@@ -335,6 +340,10 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_EnableUseAuiPerspective = false;
     m_HistoryLockStaleTimeout = 300; // 5 minutes default
     m_ZoneFillIterativeRefill = false;
+    m_ZoneFillHatchScanline = true;
+    m_AutoplaceRefinementPasses = 0;
+    m_MoveDeferredItemThreshold = 500;
+    m_TraceEventsFile = wxEmptyString;
 
     loadFromConfigFile();
 }
@@ -652,6 +661,21 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ZoneFillIterativeRefill,
                                                            &m_ZoneFillIterativeRefill, m_ZoneFillIterativeRefill ) );
 
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ZoneFillHatchScanline,
+                                                           &m_ZoneFillHatchScanline, m_ZoneFillHatchScanline ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::AutoplaceRefinementPasses,
+                                                          &m_AutoplaceRefinementPasses,
+                                                          m_AutoplaceRefinementPasses, 0, 1000 ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::MoveDeferredItemThreshold,
+                                                          &m_MoveDeferredItemThreshold,
+                                                          m_MoveDeferredItemThreshold, 0,
+                                                          std::numeric_limits<int>::max() ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_WXSTRING>( true, AC_KEYS::TraceEventsFile,
+                                                               &m_TraceEventsFile, wxS( "" ) ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     m_entries.push_back( std::make_unique<PARAM_CFG_WXSTRING>( true, AC_KEYS::TraceMasks, &m_traceMasks, wxS( "" ) ) );
@@ -668,6 +692,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
         wxLog::AddTraceMask( mask );
     }
 
+    if( !m_TraceEventsFile.IsEmpty() )
+        TRACE_EVENTS::Instance().Start( m_TraceEventsFile.ToStdString() );
+
     dumpCfg( m_entries );
 
     wxLogTrace( kicadTraceCoroutineStack, wxT( "Using coroutine stack size %d" ), m_CoroutineStackSize );
@@ -341,11 +341,11 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
     if( m_cache->Get( tableName, cacheEntry ) )
     {
-        if( cacheEntry.count( aWhere.second ) )
+        if( auto it = cacheEntry->find( aWhere.second ); it != cacheEntry->end() )
         {
             wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - cache hit" ),
                         tableName, aWhere.second );
-            aResult = cacheEntry.at( aWhere.second );
+            aResult = it->second;
             return true;
         }
     }
@@ -358,11 +358,11 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
         if( m_cache->Get( tableName, cacheEntry ) )
         {
-            if( cacheEntry.count( aWhere.second ) )
+            if( auto it = cacheEntry->find( aWhere.second ); it != cacheEntry->end() )
             {
                 wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - cache hit" ),
                             tableName, aWhere.second );
-                aResult = cacheEntry.at( aWhere.second );
+                aResult = it->second;
                 return true;
             }
         }
@@ -545,7 +545,7 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
 
         timer.Stop();
 
-        DB_CACHE_TYPE::CACHE_VALUE cacheEntry;
+        std::map<std::string, ROW> cacheEntry;
 
         auto handleException =
                 [&]( std::runtime_error& aException, const std::string& aExtraContext = "" )
@@ -638,13 +638,13 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
             }
 
             std::string keyStr = std::any_cast<std::string>( result.at( aKey ) );
-            cacheEntry[keyStr] = result;
+            cacheEntry[keyStr] = std::move( result );
         }
 
         wxLogTrace( traceDatabase, wxT( "selectAllAndCache from %s completed in %0.1f ms" ), aTable,
                     timer.msecs() );
 
-        m_cache->Put( aTable, cacheEntry );
+        m_cache->Put( aTable, std::make_shared<const std::map<std::string, ROW>>( std::move( cacheEntry ) ) );
         return true;
     }
     catch( std::exception& e )
@@ -698,9 +698,9 @@ bool DATABASE_CONNECTION::SelectAll( const std::string& aTable, const std::strin
 
     wxLogTrace( traceDatabase, wxT( "SelectAll: `%s` - returning cached results" ), aTable );
 
-    aResults.reserve( cacheEntry.size() );
+    aResults.reserve( cacheEntry->size() );
 
-    for( auto &[ key, row ] : cacheEntry )
+    for( const auto& [ key, row ] : *cacheEntry )
         aResults.emplace_back( row );
 
     return true;
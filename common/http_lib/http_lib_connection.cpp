@@ -21,7 +21,11 @@
 #include <wx/log.h>
 #include <fmt/core.h>
 #include <wx/translation.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <ctime>
+#include <mutex>
 
 #include <boost/algorithm/string.hpp>
 #include <json_common.h>
@@ -32,6 +36,7 @@
 
 #include <http_lib/http_lib_connection.h>
 #include <lib_id.h>
+#include <thread_pool.h>
 
 const char* const traceHTTPLib = "KICAD_HTTP_LIB";
 
@@ -333,55 +338,158 @@ bool HTTP_LIB_CONNECTION::SelectOne( const std::string& aPartID, HTTP_LIB_PART&
 }
 
 
-bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts )
+std::string HTTP_LIB_CONNECTION::fetchCategoryParts( const HTTP_LIB_SOURCE& aSource,
+                                                     KICAD_CURL_EASY& aCurl,
+                                                     const HTTP_LIB_CATEGORY& aCategory,
+                                                     std::vector<HTTP_LIB_PART>& aParts )
 {
-    if( !IsValidEndpoint() )
-    {
-        wxLogTrace( traceHTTPLib, wxT( "SelectAll: without valid connection!" ) );
-        return false;
-    }
-
     std::string res = "";
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-
-    curl->SetURL( m_source.root_url + fmt::format( "parts/category/{}.json", aCategory.id ) );
+    aCurl.SetURL( aSource.root_url + fmt::format( "parts/category/{}.json", aCategory.id ) );
 
     try
     {
-        curl->Perform();
+        aCurl.Perform();
 
-        res = curl->GetBuffer();
+        res = aCurl.GetBuffer();
 
         nlohmann::json response = nlohmann::json::parse( res );
 
         for( nlohmann::json& item : response )
         {
-            //PART result;
             HTTP_LIB_PART part;
 
             setPartIdNameAndMetadata( item, part );
-
-            // add to cache
-            m_cache[part.name] = std::make_tuple( part.id, aCategory.id );
-
             aParts.emplace_back( std::move( part ) );
         }
     }
     catch( const std::exception& e )
     {
-        m_lastError += wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response: %s" ) + "\n",
-                                         e.what(), res );
+        aParts.clear();
 
-        wxLogTrace( traceHTTPLib, wxT( "Exception occurred while syncing parts: %s" ), m_lastError );
+        return wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response: %s" ) + "\n",
+                                 e.what(), res ).ToStdString();
+    }
+
+    return std::string();
+}
+
+
+bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts )
+{
+    std::map<std::string, std::vector<HTTP_LIB_PART>> parts;
 
+    if( !SelectAll( { aCategory }, parts ) )
         return false;
-    }
+
+    for( HTTP_LIB_PART& part : parts[aCategory.id] )
+        aParts.emplace_back( std::move( part ) );
 
     return true;
 }
 
 
+bool HTTP_LIB_CONNECTION::SelectAll( const std::vector<HTTP_LIB_CATEGORY>& aCategories,
+                                     std::map<std::string, std::vector<HTTP_LIB_PART>>& aParts )
+{
+    if( !IsValidEndpoint() )
+    {
+        wxLogTrace( traceHTTPLib, wxT( "SelectAll: without valid connection!" ) );
+        return false;
+    }
+
+    // A few connections are enough to hide the latency of the server; more would only load it.
+    static const size_t MAX_CONNECTIONS = 4;
+
+    // The state is shared with the worker tasks, which may outlive this call: the symbol
+    // libraries are themselves loaded from the thread pool, so we must never wait for a task
+    // which has not started yet.  Instead this thread fetches categories as well, and only
+    // waits for the categories already claimed by a running worker.
+    struct FETCH_STATE
+    {
+        HTTP_LIB_SOURCE                         source;
+        std::vector<HTTP_LIB_CATEGORY>          categories;
+        std::vector<std::vector<HTTP_LIB_PART>> parts;
+        std::vector<std::string>                errors;
+        std::atomic<size_t>                     next{ 0 };
+        size_t                                  done = 0;
+        std::mutex                              mutex;
+        std::condition_variable                 cv;
+    };
+
+    auto state = std::make_shared<FETCH_STATE>();
+    state->source = m_source;
+    state->categories = aCategories;
+    state->parts.resize( aCategories.size() );
+    state->errors.resize( aCategories.size() );
+
+    auto worker =
+            [state]()
+            {
+                std::unique_ptr<KICAD_CURL_EASY> curl;
+
+                // One handle per worker, reused for all its requests so the connection is
+                // kept alive between categories
+                for( size_t ii = state->next++; ii < state->categories.size(); ii = state->next++ )
+                {
+                    try
+                    {
+                        if( !curl )
+                            curl = createCurlEasyObject( state->source );
+
+                        state->errors[ii] = fetchCategoryParts( state->source, *curl,
+                                                                state->categories[ii],
+                                                                state->parts[ii] );
+                    }
+                    catch( const std::exception& e )
+                    {
+                        state->errors[ii] = e.what();
+                    }
+
+                    std::lock_guard<std::mutex> lock( state->mutex );
+
+                    if( ++state->done == state->categories.size() )
+                        state->cv.notify_all();
+                }
+            };
+
+    size_t connections = std::min( aCategories.size(), MAX_CONNECTIONS );
+
+    for( size_t ii = 1; ii < connections; ii++ )
+        GetKiCadThreadPool().detach_task( worker );
+
+    worker();
+
+    {
+        std::unique_lock<std::mutex> lock( state->mutex );
+        state->cv.wait( lock, [&]() { return state->done == state->categories.size(); } );
+    }
+
+    bool ok = true;
+
+    for( size_t ii = 0; ii < aCategories.size(); ii++ )
+    {
+        if( !state->errors[ii].empty() )
+        {
+            m_lastError += state->errors[ii];
+
+            wxLogTrace( traceHTTPLib, wxT( "Exception occurred while syncing parts: %s" ),
+                        state->errors[ii] );
+
+            ok = false;
+            continue;
+        }
+
+        for( const HTTP_LIB_PART& part : state->parts[ii] )
+            m_cache[part.name] = std::make_tuple( part.id, aCategories[ii].id );
+
+        aParts[aCategories[ii].id] = std::move( state->parts[ii] );
+    }
+
+    return ok;
+}
+
+
 bool HTTP_LIB_CONNECTION::checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl )
 {
     int statusCode = aCurl->GetResponseStatusCode();
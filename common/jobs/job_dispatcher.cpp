@@ -19,6 +19,7 @@
  */
 
 #include <cli/exit_codes.h>
+#include <core/trace_events.h>
 #include <jobs/job_dispatcher.h>
 #include <reporter.h>
 #include <wx/debug.h>
@@ -44,8 +45,9 @@ void JOB_DISPATCHER::Register( const std::string&             aJobTypeName,
 
 int JOB_DISPATCHER::RunJob( JOB* job, REPORTER* aReporter, PROGRESS_REPORTER* aProgressReporter )
 {
-    int       result = CLI::EXIT_CODES::ERR_UNKNOWN;
-    REPORTER* existingReporter = m_reporter;
+    TRACE_ZONE traceZone( "Job " + job->GetType(), "jobs" );
+    int        result = CLI::EXIT_CODES::ERR_UNKNOWN;
+    REPORTER*  existingReporter = m_reporter;
 
     if( aReporter )
         m_reporter = aReporter;
@@ -0,0 +1,40 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_PCB_AUTOPLACE_H
+#define JOB_PCB_AUTOPLACE_H
+
+#include <kicommon.h>
+#include "job.h"
+
+class KICOMMON_API JOB_PCB_AUTOPLACE : public JOB
+{
+public:
+    JOB_PCB_AUTOPLACE();
+
+    wxString m_filename;
+
+    /// Only place the footprints located outside the board outline.
+    bool     m_offboardOnly;
+
+    /// Number of simulated annealing passes, or -1 to use the advanced config value.
+    int      m_refinementPasses;
+};
+
+#endif
@@ -51,6 +51,7 @@
 #include <common.h>
 #include <confirm.h>
 #include <core/arraydim.h>
+#include <core/trace_events.h>
 #include <id.h>
 #include <kicad_curl/kicad_curl.h>
 #include <kiplatform/policy.h>
@@ -180,6 +181,9 @@ void PGM_BASE::Destroy()
 {
     KICAD_CURL::Cleanup();
 
+    if( !TRACE_EVENTS::Instance().Finish() )
+        wxLogError( _( "Failed to write trace events file." ) );
+
     APP_MONITOR::SENTRY::Instance()->Cleanup();
 
     m_pgm_checker.reset();
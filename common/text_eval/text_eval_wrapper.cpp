@@ -46,6 +46,7 @@ namespace KI_EVAL
 
 #include <wx/log.h>
 #include <algorithm>
+#include <mutex>
 #include <regex>
 #include <span>
 
@@ -1099,6 +1100,63 @@ public:
     [[nodiscard]] constexpr size_t get_column() const noexcept { return m_column; }
 };
 
+namespace
+{
+
+/**
+ * Parsed documents shared by all the evaluators of the process.
+ *
+ * The same field texts are evaluated over and over when redrawing, netlisting or exporting a
+ * BOM, so each unique expression string is only tokenized and parsed once.  A document doesn't
+ * depend on the variable values, which are only looked up when it is processed, so it can be
+ * reused by any evaluator with the same default units.  Only documents parsed without errors
+ * are kept, so that the errors of a bad expression are reported each time it is evaluated.
+ */
+class PARSED_DOC_CACHE
+{
+public:
+    std::shared_ptr<const calc_parser::DOC> Get( const std::string& aInput, EDA_UNITS aUnits )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_docs.find( makeKey( aInput, aUnits ) );
+        return it != m_docs.end() ? it->second : nullptr;
+    }
+
+    void Add( const std::string& aInput, EDA_UNITS aUnits,
+              std::shared_ptr<const calc_parser::DOC> aDoc )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        // Expressions generated on the fly (e.g. by a script) could grow the cache forever
+        if( m_docs.size() >= MAX_DOCS )
+            m_docs.clear();
+
+        m_docs.emplace( makeKey( aInput, aUnits ), std::move( aDoc ) );
+    }
+
+private:
+    static std::string makeKey( const std::string& aInput, EDA_UNITS aUnits )
+    {
+        return std::to_string( static_cast<int>( aUnits ) ) + '\x1F' + aInput;
+    }
+
+    static constexpr size_t MAX_DOCS = 8192;
+
+    std::mutex                                                               m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const calc_parser::DOC>> m_docs;
+};
+
+
+PARSED_DOC_CACHE& parsedDocCache()
+{
+    static PARSED_DOC_CACHE cache;
+    return cache;
+}
+
+} // namespace
+
+
 EXPRESSION_EVALUATOR::EXPRESSION_EVALUATOR( bool aClearVariablesOnEvaluate ) :
         m_clearVariablesOnEvaluate( aClearVariablesOnEvaluate ),
         m_useCustomCallback( false ),
@@ -1925,72 +1983,85 @@ std::pair<std::string, bool> EXPRESSION_EVALUATOR::evaluateWithFullParser( const
         // Set up error collector
         calc_parser::g_errorCollector = m_lastErrors.get();
 
-        // Create tokenizer with default units
-        KIEVAL_TEXT_TOKENIZER tokenizer{ aInput, m_lastErrors.get(), m_defaultUnits };
+        std::shared_ptr<const calc_parser::DOC> document = parsedDocCache().Get( aInput, m_defaultUnits );
 
-        // Create parser deleter function
-        auto parser_deleter = []( void* p )
+        if( !document )
         {
-            KI_EVAL::ParseFree( p, free );
-        };
+            // Create tokenizer with default units
+            KIEVAL_TEXT_TOKENIZER tokenizer{ aInput, m_lastErrors.get(), m_defaultUnits };
 
-        // Allocate parser with RAII cleanup
-        std::unique_ptr<void, decltype( parser_deleter )> parser{ KI_EVAL::ParseAlloc( malloc ), parser_deleter };
+            // Create parser deleter function
+            auto parser_deleter = []( void* p )
+            {
+                KI_EVAL::ParseFree( p, free );
+            };
 
-        if( !parser )
-        {
-            if( m_lastErrors )
+            // Allocate parser with RAII cleanup
+            std::unique_ptr<void, decltype( parser_deleter )> parser{ KI_EVAL::ParseAlloc( malloc ),
+                                                                      parser_deleter };
+
+            if( !parser )
             {
-                m_lastErrors->AddError( "Failed to allocate parser" );
+                if( m_lastErrors )
+                {
+                    m_lastErrors->AddError( "Failed to allocate parser" );
+                }
+                return { aInput, true };
             }
-            return { aInput, true };
-        }
 
-        // Parse document
-        calc_parser::DOC* document = nullptr;
+            // Parse document
+            calc_parser::DOC* parsedDocument = nullptr;
 
-        calc_parser::TOKEN_TYPE token_value;
-        TextEvalToken           token_type;
+            calc_parser::TOKEN_TYPE token_value;
+            TextEvalToken           token_type;
 
-        do
-        {
-            token_type = tokenizer.get_next_token( token_value );
+            do
+            {
+                token_type = tokenizer.get_next_token( token_value );
 
-            // Send token to parser
-            KI_EVAL::Parse( parser.get(), static_cast<int>( token_type ), token_value, &document );
+                // Send token to parser
+                KI_EVAL::Parse( parser.get(), static_cast<int>( token_type ), token_value, &parsedDocument );
 
-            // Early exit on errors
-            if( m_lastErrors && m_lastErrors->HasErrors() )
-            {
-                break;
-            }
+                // Early exit on errors
+                if( m_lastErrors && m_lastErrors->HasErrors() )
+                {
+                    break;
+                }
 
-        } while( token_type != TextEvalToken::ENDS && tokenizer.has_more_tokens() );
+            } while( token_type != TextEvalToken::ENDS && tokenizer.has_more_tokens() );
 
-        // Finalize parsing
-        KI_EVAL::Parse( parser.get(), static_cast<int>( TextEvalToken::ENDS ), calc_parser::TOKEN_TYPE{}, &document );
+            // Finalize parsing
+            KI_EVAL::Parse( parser.get(), static_cast<int>( TextEvalToken::ENDS ), calc_parser::TOKEN_TYPE{},
+                            &parsedDocument );
 
-        // Process document if parsing succeeded
-        if( document && ( !m_lastErrors || !m_lastErrors->HasErrors() ) )
-        {
-            calc_parser::DOC_PROCESSOR processor;
-            auto [result, had_errors] = processor.Process( *document, std::move( aVariableCallback ) );
+            // Take ownership of the document, even if parsing failed
+            std::unique_ptr<calc_parser::DOC> owner( parsedDocument );
 
-            // If processing had any evaluation errors, return original input unchanged
-            // This preserves the original expression syntax while still reporting errors
-            if( had_errors )
+            // Return original on error
+            if( !owner || ( m_lastErrors && m_lastErrors->HasErrors() ) )
             {
-                delete document;
                 return { aInput, true };
             }
 
-            delete document;
-            return { std::move( result ), had_errors };
+            document = std::move( owner );
+
+            // Warnings must be reported again on the next evaluation
+            if( !m_lastErrors || !m_lastErrors->HasWarnings() )
+                parsedDocCache().Add( aInput, m_defaultUnits, document );
         }
 
-        // Cleanup and return original on error
-        delete document;
-        return { aInput, true };
+        // Process document
+        calc_parser::DOC_PROCESSOR processor;
+        auto [result, had_errors] = processor.Process( *document, std::move( aVariableCallback ) );
+
+        // If processing had any evaluation errors, return original input unchanged
+        // This preserves the original expression syntax while still reporting errors
+        if( had_errors )
+        {
+            return { aInput, true };
+        }
+
+        return { std::move( result ), had_errors };
     }
     catch( const std::bad_alloc& )
     {
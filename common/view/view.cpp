@@ -41,6 +41,7 @@
 #include <algorithm>
 
 #include <core/profile.h>
+#include <core/trace_events.h>
 
 #ifdef KICAD_GAL_PROFILE
 #include <wx/log.h>
@@ -1176,6 +1177,8 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    TRACE_ZONE traceZone( "Redraw view", "view" );
+
 #ifdef KICAD_GAL_PROFILE
     PROF_TIMER totalRealTime;
 #endif /* KICAD_GAL_PROFILE */
@@ -106,6 +106,8 @@ const BOX2I VIEW_GROUP::ViewBBox() const
 
         for( VIEW_ITEM* item : m_groupItems )
             bb.Merge( item->ViewBBox() );
+
+        bb.Move( m_drawOffset );
     }
 
     return bb;
@@ -152,6 +154,14 @@ void VIEW_GROUP::ViewDraw( int aLayer, VIEW* aView ) const
 
     GAL_SCOPED_ATTRS scopedAttrs( *gal, GAL_SCOPED_ATTRS::LAYER_DEPTH );
 
+    bool offset = m_drawOffset != VECTOR2I( 0, 0 );
+
+    if( offset )
+    {
+        gal->Save();
+        gal->Translate( m_drawOffset );
+    }
+
     for( int layer : layers )
     {
         bool draw = aView->IsLayerVisible( layer );
@@ -209,6 +219,9 @@ void VIEW_GROUP::ViewDraw( int aLayer, VIEW* aView ) const
             }
         }
     }
+
+    if( offset )
+        gal->Restore();
 }
 
 
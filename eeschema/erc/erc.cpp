@@ -1774,77 +1774,79 @@ int ERC_TESTER::TestOffGridEndpoints()
     const int gridSize = m_schematic->Settings().m_ConnectionGridSize;
     int       err_count = 0;
 
-    for( SCH_SCREEN* screen = m_screens.GetFirst(); screen; screen = m_screens.GetNext() )
-    {
-        std::vector<SCH_MARKER*> markers;
+    std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> markers;
 
-        for( SCH_ITEM* item : screen->Items() )
-        {
-            if( item->Type() == SCH_LINE_T && item->IsConnectable() )
+    m_screens.ForEachItemOfType( { SCH_LINE_T, SCH_BUS_WIRE_ENTRY_T, SCH_SYMBOL_T },
+            [&]( SCH_SCREEN* aScreen, SCH_ITEM* aItem )
             {
-                SCH_LINE* line = static_cast<SCH_LINE*>( item );
-
-                if( ( line->GetStartPoint().x % gridSize ) != 0
-                        || ( line->GetStartPoint().y % gridSize ) != 0 )
+                if( aItem->Type() == SCH_LINE_T && aItem->IsConnectable() )
                 {
-                    std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
-                    ercItem->SetItems( line );
+                    SCH_LINE* line = static_cast<SCH_LINE*>( aItem );
 
-                    markers.emplace_back( new SCH_MARKER( std::move( ercItem ), line->GetStartPoint() ) );
-                }
-                else if( ( line->GetEndPoint().x % gridSize ) != 0
-                            || ( line->GetEndPoint().y % gridSize ) != 0 )
-                {
-                    std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
-                    ercItem->SetItems( line );
-
-                    markers.emplace_back( new SCH_MARKER( std::move( ercItem ), line->GetEndPoint() ) );
-                }
-            }
-            if( item->Type() == SCH_BUS_WIRE_ENTRY_T )
-            {
-                SCH_BUS_WIRE_ENTRY* entry = static_cast<SCH_BUS_WIRE_ENTRY*>( item );
+                    if( ( line->GetStartPoint().x % gridSize ) != 0
+                            || ( line->GetStartPoint().y % gridSize ) != 0 )
+                    {
+                        std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
+                        ercItem->SetItems( line );
 
-                for( const VECTOR2I& point : entry->GetConnectionPoints() )
-                {
-                    if( ( point.x % gridSize ) != 0
-                        || ( point.y % gridSize ) != 0 )
+                        markers.emplace_back( aScreen, new SCH_MARKER( std::move( ercItem ),
+                                                                       line->GetStartPoint() ) );
+                    }
+                    else if( ( line->GetEndPoint().x % gridSize ) != 0
+                                || ( line->GetEndPoint().y % gridSize ) != 0 )
                     {
                         std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
-                        ercItem->SetItems( entry );
+                        ercItem->SetItems( line );
 
-                        markers.emplace_back( new SCH_MARKER( std::move( ercItem ), point ) );
+                        markers.emplace_back( aScreen, new SCH_MARKER( std::move( ercItem ),
+                                                                       line->GetEndPoint() ) );
                     }
                 }
-            }
-            else if( item->Type() == SCH_SYMBOL_T )
-            {
-                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
-
-                for( SCH_PIN* pin : symbol->GetPins( nullptr ) )
+                else if( aItem->Type() == SCH_BUS_WIRE_ENTRY_T )
                 {
-                    if( pin->GetType() == ELECTRICAL_PINTYPE::PT_NC )
-                        continue;
+                    SCH_BUS_WIRE_ENTRY* entry = static_cast<SCH_BUS_WIRE_ENTRY*>( aItem );
+
+                    for( const VECTOR2I& point : entry->GetConnectionPoints() )
+                    {
+                        if( ( point.x % gridSize ) != 0
+                            || ( point.y % gridSize ) != 0 )
+                        {
+                            std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
+                            ercItem->SetItems( entry );
 
-                    VECTOR2I pinPos = pin->GetPosition();
+                            markers.emplace_back( aScreen, new SCH_MARKER( std::move( ercItem ), point ) );
+                        }
+                    }
+                }
+                else if( aItem->Type() == SCH_SYMBOL_T )
+                {
+                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( aItem );
 
-                    if( ( pinPos.x % gridSize ) != 0 || ( pinPos.y % gridSize ) != 0 )
+                    for( SCH_PIN* pin : symbol->GetPins( nullptr ) )
                     {
-                        std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
-                        ercItem->SetItems( pin );
+                        if( pin->GetType() == ELECTRICAL_PINTYPE::PT_NC )
+                            continue;
 
-                        markers.emplace_back( new SCH_MARKER( std::move( ercItem ), pinPos ) );
-                        break;
+                        VECTOR2I pinPos = pin->GetPosition();
+
+                        if( ( pinPos.x % gridSize ) != 0 || ( pinPos.y % gridSize ) != 0 )
+                        {
+                            std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
+                            ercItem->SetItems( pin );
+
+                            markers.emplace_back( aScreen, new SCH_MARKER( std::move( ercItem ), pinPos ) );
+                            break;
+                        }
                     }
                 }
-            }
-        }
+            } );
 
-        for( SCH_MARKER* marker : markers )
-        {
-            screen->Append( marker );
-            err_count += 1;
-        }
+    // Markers are added to the screens afterwards so the R-trees aren't modified while they
+    // are iterated.
+    for( const auto& [screen, marker] : markers )
+    {
+        screen->Append( marker );
+        err_count += 1;
     }
 
     return err_count;
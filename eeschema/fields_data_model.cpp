@@ -17,6 +17,9 @@
  * You should have received a copy of the GNU General Public License along
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <limits>
+#include <unordered_map>
+
 #include <wx/string.h>
 #include <wx/debug.h>
 #include <wx/grid.h>
@@ -207,6 +210,10 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::AddColumn( const wxString& aFieldName, const
 
     m_cols.push_back( { aFieldName, aLabel, aAddedByUser, false, false } );
 
+    // User-added fields are created on every symbol by ApplyData()
+    if( aAddedByUser )
+        m_allDirty = true;
+
     for( unsigned i = 0; i < m_symbolsList.GetCount(); ++i )
         updateDataStoreSymbolField( m_symbolsList[i], aFieldName, aVariantName );
 }
@@ -265,6 +272,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RemoveColumn( int aCol )
     }
 
     m_cols.erase( m_cols.begin() + aCol );
+    m_allDirty = true;
 
     if( wxGrid* grid = GetView() )
     {
@@ -291,6 +299,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RenameColumn( int aCol, const wxString& newN
 
     m_cols[aCol].m_fieldName = newName;
     m_cols[aCol].m_label = newName;
+    m_allDirty = true;
 }
 
 
@@ -586,6 +595,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::SetValue( int aRow, int aCol, const wxString
 
         KIID_PATH key = makeDataStoreKey( ref.GetSheetPath(), *ref.GetSymbol() );
         m_dataStore[key][m_cols[aCol].m_fieldName] = aValue;
+        m_dirtyKeys.insert( key );
     }
 
     // Update all of the other instances for the shared symbol as required.
@@ -604,6 +614,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::SetValue( int aRow, int aCol, const wxString
 
                 KIID_PATH key = makeDataStoreKey( ref.GetSheetPath(), *ref.GetSymbol() );
                 m_dataStore[key][m_cols[aCol].m_fieldName] = aValue;
+                m_dirtyKeys.insert( key );
             }
         }
     }
@@ -734,33 +745,37 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::unitMatch( const SCH_REFERENCE& lhRef, const
 }
 
 
-bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef )
+wxString FIELDS_EDITOR_GRID_DATA_MODEL::groupKey( const SCH_REFERENCE& aRef, int aRefCol )
 {
-    int  refCol = GetFieldNameCol( GetCanonicalFieldName( FIELD_T::REFERENCE ) );
-    bool matchFound = false;
+    // Two references group together when their keys are equal.  Each value is prefixed with its
+    // length so that no two different sets of values can produce the same key.
+    wxString key;
+    bool     hasGroupedCol = false;
 
-    if( refCol == -1 )
-        return false;
+    auto appendValue =
+            [&]( const wxString& aValue )
+            {
+                key << aValue.length() << ':' << aValue;
+                hasGroupedCol = true;
+            };
+
+    if( aRefCol == -1 )
+        return wxEmptyString;
 
     // First check the reference column.  This can be done directly out of the
     // SCH_REFERENCEs as the references can't be edited in the grid.
-    if( m_cols[refCol].m_group )
-    {
-        // if we're grouping by reference, then only the prefix must match
-        if( lhRef.GetRef() != rhRef.GetRef() )
-            return false;
-
-        matchFound = true;
-    }
+    // If we're grouping by reference, then only the prefix must match.
+    if( m_cols[aRefCol].m_group )
+        appendValue( aRef.GetRef() );
 
-    KIID_PATH lhRefKey = makeDataStoreKey( lhRef.GetSheetPath(), *lhRef.GetSymbol() );
-    KIID_PATH rhRefKey = makeDataStoreKey( rhRef.GetSheetPath(), *rhRef.GetSymbol() );
+    KIID_PATH refKey = makeDataStoreKey( aRef.GetSheetPath(), *aRef.GetSymbol() );
+    std::map<wxString, wxString>& fieldStore = m_dataStore[refKey];
 
-    // Now check all the other columns.
+    // Now add all the other columns.
     for( size_t i = 0; i < m_cols.size(); ++i )
     {
         //Handled already
-        if( static_cast<int>( i ) == refCol )
+        if( static_cast<int>( i ) == aRefCol )
             continue;
 
         if( !m_cols[i].m_group )
@@ -769,35 +784,15 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef, cons
         // If the field is generated (e.g. ${QUANTITY}), we need to resolve it through the symbol
         // to get the actual current value; otherwise we need to pull it out of the store so the
         // refresh can regroup based on values that haven't been applied to the schematic yet.
-        wxString lh, rh;
+        const wxString& storedValue = fieldStore[m_cols[i].m_fieldName];
 
-        if( IsGeneratedField( m_cols[i].m_fieldName )
-            || IsGeneratedField( m_dataStore[lhRefKey][m_cols[i].m_fieldName] ) )
-        {
-            lh = getFieldShownText( lhRef, m_cols[i].m_fieldName );
-        }
+        if( IsGeneratedField( m_cols[i].m_fieldName ) || IsGeneratedField( storedValue ) )
+            appendValue( getFieldShownText( aRef, m_cols[i].m_fieldName ) );
         else
-        {
-            lh = m_dataStore[lhRefKey][m_cols[i].m_fieldName];
-        }
-
-        if( IsGeneratedField( m_cols[i].m_fieldName )
-            || IsGeneratedField( m_dataStore[rhRefKey][m_cols[i].m_fieldName] ) )
-        {
-            rh = getFieldShownText( rhRef, m_cols[i].m_fieldName );
-        }
-        else
-        {
-            rh = m_dataStore[rhRefKey][m_cols[i].m_fieldName];
-        }
-
-        if( lh != rh )
-            return false;
-
-        matchFound = true;
+            appendValue( storedValue );
     }
 
-    return matchFound;
+    return hasGroupedCol ? key : wxString();
 }
 
 
@@ -957,6 +952,11 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
     m_rows.clear();
 
     EDA_COMBINED_MATCHER matcher( m_filter.Lower(), CTX_SEARCH );
+    int                  refCol = GetFieldNameCol( GetCanonicalFieldName( FIELD_T::REFERENCE ) );
+
+    // First row of each unit (reference designator) and of each group of matching values
+    std::unordered_map<wxString, size_t> unitRows;
+    std::unordered_map<wxString, size_t> groupRows;
 
     for( unsigned i = 0; i < m_symbolsList.GetCount(); ++i )
     {
@@ -1026,38 +1026,64 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
             continue;
         }
 
-        bool matchFound = false;
-
-        // Performance optimization for ungrouped case to skip the N^2 for loop
+        // Performance optimization for ungrouped case: single unit symbols get their own row
         if( !m_groupingEnabled && !ref.IsMultiUnit() )
         {
+            if( ref.GetRefNumber() != wxT( "?" ) )
+                unitRows.emplace( ref.GetRef() + wxT( "\x1F" ) + ref.GetRefNumber(), m_rows.size() );
+
             m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
             continue;
         }
 
-        // See if we already have a row which this symbol fits into
-        for( DATA_MODEL_ROW& row : m_rows )
+        // Units of the same symbol always share a row; when grouping is enabled, so do symbols
+        // with identical values in all the grouped columns.  Rows are looked up by the first
+        // reference they were created with, so the result is the same as comparing against
+        // every existing row in order.
+        wxString unit;
+        wxString group;
+        size_t   unitRow = std::numeric_limits<size_t>::max();
+        size_t   groupRow = std::numeric_limits<size_t>::max();
+
+        // If items are unannotated then we can't tell if they're units of the same symbol or not
+        if( ref.GetRefNumber() != wxT( "?" ) )
         {
-            // all group members must have identical refs so just use the first one
-            SCH_REFERENCE rowRef = row.m_Refs[0];
+            unit = ref.GetRef() + wxT( "\x1F" ) + ref.GetRefNumber();
 
-            if( unitMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                break;
-            }
-            else if( m_groupingEnabled && groupMatch( ref, rowRef ) )
+            if( auto it = unitRows.find( unit ); it != unitRows.end() )
+                unitRow = it->second;
+        }
+
+        if( m_groupingEnabled )
+        {
+            group = groupKey( ref, refCol );
+
+            if( !group.IsEmpty() )
             {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                row.m_Flag = GROUP_COLLAPSED;
-                break;
+                if( auto it = groupRows.find( group ); it != groupRows.end() )
+                    groupRow = it->second;
             }
         }
 
-        if( !matchFound )
+        if( unitRow <= groupRow && unitRow < m_rows.size() )
+        {
+            m_rows[unitRow].m_Refs.push_back( ref );
+        }
+        else if( groupRow < m_rows.size() )
+        {
+            m_rows[groupRow].m_Refs.push_back( ref );
+            m_rows[groupRow].m_Flag = GROUP_COLLAPSED;
+        }
+        else
+        {
+            if( !unit.IsEmpty() )
+                unitRows.emplace( unit, m_rows.size() );
+
+            if( !group.IsEmpty() )
+                groupRows.emplace( group, m_rows.size() );
+
             m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
+        }
     }
 
     if( GetView() )
@@ -1169,6 +1195,21 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::ExpandAfterSort()
 void FIELDS_EDITOR_GRID_DATA_MODEL::ApplyData( SCH_COMMIT& aCommit, TEMPLATES& aTemplateFieldnames,
                                                const wxString& aVariantName )
 {
+    // Only symbols with at least one edited instance are written back.  All the instances of
+    // such a symbol are applied, as they all share the same SCH_SYMBOL.
+    std::set<const SCH_SYMBOL*> dirtySymbols;
+
+    for( size_t i = 0; i < m_symbolsList.GetCount(); i++ )
+    {
+        const SCH_SYMBOL* symbol = m_symbolsList[i].GetSymbol();
+
+        if( m_allDirty
+            || m_dirtyKeys.contains( makeDataStoreKey( m_symbolsList[i].GetSheetPath(), *symbol ) ) )
+        {
+            dirtySymbols.insert( symbol );
+        }
+    }
+
     bool symbolModified = false;
     std::unique_ptr<SCH_SYMBOL> symbolCopy;
 
@@ -1177,10 +1218,13 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::ApplyData( SCH_COMMIT& aCommit, TEMPLATES& a
         SCH_SYMBOL* symbol = m_symbolsList[i].GetSymbol();
         SCH_SYMBOL* nextSymbol = nullptr;
 
+        if( !dirtySymbols.contains( symbol ) )
+            continue;
+
         if( ( i + 1 ) < m_symbolsList.GetCount() )
             nextSymbol = m_symbolsList[i + 1].GetSymbol();
 
-        if( i == 0 )
+        if( !symbolCopy )
             symbolCopy = std::make_unique<SCH_SYMBOL>( *symbol );
 
         KIID_PATH key = makeDataStoreKey( m_symbolsList[i].GetSheetPath(), *symbol );
@@ -1261,19 +1305,17 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::ApplyData( SCH_COMMIT& aCommit, TEMPLATES& a
         if( symbolModified && ( symbol != nextSymbol ) )
             aCommit.Modified( symbol, symbolCopy.release(), m_symbolsList[i].GetSheetPath().LastScreen() );
 
-        // Only reset the modified flag and next symbol copy if the next symbol is different from the current one.
+        // Only reset the modified flag and symbol copy if the next symbol is different from the current one.
         if( symbol != nextSymbol )
         {
-            if( nextSymbol )
-                symbolCopy = std::make_unique<SCH_SYMBOL>( *nextSymbol );
-            else
-                symbolCopy.reset( nullptr );
-
+            symbolCopy.reset( nullptr );
             symbolModified = false;
         }
     }
 
     m_edited = false;
+    m_dirtyKeys.clear();
+    m_allDirty = false;
 }
 
 
@@ -1594,6 +1636,7 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::DeleteRows( size_t aPosition, size_t aNumRow
     {
         m_rows.clear();
         m_dataStore.clear();
+        m_allDirty = true;
     }
     else
     {
@@ -1603,6 +1646,8 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::DeleteRows( size_t aPosition, size_t aNumRow
 
         for( const SCH_REFERENCE& ref : dataMapRefs )
             m_dataStore.erase( ref.GetSheetPath().Path() );
+
+        m_allDirty = true;
     }
 
     if( GetView() )
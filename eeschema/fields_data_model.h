@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <set>
+
 #include <sch_reference_list.h>
 #include <wx/grid.h>
 #include <widgets/wx_grid.h>
@@ -132,6 +134,7 @@ public:
     FIELDS_EDITOR_GRID_DATA_MODEL( const SCH_REFERENCE_LIST& aSymbolsList, wxGridCellAttr* aURLEditor ) :
             m_symbolsList( aSymbolsList ),
             m_edited( false ),
+            m_allDirty( false ),
             m_sortColumn( 0 ),
             m_sortAscending( false ),
             m_scope( SCOPE_ALL ),
@@ -351,7 +354,14 @@ private:
                      FIELDS_EDITOR_GRID_DATA_MODEL* dataModel, int sortCol, bool ascending );
 
     bool unitMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
-    bool groupMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
+
+    /**
+     * Build the key used to group symbols: two references belong to the same group when their
+     * keys are equal.
+     *
+     * @return an empty string if no column is grouped, in which case nothing can be grouped.
+     */
+    wxString groupKey( const SCH_REFERENCE& aRef, int aRefCol );
 
     // Helper functions to deal with translating wxGrid values to and from
     // named field values like ${DNP}
@@ -403,6 +413,8 @@ protected:
      */
     SCH_REFERENCE_LIST m_symbolsList;
     bool               m_edited;
+    std::set<KIID_PATH> m_dirtyKeys;   ///< Data store entries edited since the last ApplyData()
+    bool               m_allDirty;     ///< A column change affects every symbol
     int                m_sortColumn;
     bool               m_sortAscending;
     wxString           m_filter;
@@ -19,7 +19,12 @@
  */
 
 #include "pin_layout_cache.h"
+
+#include <mutex>
+#include <unordered_map>
+
 #include <geometry/direction45.h>
+#include <hash.h>
 #include <pgm_base.h>
 #include <settings/settings_manager.h>
 #include <sch_symbol.h>
@@ -94,35 +99,7 @@ std::optional<PIN_LAYOUT_CACHE::TEXT_INFO> PIN_LAYOUT_CACHE::GetPinNumberInfo( i
         return VECTOR2I( w, h );
     };
 
-    // Pass 1: determine maximum perpendicular half span among all pin numbers to ensure
-    // a single distance from the pin center that avoids overlap for every pin.
     const SYMBOL* parentSym = m_pin.GetParentSymbol();
-    int           maxHalfHeight = 0; // vertical half span across all numbers (for horizontal pins)
-    int           maxHalfWidth = 0;  // horizontal half span across all numbers (for vertical pins when rotated)
-    int           maxFullHeight = 0; // full height (for dynamic clearance)
-
-    if( parentSym )
-    {
-        for( const SCH_PIN* p : parentSym->GetPins() )
-        {
-            wxString raw = p->GetShownNumber();
-
-            if( raw.IsEmpty() )
-                continue;
-
-            wxString fmt = FormatStackedPinForDisplay( raw, p->GetLength(), p->GetNumberTextSize(), font,
-                                                       p->GetFontMetrics() );
-            // For horizontal pins: compute vertical extent (height when text is horizontal)
-            VECTOR2I boxHoriz = estimateQABox( fmt, p->GetNumberTextSize(), false );
-            maxHalfHeight = std::max( maxHalfHeight, boxHoriz.y / 2 );
-            maxFullHeight = std::max( maxFullHeight, boxHoriz.y );
-
-            // For vertical pins: compute horizontal extent when text is rotated vertical
-            // When text is vertical, the perpendicular span is the original height
-            VECTOR2I boxVert = estimateQABox( fmt, p->GetNumberTextSize(), true );
-            maxHalfWidth = std::max( maxHalfWidth, boxVert.x / 2 );
-        }
-    }
 
     int       clearance = getPinTextOffset() + schIUScale.MilsToIU( PIN_TEXT_MARGIN );
     VECTOR2I  pinPos = m_pin.GetPosition();
@@ -282,20 +259,12 @@ void PIN_LAYOUT_CACHE::SetRenderParameters( int aNameThickness, int aNumberThick
 }
 
 
-void PIN_LAYOUT_CACHE::recomputeExtentsCache( bool aDefinitelyDirty, KIFONT::FONT* aFont, int aSize,
-                                              const wxString&        aText,
-                                              const KIFONT::METRICS& aFontMetrics,
-                                              TEXT_EXTENTS_CACHE&    aCache )
+namespace
 {
-    // Even if not definitely dirty, verify no font changes
-    if( !aDefinitelyDirty && aCache.m_Font == aFont && aCache.m_FontSize == aSize )
-    {
-        return;
-    }
-
-    aCache.m_Font = aFont;
-    aCache.m_FontSize = aSize;
 
+VECTOR2I computeTextExtents( KIFONT::FONT* aFont, int aSize, const wxString& aText,
+                             const KIFONT::METRICS& aFontMetrics )
+{
     VECTOR2D fontSize( aSize, aSize );
     int      penWidth = GetPenSizeForNormal( aSize );
 
@@ -329,13 +298,105 @@ void PIN_LAYOUT_CACHE::recomputeExtentsCache( bool aDefinitelyDirty, KIFONT::FON
             maxWidth += braceWidth * 2;  // Space for braces on both sides
             totalHeight += aSize / 3;    // Extra height for brace extensions
 
-            aCache.m_Extents = VECTOR2I( maxWidth, totalHeight );
-            return;
+            return VECTOR2I( maxWidth, totalHeight );
         }
     }
 
     // Single line text (normal case)
-    aCache.m_Extents = aFont->StringBoundaryLimits( aText, fontSize, penWidth, false, false, aFontMetrics );
+    return aFont->StringBoundaryLimits( aText, fontSize, penWidth, false, false, aFontMetrics );
+}
+
+
+/**
+ * Text extents shared by all the pins.
+ *
+ * Every instance of a symbol has its own copy of the library symbol, and the painter draws
+ * each instance from yet another temporary copy, so the same pin names and numbers would
+ * otherwise be measured again for every instance on every redraw.
+ */
+class SHARED_TEXT_EXTENTS
+{
+public:
+    VECTOR2I Get( KIFONT::FONT* aFont, int aSize, const wxString& aText,
+                  const KIFONT::METRICS& aFontMetrics )
+    {
+        KEY key{ aFont, aSize, aFontMetrics.m_InterlinePitch, aFontMetrics.m_OverbarHeight,
+                 aFontMetrics.m_UnderlineOffset, aText };
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            auto it = m_extents.find( key );
+
+            if( it != m_extents.end() )
+                return it->second;
+        }
+
+        VECTOR2I extents = computeTextExtents( aFont, aSize, aText, aFontMetrics );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        // Pin names can be generated (e.g. from text variables), don't let them grow forever
+        if( m_extents.size() >= MAX_EXTENTS )
+            m_extents.clear();
+
+        m_extents.emplace( std::move( key ), extents );
+
+        return extents;
+    }
+
+private:
+    struct KEY
+    {
+        KIFONT::FONT* m_Font;
+        int           m_Size;
+        double        m_InterlinePitch;
+        double        m_OverbarHeight;
+        double        m_UnderlineOffset;
+        wxString      m_Text;
+
+        bool operator==( const KEY& aOther ) const = default;
+    };
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            return hash_val( aKey.m_Font, aKey.m_Size, aKey.m_InterlinePitch,
+                             aKey.m_OverbarHeight, aKey.m_UnderlineOffset, aKey.m_Text );
+        }
+    };
+
+    static constexpr size_t MAX_EXTENTS = 16384;
+
+    std::mutex                                   m_mutex;
+    std::unordered_map<KEY, VECTOR2I, KEY_HASH> m_extents;
+};
+
+
+SHARED_TEXT_EXTENTS& sharedTextExtents()
+{
+    static SHARED_TEXT_EXTENTS extents;
+    return extents;
+}
+
+} // namespace
+
+
+void PIN_LAYOUT_CACHE::recomputeExtentsCache( bool aDefinitelyDirty, KIFONT::FONT* aFont, int aSize,
+                                              const wxString&        aText,
+                                              const KIFONT::METRICS& aFontMetrics,
+                                              TEXT_EXTENTS_CACHE&    aCache )
+{
+    // Even if not definitely dirty, verify no font changes
+    if( !aDefinitelyDirty && aCache.m_Font == aFont && aCache.m_FontSize == aSize )
+    {
+        return;
+    }
+
+    aCache.m_Font = aFont;
+    aCache.m_FontSize = aSize;
+    aCache.m_Extents = sharedTextExtents().Get( aFont, aSize, aText, aFontMetrics );
 }
 
 
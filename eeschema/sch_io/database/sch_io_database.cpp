@@ -103,6 +103,11 @@ LIB_SYMBOL* SCH_IO_DATABASE::LoadSymbol( const wxString&   aLibraryPath,
 
     cacheLib();
 
+    // cacheLib() has already built the symbols of every table, so placing or updating the
+    // symbols of a schematic doesn't need a query per symbol
+    if( auto it = m_nameToSymbolcache.find( aAliasName ); it != m_nameToSymbolcache.end() )
+        return it->second->Duplicate();
+
     /*
      * Table names are tricky, in order to allow maximum flexibility to the user.
      * The slash character is used as a separator between a table name and symbol name, but symbol
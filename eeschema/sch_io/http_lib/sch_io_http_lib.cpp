@@ -60,7 +60,10 @@ void SCH_IO_HTTP_LIB::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 
     bool powerSymbolsOnly = ( aProperties && aProperties->contains( SYMBOL_LIBRARY_ADAPTER::PropPowerSymsOnly ) );
 
-    for( const HTTP_LIB_CATEGORY& category : m_conn->getCategories() )
+    std::vector<HTTP_LIB_CATEGORY> categories = m_conn->getCategories();
+    std::vector<HTTP_LIB_CATEGORY> staleCategories;
+
+    for( const HTTP_LIB_CATEGORY& category : categories )
     {
         bool refresh_cache = true;
 
@@ -76,10 +79,15 @@ void SCH_IO_HTTP_LIB::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
         }
 
         if( refresh_cache )
-        {
-            syncCache( category );
-        }
+            staleCategories.push_back( category );
+    }
+
+    // Fetch all the outdated categories at once so that they are requested concurrently
+    if( !staleCategories.empty() )
+        syncCache( staleCategories );
 
+    for( const HTTP_LIB_CATEGORY& category : categories )
+    {
         for( const HTTP_LIB_PART& part : m_cachedCategories[category.id].cachedParts )
         {
             wxString libIDString( part.name );
@@ -309,33 +317,35 @@ void SCH_IO_HTTP_LIB::connect()
 
 void SCH_IO_HTTP_LIB::syncCache()
 {
-    for( const HTTP_LIB_CATEGORY& category : m_conn->getCategories() )
-        syncCache( category );
+    syncCache( m_conn->getCategories() );
 }
 
 
-void SCH_IO_HTTP_LIB::syncCache( const HTTP_LIB_CATEGORY& category )
+void SCH_IO_HTTP_LIB::syncCache( const std::vector<HTTP_LIB_CATEGORY>& aCategories )
 {
-    std::vector<HTTP_LIB_PART> found_parts;
+    std::map<std::string, std::vector<HTTP_LIB_PART>> found_parts;
+
+    bool ok = m_conn->SelectAll( aCategories, found_parts );
 
-    if( !m_conn->SelectAll( category, found_parts ) )
+    // Copy newly cached data across, even if some other categories failed
+    for( auto& [categoryId, parts] : found_parts )
     {
-        if( !m_conn->GetLastError().empty() )
+        m_cachedCategories[categoryId].cachedParts = std::move( parts );
+        m_cachedCategories[categoryId].lastCached = std::time( nullptr );
+    }
+
+    if( !ok && !m_conn->GetLastError().empty() )
+    {
+        for( const HTTP_LIB_CATEGORY& category : aCategories )
         {
-            THROW_IO_ERROR( wxString::Format( _( "Error retrieving data from HTTP library %s: %s" ),
-                                              category.name,
-                                              m_conn->GetLastError() ) );
+            if( !found_parts.contains( category.id ) )
+            {
+                THROW_IO_ERROR( wxString::Format( _( "Error retrieving data from HTTP library %s: %s" ),
+                                                  category.name,
+                                                  m_conn->GetLastError() ) );
+            }
         }
-
-        return;
     }
-
-    // remove cached parts
-    m_cachedCategories[category.id].cachedParts.clear();
-
-    // Copy newly cached data across
-    m_cachedCategories[category.id].cachedParts = found_parts;
-    m_cachedCategories[category.id].lastCached = std::time( nullptr );
 }
 
 
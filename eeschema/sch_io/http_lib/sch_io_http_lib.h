@@ -91,7 +91,7 @@ private:
 
     void syncCache();
 
-    void syncCache( const HTTP_LIB_CATEGORY& category );
+    void syncCache( const std::vector<HTTP_LIB_CATEGORY>& aCategories );
 
     LIB_SYMBOL* loadSymbolFromPart( const wxString& aSymbolName, const HTTP_LIB_CATEGORY& aCategory,
                                     const HTTP_LIB_PART& aPart );
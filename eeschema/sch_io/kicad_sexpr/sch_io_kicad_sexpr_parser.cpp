@@ -2722,6 +2722,16 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
                 }
             };
 
+    // The items are added to the screen all at once after parsing, which is much faster than
+    // inserting them one at a time in the screen R-tree.
+    std::vector<std::unique_ptr<SCH_ITEM>> items;
+
+    auto appendItem =
+            [&]( SCH_ITEM* aItem )
+            {
+                items.emplace_back( aItem );
+            };
+
     T token;
 
     if( !aIsCopyableOnly )
@@ -2877,11 +2887,11 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
         }
 
         case T_symbol:
-            screen->Append( static_cast<SCH_ITEM*>( parseSchematicSymbol() ) );
+            appendItem( parseSchematicSymbol() );
             break;
 
         case T_image:
-            screen->Append( static_cast<SCH_ITEM*>( parseImage() ) );
+            appendItem( parseImage() );
             break;
 
         case T_sheet:
@@ -2894,20 +2904,20 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
             // Complex hierarchies can have multiple copies of a sheet.  This only
             // provides a simple tree to find the root sheet.
             sheet->SetParent( aSheet );
-            screen->Append( sheet );
+            appendItem( sheet );
             break;
         }
 
         case T_junction:
-            screen->Append( parseJunction() );
+            appendItem( parseJunction() );
             break;
 
         case T_no_connect:
-            screen->Append( parseNoConnect() );
+            appendItem( parseNoConnect() );
             break;
 
         case T_bus_entry:
-            screen->Append( parseBusEntry() );
+            appendItem( parseBusEntry() );
             break;
 
         case T_polyline:
@@ -2925,7 +2935,7 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
 
             if( poly->GetPointCount() > 2 )
             {
-                screen->Append( poly );
+                appendItem( poly );
             }
             else
             {
@@ -2938,7 +2948,7 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
                 line->SetStroke( poly->GetStroke() );
                 const_cast<KIID&>( line->m_Uuid ) = poly->m_Uuid;
 
-                screen->Append( line );
+                appendItem( line );
 
                 delete poly;
             }
@@ -2947,27 +2957,27 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
 
         case T_bus:
         case T_wire:
-            screen->Append( parseLine() );
+            appendItem( parseLine() );
             break;
 
         case T_arc:
-            screen->Append( parseSchArc() );
+            appendItem( parseSchArc() );
             break;
 
         case T_circle:
-            screen->Append( parseSchCircle() );
+            appendItem( parseSchCircle() );
             break;
 
         case T_rectangle:
-            screen->Append( parseSchRectangle() );
+            appendItem( parseSchRectangle() );
             break;
 
         case T_bezier:
-            screen->Append( parseSchBezier() );
+            appendItem( parseSchBezier() );
             break;
 
         case T_rule_area:
-            screen->Append( parseSchRuleArea() );
+            appendItem( parseSchRuleArea() );
             break;
 
         case T_netclass_flag:       // present only during early development of 7.0
@@ -2978,15 +2988,15 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
         case T_global_label:
         case T_hierarchical_label:
         case T_directive_label:
-            screen->Append( parseSchText() );
+            appendItem( parseSchText() );
             break;
 
         case T_text_box:
-            screen->Append( parseSchTextBox() );
+            appendItem( parseSchTextBox() );
             break;
 
         case T_table:
-            screen->Append( parseSchTable() );
+            appendItem( parseSchTable() );
             break;
 
         case T_sheet_instances:
@@ -3049,6 +3059,14 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
         }
     }
 
+    std::vector<SCH_ITEM*> parsedItems;
+    parsedItems.reserve( items.size() );
+
+    for( std::unique_ptr<SCH_ITEM>& item : items )
+        parsedItems.push_back( item.release() );
+
+    screen->Append( parsedItems );
+
     // Older s-expression schematics may not have a UUID so use the one automatically generated
     // as the virtual root sheet UUID.
     if( ( aSheet == m_rootSheet ) && !fileHasUuid )
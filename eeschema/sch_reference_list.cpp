@@ -33,7 +33,9 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <string_utils.h>
@@ -43,6 +45,76 @@
 #include <sch_edit_frame.h>
 
 
+namespace
+{
+
+/**
+ * The annotated references of a list, grouped by reference prefix and then by reference number.
+ *
+ * This is the same map as the one built by SCH_REFERENCE_LIST::FindFirstUnusedReference(), but
+ * it is kept up to date while annotating instead of being rebuilt from the whole list for each
+ * symbol.
+ */
+class USED_REFERENCES_INDEX
+{
+public:
+    USED_REFERENCES_INDEX( const std::vector<SCH_REFERENCE>& aList )
+    {
+        for( const SCH_REFERENCE& ref : aList )
+            Add( ref );
+    }
+
+    /// Index \a aRef, unless it is to be reannotated.
+    void Add( const SCH_REFERENCE& aRef )
+    {
+        if( !aRef.m_isNew )
+            m_prefixes[aRef.GetRef().Lower()][aRef.m_numRef].push_back( aRef );
+    }
+
+    /// Remove \a aRef, which must not have been modified since it was added.
+    void Remove( const SCH_REFERENCE& aRef )
+    {
+        if( aRef.m_isNew )
+            return;
+
+        auto prefixIt = m_prefixes.find( aRef.GetRef().Lower() );
+
+        if( prefixIt == m_prefixes.end() )
+            return;
+
+        auto numberIt = prefixIt->second.find( aRef.m_numRef );
+
+        if( numberIt == prefixIt->second.end() )
+            return;
+
+        std::vector<SCH_REFERENCE>& refs = numberIt->second;
+
+        for( auto it = refs.begin(); it != refs.end(); ++it )
+        {
+            if( it->IsSameInstance( aRef ) )
+            {
+                refs.erase( it );
+                break;
+            }
+        }
+
+        if( refs.empty() )
+            prefixIt->second.erase( numberIt );
+    }
+
+    /// @return the annotated references with the same prefix as \a aRef, by reference number.
+    const std::map<int, std::vector<SCH_REFERENCE>>& GetRefNumberMap( const SCH_REFERENCE& aRef )
+    {
+        return m_prefixes[aRef.GetRef().Lower()];
+    }
+
+private:
+    std::unordered_map<wxString, std::map<int, std::vector<SCH_REFERENCE>>> m_prefixes;
+};
+
+} // namespace
+
+
 void SCH_REFERENCE_LIST::RemoveItem( unsigned int aIndex )
 {
     if( aIndex < m_flatList.size() )
@@ -448,6 +520,29 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
     int LastReferenceNumber = 0;
 
+    USED_REFERENCES_INDEX usedRefs( m_flatList );
+
+    auto findFirstUnusedReference =
+            [&]( const SCH_REFERENCE& aRef, int aMinValue, const std::vector<int>& aRequiredUnits )
+            {
+                return m_refDesTracker->GetNextRefDesForUnits( aRef, usedRefs.GetRefNumberMap( aRef ),
+                                                               aRequiredUnits, aMinValue );
+            };
+
+    // Locked unit lists by symbol instance.  If an instance is in several lists, the first one
+    // wins.
+    std::map<std::pair<const SCH_SYMBOL*, KIID_PATH>, const SCH_REFERENCE_LIST*> lockedLists;
+
+    for( const SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned thisRefI = 0; thisRefI < pair.second.GetCount(); ++thisRefI )
+        {
+            const SCH_REFERENCE& thisRef = pair.second[thisRefI];
+            lockedLists.emplace( std::make_pair( thisRef.GetSymbol(), thisRef.GetSheetPath().Path() ),
+                                 &pair.second );
+        }
+    }
+
     /* calculate index of the first symbol with the same reference prefix
      * than the current symbol.  All symbols having the same reference
      * prefix will receive a reference number with consecutive values:
@@ -475,23 +570,11 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         // Check whether this symbol is in aLockedUnitMap.
         const SCH_REFERENCE_LIST* lockedList = nullptr;
 
-        for( const SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+        if( auto it = lockedLists.find( std::make_pair( ref_unit.GetSymbol(),
+                                                        ref_unit.GetSheetPath().Path() ) );
+            it != lockedLists.end() )
         {
-            unsigned n_refs = pair.second.GetCount();
-
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
-            {
-                const SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( ref_unit ) )
-                {
-                    lockedList = &pair.second;
-                    break;
-                }
-            }
-
-            if( lockedList != nullptr )
-                break;
+            lockedList = it->second;
         }
 
         if(  ( m_flatList[first].CompareRef( ref_unit ) != 0 )
@@ -518,13 +601,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         {
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, {} );
+                LastReferenceNumber = findFirstUnusedReference( ref_unit, minRefId, {} );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = ref_unit.formatRefStr( LastReferenceNumber );
+                ref_unit.m_isNew = false;
+                usedRefs.Add( ref_unit );
             }
 
             ref_unit.m_flag  = 1;
-            ref_unit.m_isNew = false;
             continue;
         }
 
@@ -535,9 +619,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             unsigned n_refs = lockedList->GetCount();
             std::vector<int> units = lockedList->GetUnitsMatchingRef( ref_unit );
 
+            // Its number and unit may change below
+            usedRefs.Remove( ref_unit );
+
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+                LastReferenceNumber = findFirstUnusedReference( ref_unit, minRefId, units );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = ref_unit.formatRefStr( LastReferenceNumber );
                 ref_unit.m_isNew = false;
@@ -576,17 +663,23 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     // multiunits symbols have duplicate references)
                     if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                     {
+                        usedRefs.Remove( m_flatList[jj] );
+
                         m_flatList[jj].m_numRef = ref_unit.m_numRef;
                         m_flatList[jj].m_numRefStr = ref_unit.m_numRefStr;
                         m_flatList[jj].m_isNew = false;
                         m_flatList[jj].m_flag = 1;
 
+                        usedRefs.Add( m_flatList[jj] );
+
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
                         break;
                     }
                 }
             }
+
+            usedRefs.Add( ref_unit );
         }
         else if( ref_unit.m_isNew )
         {
@@ -594,11 +687,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             // know what group this might belong to, so just find the first unused reference for
             // this specific unit. The other units will be annotated in the following passes.
             std::vector<int> units = { ref_unit.GetUnit() };
-            LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+            LastReferenceNumber = findFirstUnusedReference( ref_unit, minRefId, units );
             ref_unit.m_numRef = LastReferenceNumber;
             ref_unit.m_numRefStr = ref_unit.formatRefStr( LastReferenceNumber );
             ref_unit.m_isNew = false;
             ref_unit.m_flag = 1;
+            usedRefs.Add( ref_unit );
         }
     }
 
@@ -71,6 +71,36 @@ public:
         m_count++;
     }
 
+    /**
+     * Insert several items at once.
+     *
+     * When the tree is empty or the new items outnumber the ones already in it, the whole
+     * tree is rebuilt in a single pass (see rebuild()), which is much faster than inserting
+     * the items one by one.
+     */
+    void insert( const std::vector<SCH_ITEM*>& aItems )
+    {
+        if( aItems.size() < m_count )
+        {
+            for( SCH_ITEM* item : aItems )
+                insert( item );
+        }
+        else if( !aItems.empty() )
+        {
+            bulkLoad( aItems );
+        }
+    }
+
+    /**
+     * Rebuild the tree from the current bounding boxes of its items.
+     *
+     * Use this rather than removing and inserting again each item after changing many of them.
+     */
+    void rebuild()
+    {
+        bulkLoad( {} );
+    }
+
     /**
      * Remove an item from the tree.
      *
@@ -304,6 +334,36 @@ public:
 
 
 private:
+    /**
+     * Build the tree again in a single pass from its current items plus \a aNewItems.
+     */
+    void bulkLoad( const std::vector<SCH_ITEM*>& aNewItems )
+    {
+        std::vector<std::pair<ee_rtree::Rect, SCH_ITEM*>> entries;
+        entries.reserve( m_count + aNewItems.size() );
+
+        for( SCH_ITEM* item : *this )
+            entries.emplace_back( itemRect( item ), item );
+
+        for( SCH_ITEM* item : aNewItems )
+            entries.emplace_back( itemRect( item ), item );
+
+        m_tree->BulkLoad( entries );
+        m_count = entries.size();
+    }
+
+    static ee_rtree::Rect itemRect( SCH_ITEM* aItem )
+    {
+        BOX2I bbox = aItem->GetBoundingBox();
+
+        // Inflate a bit for safety, selection shadows, etc.
+        bbox.Inflate( aItem->GetPenWidth() );
+
+        const int type = int( aItem->Type() );
+
+        return { { type, bbox.GetX(), bbox.GetY() }, { type, bbox.GetRight(), bbox.GetBottom() } };
+    }
+
     ee_rtree* m_tree;
     size_t    m_count;
 };
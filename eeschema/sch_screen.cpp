@@ -169,106 +169,131 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem, bool aUpdateLibSymbol )
         aItem->SetParent( this );
 
         if( aItem->Type() == SCH_SYMBOL_T && aUpdateLibSymbol )
-        {
-            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( aItem );
+            appendLibSymbol( static_cast<SCH_SYMBOL*>( aItem ) );
 
-            if( symbol->GetLibSymbolRef() )
-            {
-                symbol->GetLibSymbolRef()->GetDrawItems().sort();
+        m_rtree.insert( aItem );
+        --m_modification_sync;
+    }
+}
 
-                auto it = m_libSymbols.find( symbol->GetSchSymbolLibraryName() );
 
-                if( it == m_libSymbols.end() || !it->second )
-                {
-                    m_libSymbols[symbol->GetSchSymbolLibraryName()] =
-                            new LIB_SYMBOL( *symbol->GetLibSymbolRef() );
-                }
-                else
-                {
-                    // The original library symbol may have changed since the last time
-                    // it was added to the schematic.  If it has changed, then a new name
-                    // must be created for the library symbol list to prevent all of the
-                    // other schematic symbols referencing that library symbol from changing.
-                    LIB_SYMBOL* foundSymbol = it->second;
+void SCH_SCREEN::Append( const std::vector<SCH_ITEM*>& aItems, bool aUpdateLibSymbol )
+{
+    std::vector<SCH_ITEM*> items;
+    items.reserve( aItems.size() );
 
-                    foundSymbol->GetDrawItems().sort();
+    for( SCH_ITEM* item : aItems )
+    {
+        if( item->Type() == SCH_SHEET_PIN_T || item->Type() == SCH_FIELD_T )
+            continue;
 
-                    if( *foundSymbol != *symbol->GetLibSymbolRef() )
-                    {
-                        wxString newName;
-                        std::vector<wxString> matches;
+        item->SetParent( this );
 
-                        getLibSymbolNameMatches( *symbol, matches );
-                        foundSymbol = nullptr;
+        if( item->Type() == SCH_SYMBOL_T && aUpdateLibSymbol )
+            appendLibSymbol( static_cast<SCH_SYMBOL*>( item ) );
 
-                        for( const wxString& libSymbolName : matches )
-                        {
-                            it = m_libSymbols.find( libSymbolName );
+        items.push_back( item );
+        --m_modification_sync;
+    }
 
-                            if( it == m_libSymbols.end() )
-                                continue;
+    m_rtree.insert( items );
+}
 
-                            foundSymbol = it->second;
 
-                            wxCHECK2( foundSymbol, continue );
+void SCH_SCREEN::appendLibSymbol( SCH_SYMBOL* aSymbol )
+{
+    if( aSymbol->GetLibSymbolRef() )
+    {
+        aSymbol->GetLibSymbolRef()->GetDrawItems().sort();
 
-                            wxString tmp = symbol->GetLibSymbolRef()->GetName();
+        auto it = m_libSymbols.find( aSymbol->GetSchSymbolLibraryName() );
 
-                            // Temporarily update the new symbol library symbol name so it
-                            // doesn't fail on the name comparison below.
-                            symbol->GetLibSymbolRef()->SetName( foundSymbol->GetName() );
+        if( it == m_libSymbols.end() || !it->second )
+        {
+            m_libSymbols[aSymbol->GetSchSymbolLibraryName()] =
+                    new LIB_SYMBOL( *aSymbol->GetLibSymbolRef() );
+        }
+        else
+        {
+            // The original library symbol may have changed since the last time
+            // it was added to the schematic.  If it has changed, then a new name
+            // must be created for the library symbol list to prevent all of the
+            // other schematic symbols referencing that library symbol from changing.
+            LIB_SYMBOL* foundSymbol = it->second;
 
-                            if( *foundSymbol == *symbol->GetLibSymbolRef() )
-                            {
-                                newName = libSymbolName;
-                                symbol->GetLibSymbolRef()->SetName( tmp );
-                                break;
-                            }
+            foundSymbol->GetDrawItems().sort();
 
-                            symbol->GetLibSymbolRef()->SetName( tmp );
-                            foundSymbol = nullptr;
-                        }
+            if( *foundSymbol != *aSymbol->GetLibSymbolRef() )
+            {
+                wxString newName;
+                std::vector<wxString> matches;
 
-                        if( !foundSymbol )
-                        {
-                            int cnt = 1;
-
-                            newName.Printf( wxT( "%s_%d" ),
-                                            symbol->GetLibId().GetUniStringLibItemName(),
-                                            cnt );
-
-                            while( m_libSymbols.find( newName ) != m_libSymbols.end() )
-                            {
-                                cnt += 1;
-                                newName.Printf( wxT( "%s_%d" ),
-                                                symbol->GetLibId().GetUniStringLibItemName(),
-                                                cnt );
-                            }
-                        }
+                getLibSymbolNameMatches( *aSymbol, matches );
+                foundSymbol = nullptr;
 
-                        // Update the schematic symbol library link as this symbol only exists
-                        // in the schematic.
-                        symbol->SetSchSymbolLibraryName( newName );
+                for( const wxString& libSymbolName : matches )
+                {
+                    it = m_libSymbols.find( libSymbolName );
 
-                        if( !foundSymbol )
-                        {
-                            // Update the schematic symbol library link as this symbol does not
-                            // exist in any symbol library.
-                            LIB_ID newLibId( wxEmptyString, newName );
-                            LIB_SYMBOL* newLibSymbol = new LIB_SYMBOL( *symbol->GetLibSymbolRef() );
-
-                            newLibSymbol->SetLibId( newLibId );
-                            newLibSymbol->SetName( newName );
-                            symbol->SetLibSymbol( newLibSymbol->Flatten().release() );
-                            m_libSymbols[newName] = newLibSymbol;
-                        }
+                    if( it == m_libSymbols.end() )
+                        continue;
+
+                    foundSymbol = it->second;
+
+                    wxCHECK2( foundSymbol, continue );
+
+                    wxString tmp = aSymbol->GetLibSymbolRef()->GetName();
+
+                    // Temporarily update the new symbol library symbol name so it
+                    // doesn't fail on the name comparison below.
+                    aSymbol->GetLibSymbolRef()->SetName( foundSymbol->GetName() );
+
+                    if( *foundSymbol == *aSymbol->GetLibSymbolRef() )
+                    {
+                        newName = libSymbolName;
+                        aSymbol->GetLibSymbolRef()->SetName( tmp );
+                        break;
+                    }
+
+                    aSymbol->GetLibSymbolRef()->SetName( tmp );
+                    foundSymbol = nullptr;
+                }
+
+                if( !foundSymbol )
+                {
+                    int cnt = 1;
+
+                    newName.Printf( wxT( "%s_%d" ),
+                                    aSymbol->GetLibId().GetUniStringLibItemName(),
+                                    cnt );
+
+                    while( m_libSymbols.find( newName ) != m_libSymbols.end() )
+                    {
+                        cnt += 1;
+                        newName.Printf( wxT( "%s_%d" ),
+                                        aSymbol->GetLibId().GetUniStringLibItemName(),
+                                        cnt );
                     }
                 }
+
+                // Update the schematic symbol library link as this symbol only exists
+                // in the schematic.
+                aSymbol->SetSchSymbolLibraryName( newName );
+
+                if( !foundSymbol )
+                {
+                    // Update the schematic symbol library link as this symbol does not
+                    // exist in any symbol library.
+                    LIB_ID newLibId( wxEmptyString, newName );
+                    LIB_SYMBOL* newLibSymbol = new LIB_SYMBOL( *aSymbol->GetLibSymbolRef() );
+
+                    newLibSymbol->SetLibId( newLibId );
+                    newLibSymbol->SetName( newName );
+                    aSymbol->SetLibSymbol( newLibSymbol->Flatten().release() );
+                    m_libSymbols[newName] = newLibSymbol;
+                }
             }
         }
-
-        m_rtree.insert( aItem );
-        --m_modification_sync;
     }
 }
 
@@ -279,8 +304,13 @@ void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 
     // No need to descend the hierarchy.  Once the top level screen is copied, all of its
     // children are copied as well.
+    std::vector<SCH_ITEM*> items;
+    items.reserve( aScreen->m_rtree.size() );
+
     for( SCH_ITEM* aItem : aScreen->m_rtree )
-        Append( aItem );
+        items.push_back( aItem );
+
+    Append( items );
 
     aScreen->Clear( false );
 }
@@ -722,10 +752,6 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
     for( SCH_ITEM* item : Items().OfType( SCH_SYMBOL_T ) )
         symbols.push_back( static_cast<SCH_SYMBOL*>( item ) );
 
-    // Remove them from the R tree.  Their bounding box size may change.
-    for( SCH_SYMBOL* symbol : symbols )
-        Remove( symbol );
-
     // Clear all existing symbol links.
     clearLibSymbols();
 
@@ -853,10 +879,15 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
         }
     }
 
-    // Changing the symbol may adjust the bbox of the symbol.  This re-inserts the
-    // item with the new bbox
     for( SCH_SYMBOL* symbol : symbols )
-        Append( symbol );
+    {
+        appendLibSymbol( symbol );
+        --m_modification_sync;
+    }
+
+    // Changing the symbols may have adjusted their bounding boxes.  Re-index the whole screen
+    // at once rather than removing and inserting each symbol.
+    m_rtree.rebuild();
 }
 
 
@@ -869,18 +900,18 @@ void SCH_SCREEN::UpdateLocalLibSymbolLinks()
 
     for( SCH_SYMBOL* symbol : symbols )
     {
-        // Changing the symbol may adjust the bbox of the symbol; remove and reinsert it afterwards.
-        m_rtree.remove( symbol );
-
         auto it = m_libSymbols.find( symbol->GetSchSymbolLibraryName() );
 
         if( it != m_libSymbols.end() )
             symbol->SetLibSymbol( new LIB_SYMBOL( *it->second ) );
         else
             symbol->SetLibSymbol( nullptr );
-
-        m_rtree.insert( symbol );
     }
+
+    // Changing the symbols may have adjusted their bounding boxes.  Re-index the whole screen
+    // at once rather than removing and inserting each symbol.
+    if( !symbols.empty() )
+        m_rtree.rebuild();
 }
 
 
@@ -2062,6 +2093,20 @@ SCH_SHEET* SCH_SCREENS::GetSheet( unsigned int aIndex ) const
 }
 
 
+void SCH_SCREENS::ForEachItemOfType( std::initializer_list<KICAD_T> aTypes,
+                                     const std::function<void( SCH_SCREEN*, SCH_ITEM* )>& aFunction ) const
+{
+    for( SCH_SCREEN* screen : m_screens )
+    {
+        for( KICAD_T type : aTypes )
+        {
+            for( SCH_ITEM* item : screen->Items().OfType( type ) )
+                aFunction( screen, item );
+        }
+    }
+}
+
+
 void SCH_SCREENS::addScreenToList( SCH_SCREEN* aScreen, SCH_SHEET* aSheet )
 {
     if( aScreen == nullptr )
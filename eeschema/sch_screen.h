@@ -25,6 +25,8 @@
 #ifndef SCREEN_H
 #define SCREEN_H
 
+#include <functional>
+#include <initializer_list>
 #include <memory>
 #include <stddef.h>
 #include <unordered_set>
@@ -191,6 +193,14 @@ public:
 
     void Append( SCH_ITEM* aItem, bool aUpdateLibSymbol = true );
 
+    /**
+     * Append several items at once.
+     *
+     * Same as calling Append() for each item, but the items are added to the R-tree in a single
+     * pass which is much faster for large numbers of items, e.g. when loading a file.
+     */
+    void Append( const std::vector<SCH_ITEM*>& aItems, bool aUpdateLibSymbol = true );
+
     /**
      * Copy the contents of \a aScreen into this #SCH_SCREEN object.
      *
@@ -649,6 +659,12 @@ private:
 
     void clearLibSymbols();
 
+    /**
+     * Add the library symbol of \a aSymbol to the library symbols of this screen, renaming
+     * it if a different library symbol with the same name is already there.
+     */
+    void appendLibSymbol( SCH_SYMBOL* aSymbol );
+
     /**
      * Return a list of potential library symbol matches for \a aSymbol.
      *
@@ -755,6 +771,15 @@ public:
     SCH_SCREEN* GetScreen( unsigned int aIndex ) const;
     SCH_SHEET* GetSheet( unsigned int aIndex ) const;
 
+    /**
+     * Call \a aFunction for every item of one of \a aTypes in all the screens of the list.
+     *
+     * Only the items of the requested types are visited, using the type index of the R-tree
+     * of each screen, so this is much faster than walking all the items of each screen.
+     */
+    void ForEachItemOfType( std::initializer_list<KICAD_T> aTypes,
+                            const std::function<void( SCH_SCREEN*, SCH_ITEM* )>& aFunction ) const;
+
     /**
      * Clear the annotation for the symbols inside new sheetpaths
      * when a complex hierarchy is modified and new sheetpaths added
@@ -934,6 +934,48 @@ public:
      */
     bool m_ZoneFillIterativeRefill;
 
+    /**
+     * Classify the holes of hatched zone fills with a scanline, so that only the holes crossing
+     * the fill or zone outline are clipped.  When disabled, every hole is clipped.
+     *
+     * Setting name: "ZoneFillHatchScanline"
+     * Valid values: true or false
+     * Default value: true
+     */
+    bool m_ZoneFillHatchScanline;
+
+    /**
+     * Number of simulated annealing passes run by the footprint autoplacer after the initial
+     * greedy placement.  Each pass tries one random move per placed footprint.
+     *
+     * Setting name: "AutoplaceRefinementPasses"
+     * Valid values: 0 to 1000
+     * Default value: 0 (no refinement)
+     */
+    int m_AutoplaceRefinementPasses;
+
+    /**
+     * Number of selected items from which an interactive move only offsets the drawing of the
+     * selection while dragging, and moves the items themselves a few times per second and on
+     * drop.  0 always moves the items on every mouse motion.
+     *
+     * Setting name: "MoveDeferredItemThreshold"
+     * Valid values: 0 to 2147483647
+     * Default value: 500
+     */
+    int m_MoveDeferredItemThreshold;
+
+    /**
+     * When set, trace events (timed zones of zone filling, DRC, connectivity, file I/O, redraws,
+     * routing and jobs) are recorded from startup and written to this file as Chrome trace JSON
+     * on exit.  The file can be opened in https://ui.perfetto.dev or chrome://tracing.
+     *
+     * Setting name: "TraceEventsFile"
+     * Valid values: a file path
+     * Default value: empty (no tracing)
+     */
+    wxString m_TraceEventsFile;
+
     wxString m_traceMasks; ///< Trace masks for wxLogTrace, loaded from the config file.
     ///@}
 
@@ -116,7 +116,9 @@ private:
 
     char m_quoteChar;
 
-    typedef DATABASE_CACHE<std::map<std::string, ROW>> DB_CACHE_TYPE;
+    /// Whole tables by key column value.  The rows are shared rather than copied out of the cache
+    /// on each lookup, since a table can hold thousands of parts.
+    typedef DATABASE_CACHE<std::shared_ptr<const std::map<std::string, ROW>>> DB_CACHE_TYPE;
 
     std::unique_ptr<DB_CACHE_TYPE> m_cache;
 };
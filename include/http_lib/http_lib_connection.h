@@ -21,6 +21,8 @@
 #pragma once
 
 #include <any>
+#include <map>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 
 #include "http_lib/http_lib_settings.h"
@@ -57,6 +59,20 @@ public:
      */
     bool SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts );
 
+    /**
+     * Retrieve all parts from several categories of the HTTP library.
+     *
+     * The categories are fetched concurrently over a few keep-alive connections, which is much
+     * faster than calling SelectAll() once per category on libraries with many categories.
+     *
+     * @param aCategories are the categories to fetch parts from
+     * @param aParts will be filled with the parts of each category, by category id.  Categories
+     *               which could not be fetched are left out.
+     * @return true if all the categories were fetched, false otherwise
+     */
+    bool SelectAll( const std::vector<HTTP_LIB_CATEGORY>& aCategories,
+                    std::map<std::string, std::vector<HTTP_LIB_PART>>& aParts );
+
     std::string GetLastError() const { return m_lastError; }
 
     std::vector<HTTP_LIB_CATEGORY> getCategories() const { return m_categories; }
@@ -76,17 +92,32 @@ private:
     // KiCad crashing.  At this point we can't use smart pointers as there is a problem with
     // the order of how things are deleted/freed
     std::unique_ptr<KICAD_CURL_EASY> createCurlEasyObject()
+    {
+        return createCurlEasyObject( m_source );
+    }
+
+    static std::unique_ptr<KICAD_CURL_EASY> createCurlEasyObject( const HTTP_LIB_SOURCE& aSource )
     {
         std::unique_ptr<KICAD_CURL_EASY> aCurl( new KICAD_CURL_EASY() );
 
         // prepare curl
         aCurl->SetHeader( "Accept", "application/json" );
-        aCurl->SetHeader( "Authorization", "Token " + m_source.token );
+        aCurl->SetHeader( "Authorization", "Token " + aSource.token );
         aCurl->SetFollowRedirects( true );
 
         return aCurl;
     }
 
+    /**
+     * Fetch the parts of \a aCategory using \a aCurl.  Does not touch any member, so it can be
+     * run from worker threads.
+     *
+     * @return an empty string on success, the error message otherwise
+     */
+    static std::string fetchCategoryParts( const HTTP_LIB_SOURCE& aSource, KICAD_CURL_EASY& aCurl,
+                                           const HTTP_LIB_CATEGORY& aCategory,
+                                           std::vector<HTTP_LIB_PART>& aParts );
+
     bool validateHttpLibraryEndpoints();
 
     bool syncCategories();
@@ -98,6 +98,15 @@ public:
         m_layer = aLayer;
     }
 
+    /**
+     * Set an offset applied to the whole group when it is drawn.
+     *
+     * This allows previewing the group at another position (e.g. while dragging it) without
+     * moving each of its items, which would invalidate their cached geometry every time.
+     */
+    void SetDrawOffset( const VECTOR2I& aOffset ) { m_drawOffset = aOffset; }
+    const VECTOR2I& GetDrawOffset() const { return m_drawOffset; }
+
     /**
      * Free all the items that were added to the group.
      */
@@ -109,6 +118,7 @@ protected:
 protected:
     int                     m_layer;
     std::vector<VIEW_ITEM*> m_groupItems;       // No ownership.
+    VECTOR2I                m_drawOffset;
 };
 
 } // namespace KIGFX
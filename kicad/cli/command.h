@@ -30,6 +30,7 @@
 #define ARG_HELP "--help"
 #define ARG_HELP_SHORT "-h"
 #define ARG_HELP_DESC _( "Shows help message and exits" )
+#define ARG_TRACE_EVENTS "--trace-events"
 #define ARG_OUTPUT "--output"
 #define ARG_INPUT "input"
 #define ARG_DRAWING_SHEET "--drawing-sheet"
@@ -0,0 +1,66 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_autoplace.h"
+#include "jobs/job_pcb_autoplace.h"
+#include "cli/exit_codes.h"
+#include <wx/crt.h>
+
+#define ARG_OFFBOARD_ONLY "--offboard-only"
+#define ARG_REFINE_PASSES "--refine-passes"
+
+CLI::PCB_AUTOPLACE_COMMAND::PCB_AUTOPLACE_COMMAND() :
+        COMMAND( "autoplace" )
+{
+    addCommonArgs( true, true, false, false );
+    m_argParser.add_description( UTF8STDSTR( _( "Automatically place the unlocked footprints of "
+                                                "the board inside its outline" ) ) );
+
+    m_argParser.add_argument( ARG_OFFBOARD_ONLY )
+            .help( UTF8STDSTR( _( "Only place the footprints located outside the board outline" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_REFINE_PASSES )
+            .default_value( -1 )
+            .scan<'i', int>()
+            .help( UTF8STDSTR( _( "Number of refinement passes run after the initial placement "
+                                  "(default: the AutoplaceRefinementPasses advanced setting)" ) ) )
+            .metavar( "PASSES" );
+}
+
+
+int CLI::PCB_AUTOPLACE_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_AUTOPLACE> autoplaceJob = std::make_unique<JOB_PCB_AUTOPLACE>();
+
+    autoplaceJob->m_filename = m_argInput;
+    autoplaceJob->SetConfiguredOutputPath( m_argOutput );
+    autoplaceJob->m_offboardOnly = m_argParser.get<bool>( ARG_OFFBOARD_ONLY );
+    autoplaceJob->m_refinementPasses = m_argParser.get<int>( ARG_REFINE_PASSES );
+
+    if( !wxFile::Exists( autoplaceJob->m_filename ) )
+    {
+        wxFprintf( stderr, _( "Board file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, autoplaceJob.get() );
+
+    return exitCode;
+}
@@ -43,6 +43,7 @@
 #include "kicad_manager_frame.h"
 
 #include <build_version.h>
+#include <core/trace_events.h>
 #include <kiplatform/app.h>
 #include <kiplatform/environment.h>
 #include <locale_io.h>
@@ -73,6 +74,7 @@
 #include "cli/command_sch_export_netlist.h"
 #include "cli/command_sch_export_plot.h"
 #include "cli/command_pcb_upgrade.h"
+#include "cli/command_pcb_autoplace.h"
 #include "cli/command_fp.h"
 #include "cli/command_fp_export.h"
 #include "cli/command_fp_export_svg.h"
@@ -125,6 +127,7 @@ static CLI::PCB_COMMAND                  pcbCmd{};
 static CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
 static CLI::PCB_RENDER_COMMAND           pcbRenderCmd{};
 static CLI::PCB_UPGRADE_COMMAND          pcbUpgradeCmd{};
+static CLI::PCB_AUTOPLACE_COMMAND        pcbAutoplaceCmd{};
 static CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
 static CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
 static CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
@@ -201,6 +204,9 @@ static std::vector<COMMAND_ENTRY> commandStack = {
     {
         &pcbCmd,
         {
+            {
+                &pcbAutoplaceCmd
+            },
             {
                 &pcbDrcCmd
             },
@@ -371,6 +377,12 @@ int PGM_KICAD::OnPgmRun()
             .flag()
             .nargs( 0 );
 
+    argParser.add_argument( ARG_TRACE_EVENTS )
+            .help( UTF8STDSTR( _( "Record timing trace events and write them to the given file "
+                                  "as Chrome trace JSON" ) ) )
+            .default_value( std::string() )
+            .metavar( "FILE" );
+
     for( COMMAND_ENTRY& entry : commandStack )
     {
         recurseArgParserBuild( argParser, entry );
@@ -432,6 +444,9 @@ int PGM_KICAD::OnPgmRun()
         return 0;
     }
 
+    if( std::string traceFile = argParser.get<std::string>( ARG_TRACE_EVENTS ); !traceFile.empty() )
+        TRACE_EVENTS::Instance().Start( traceFile );
+
     CLI::COMMAND* cliCmd = nullptr;
 
     // the version arg gets redirected to the version subcommand
@@ -458,7 +473,12 @@ int PGM_KICAD::OnPgmRun()
 
     if( cliCmd )
     {
-        int exitCode = cliCmd->Perform( Kiway );
+        int exitCode;
+
+        {
+            TRACE_ZONE traceZone( "kicad-cli " + cliCmd->GetName(), "jobs" );
+            exitCode = cliCmd->Perform( Kiway );
+        }
 
         if( exitCode != CLI::EXIT_CODES::AVOID_CLOSING )
         {
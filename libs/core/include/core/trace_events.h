@@ -0,0 +1,176 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file trace_events.h
+ * @brief Recording of timed zones and counters, exported in the Chrome trace event format.
+ */
+
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Process-wide recorder of trace events.
+ *
+ * Recording is off until Start() is called, and costs a single relaxed atomic load per zone
+ * until then.  Each thread appends to its own buffer, so recording doesn't contend on a lock
+ * either.  The events are written as Chrome trace JSON, which can be opened in Perfetto
+ * (https://ui.perfetto.dev) or chrome://tracing.
+ *
+ * Recording is enabled with the "TraceEventsFile" advanced config setting or the
+ * --trace-events option of kicad-cli.  The file is written when the program exits.
+ */
+class TRACE_EVENTS
+{
+public:
+    static TRACE_EVENTS& Instance();
+
+    static bool IsEnabled() { return s_enabled.load( std::memory_order_relaxed ); }
+
+    /**
+     * Clear any previous events and start recording.
+     *
+     * @param aFileName is the file written by Finish(); can be empty if the caller writes the
+     *                  events itself with Write().
+     */
+    void Start( const std::string& aFileName = std::string() );
+
+    /**
+     * Stop recording and write the events to the file given to Start(), if any.
+     *
+     * @return false if the file could not be written.
+     */
+    bool Finish();
+
+    /**
+     * Record a zone which began at \a aStartUs and lasted \a aDurationUs microseconds, both in
+     * the GetRunningMicroSecs() time base.
+     */
+    void AddZone( const std::string& aName, const char* aCategory, int64_t aStartUs,
+                  int64_t aDurationUs );
+
+    /**
+     * Record the current value of a counter, shown as a graph in the trace viewers.
+     */
+    void AddCounter( const std::string& aName, int64_t aValue );
+
+    /**
+     * Write the events recorded so far as Chrome trace JSON.
+     */
+    void Write( std::ostream& aStream ) const;
+
+    /**
+     * Call \a aFunction for each zone recorded so far, e.g. to aggregate timings in-process.
+     */
+    void ForEachZone( const std::function<void( const std::string& aName, const char* aCategory,
+                                                int64_t aDurationUs )>& aFunction ) const;
+
+    size_t EventCount() const;
+
+private:
+    struct EVENT
+    {
+        std::string m_Name;
+        const char* m_Category;
+        char        m_Phase;        ///< 'X' for a complete zone, 'C' for a counter.
+        int64_t     m_Timestamp;
+        int64_t     m_Value;        ///< Duration of a zone or value of a counter.
+    };
+
+    struct THREAD_BUFFER
+    {
+        int                m_ThreadId;
+        std::mutex         m_Mutex;     ///< Only contended while writing the trace.
+        std::vector<EVENT> m_Events;
+    };
+
+    TRACE_EVENTS();
+
+    THREAD_BUFFER& threadBuffer();
+
+    void addEvent( EVENT&& aEvent );
+
+    static std::atomic<bool> s_enabled;
+
+    mutable std::mutex                          m_buffersMutex;
+    std::vector<std::shared_ptr<THREAD_BUFFER>> m_buffers;
+    std::string                                 m_fileName;
+    int64_t                                     m_originUs;
+};
+
+
+/**
+ * Scoped zone: records the time between its construction and destruction when tracing is
+ * enabled.
+ *
+ * @code
+ * {
+ *     TRACE_ZONE traceZone( "Fill zones", "zones" );
+ *     ...
+ * }
+ * @endcode
+ *
+ * @a aCategory must be a string literal, it is stored as a pointer.
+ */
+class TRACE_ZONE
+{
+public:
+    TRACE_ZONE( const char* aName, const char* aCategory = "kicad" ) :
+            m_category( aCategory ),
+            m_startUs( -1 )
+    {
+        if( TRACE_EVENTS::IsEnabled() )
+            start( aName );
+    }
+
+    TRACE_ZONE( const std::string& aName, const char* aCategory = "kicad" ) :
+            m_category( aCategory ),
+            m_startUs( -1 )
+    {
+        if( TRACE_EVENTS::IsEnabled() )
+            start( aName );
+    }
+
+    ~TRACE_ZONE();
+
+    TRACE_ZONE( const TRACE_ZONE& ) = delete;
+    TRACE_ZONE& operator=( const TRACE_ZONE& ) = delete;
+
+private:
+    void start( const std::string& aName );
+
+    std::string m_name;
+    const char* m_category;
+    int64_t     m_startUs;
+};
+
+#endif // TRACE_EVENTS_H
@@ -0,0 +1,247 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <core/trace_events.h>
+#include <core/profile.h>
+
+#include <cstdio>
+#include <fstream>
+
+
+std::atomic<bool> TRACE_EVENTS::s_enabled( false );
+
+
+static void writeJsonString( std::ostream& aStream, const std::string& aString )
+{
+    aStream << '"';
+
+    for( char c : aString )
+    {
+        switch( c )
+        {
+        case '"':  aStream << "\\\""; break;
+        case '\\': aStream << "\\\\"; break;
+        case '\n': aStream << "\\n";  break;
+        case '\r': aStream << "\\r";  break;
+        case '\t': aStream << "\\t";  break;
+        default:
+            if( static_cast<unsigned char>( c ) < 0x20 )
+            {
+                char buf[8];
+                std::snprintf( buf, sizeof( buf ), "\\u%04x", c );
+                aStream << buf;
+            }
+            else
+            {
+                aStream << c;
+            }
+        }
+    }
+
+    aStream << '"';
+}
+
+
+TRACE_EVENTS::TRACE_EVENTS() :
+        m_originUs( GetRunningMicroSecs() )
+{
+}
+
+
+TRACE_EVENTS& TRACE_EVENTS::Instance()
+{
+    static TRACE_EVENTS instance;
+    return instance;
+}
+
+
+void TRACE_EVENTS::Start( const std::string& aFileName )
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+    for( const std::shared_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        std::lock_guard<std::mutex> bufferLock( buffer->m_Mutex );
+        buffer->m_Events.clear();
+    }
+
+    m_fileName = aFileName;
+    m_originUs = GetRunningMicroSecs();
+    s_enabled.store( true );
+}
+
+
+bool TRACE_EVENTS::Finish()
+{
+    if( !s_enabled.exchange( false ) || m_fileName.empty() )
+        return true;
+
+    std::ofstream stream( m_fileName, std::ios::out | std::ios::trunc );
+
+    if( !stream )
+        return false;
+
+    Write( stream );
+    return stream.good();
+}
+
+
+TRACE_EVENTS::THREAD_BUFFER& TRACE_EVENTS::threadBuffer()
+{
+    // The buffer is owned by the recorder as well, so the events of threads which have exited
+    // are still written.
+    thread_local std::shared_ptr<THREAD_BUFFER> buffer;
+
+    if( !buffer )
+    {
+        buffer = std::make_shared<THREAD_BUFFER>();
+
+        std::lock_guard<std::mutex> lock( m_buffersMutex );
+        buffer->m_ThreadId = static_cast<int>( m_buffers.size() ) + 1;
+        m_buffers.push_back( buffer );
+    }
+
+    return *buffer;
+}
+
+
+void TRACE_EVENTS::addEvent( EVENT&& aEvent )
+{
+    THREAD_BUFFER&              buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock( buffer.m_Mutex );
+
+    buffer.m_Events.push_back( std::move( aEvent ) );
+}
+
+
+void TRACE_EVENTS::AddZone( const std::string& aName, const char* aCategory, int64_t aStartUs,
+                            int64_t aDurationUs )
+{
+    if( !IsEnabled() )
+        return;
+
+    addEvent( { aName, aCategory, 'X', aStartUs, aDurationUs } );
+}
+
+
+void TRACE_EVENTS::AddCounter( const std::string& aName, int64_t aValue )
+{
+    if( !IsEnabled() )
+        return;
+
+    addEvent( { aName, "counter", 'C', GetRunningMicroSecs(), aValue } );
+}
+
+
+size_t TRACE_EVENTS::EventCount() const
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+    size_t                      count = 0;
+
+    for( const std::shared_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        std::lock_guard<std::mutex> bufferLock( buffer->m_Mutex );
+        count += buffer->m_Events.size();
+    }
+
+    return count;
+}
+
+
+void TRACE_EVENTS::ForEachZone( const std::function<void( const std::string& aName,
+                                                         const char* aCategory,
+                                                         int64_t aDurationUs )>& aFunction ) const
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+    for( const std::shared_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        std::lock_guard<std::mutex> bufferLock( buffer->m_Mutex );
+
+        for( const EVENT& event : buffer->m_Events )
+        {
+            if( event.m_Phase == 'X' )
+                aFunction( event.m_Name, event.m_Category, event.m_Value );
+        }
+    }
+}
+
+
+void TRACE_EVENTS::Write( std::ostream& aStream ) const
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+    bool                        first = true;
+
+    aStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for( const std::shared_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        std::lock_guard<std::mutex> bufferLock( buffer->m_Mutex );
+
+        for( const EVENT& event : buffer->m_Events )
+        {
+            aStream << ( first ? "\n" : ",\n" );
+            first = false;
+
+            aStream << "{\"name\":";
+            writeJsonString( aStream, event.m_Name );
+            aStream << ",\"cat\":";
+            writeJsonString( aStream, event.m_Category );
+            aStream << ",\"ph\":\"" << event.m_Phase << "\""
+                    << ",\"ts\":" << event.m_Timestamp - m_originUs
+                    << ",\"pid\":1,\"tid\":" << buffer->m_ThreadId;
+
+            if( event.m_Phase == 'X' )
+            {
+                aStream << ",\"dur\":" << event.m_Value;
+            }
+            else
+            {
+                aStream << ",\"args\":{";
+                writeJsonString( aStream, event.m_Name );
+                aStream << ":" << event.m_Value << "}";
+            }
+
+            aStream << "}";
+        }
+    }
+
+    aStream << "\n]}\n";
+}
+
+
+void TRACE_ZONE::start( const std::string& aName )
+{
+    m_name = aName;
+    m_startUs = GetRunningMicroSecs();
+}
+
+
+TRACE_ZONE::~TRACE_ZONE()
+{
+    if( m_startUs >= 0 )
+    {
+        TRACE_EVENTS::Instance().AddZone( m_name, m_category, m_startUs,
+                                          GetRunningMicroSecs() - m_startUs );
+    }
+}
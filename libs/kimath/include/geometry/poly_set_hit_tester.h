@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+#include <math/box2.h>
+
+/**
+ * Point-in-polygon tester for a SHAPE_POLY_SET which is hit tested many times without being
+ * edited in between, such as a zone fill under the mouse cursor.
+ *
+ * Telling whether a polygon set was edited would mean hashing all of its points, which costs
+ * about as much as the hit tests saved, so its owner keeps a revision counter instead.
+ *
+ * The bounding boxes of every outline and hole are computed once, so a query only walks the
+ * edges of the contours whose box contains the point.  Unlike SHAPE_POLY_SET::BuildBBoxCaches()
+ * the boxes are stored in the tester, so the polygon set itself is never written to and can
+ * be shared with other threads.
+ */
+class POLY_SET_HIT_TESTER
+{
+public:
+    /**
+     * @param aPolySet is the polygon set to test, kept alive by the tester.
+     * @param aRevision is a counter maintained by the owner of \a aPolySet, which it bumps each
+     *                  time it edits the polygon set in place.
+     */
+    POLY_SET_HIT_TESTER( std::shared_ptr<const SHAPE_POLY_SET> aPolySet, unsigned aRevision );
+
+    /**
+     * Check that \a aPolySet is still the polygon set the tester was built for, and that it was
+     * not edited since (i.e. its owner's revision counter is still \a aRevision).
+     */
+    bool IsValidFor( const SHAPE_POLY_SET* aPolySet, unsigned aRevision ) const
+    {
+        return aPolySet == m_polySet.get() && aRevision == m_revision;
+    }
+
+    /**
+     * Same result as SHAPE_POLY_SET::Contains( aP, -1, aAccuracy ).
+     */
+    bool Contains( const VECTOR2I& aP, int aAccuracy = 0 ) const;
+
+private:
+    struct OUTLINE_BOXES
+    {
+        BOX2I              m_outline;
+        std::vector<BOX2I> m_holes;
+    };
+
+    std::shared_ptr<const SHAPE_POLY_SET> m_polySet;
+    std::vector<OUTLINE_BOXES>            m_boxes;
+    unsigned                              m_revision;
+};
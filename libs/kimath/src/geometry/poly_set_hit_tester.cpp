@@ -0,0 +1,74 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/poly_set_hit_tester.h>
+
+
+POLY_SET_HIT_TESTER::POLY_SET_HIT_TESTER( std::shared_ptr<const SHAPE_POLY_SET> aPolySet,
+                                          unsigned aRevision ) :
+        m_polySet( std::move( aPolySet ) ),
+        m_revision( aRevision )
+{
+    m_boxes.resize( m_polySet->OutlineCount() );
+
+    for( int ii = 0; ii < m_polySet->OutlineCount(); ii++ )
+    {
+        OUTLINE_BOXES& boxes = m_boxes[ii];
+
+        boxes.m_outline = m_polySet->COutline( ii ).BBox();
+        boxes.m_holes.reserve( m_polySet->HoleCount( ii ) );
+
+        for( int jj = 0; jj < m_polySet->HoleCount( ii ); jj++ )
+            boxes.m_holes.push_back( m_polySet->CHole( ii, jj ).BBox() );
+    }
+}
+
+
+bool POLY_SET_HIT_TESTER::Contains( const VECTOR2I& aP, int aAccuracy ) const
+{
+    for( int ii = 0; ii < (int) m_boxes.size(); ii++ )
+    {
+        const OUTLINE_BOXES& boxes = m_boxes[ii];
+        BOX2I                outlineBox = boxes.m_outline;
+
+        outlineBox.Inflate( std::max( aAccuracy, 0 ) );
+
+        if( !outlineBox.Contains( aP ) || !m_polySet->COutline( ii ).PointInside( aP, aAccuracy ) )
+            continue;
+
+        bool inHole = false;
+
+        // Same as SHAPE_POLY_SET::containsSingle(): the holes are tested without accuracy, so
+        // a point outside the box of a hole can't be inside it.
+        for( int jj = 0; jj < (int) boxes.m_holes.size() && !inHole; jj++ )
+        {
+            if( boxes.m_holes[jj].Contains( aP ) && m_polySet->CHole( ii, jj ).PointInside( aP, 1 ) )
+                inHole = true;
+        }
+
+        if( !inHole )
+            return true;
+    }
+
+    return false;
+}
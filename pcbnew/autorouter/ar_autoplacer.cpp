@@ -25,6 +25,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <confirm.h>
 #include <pcb_edit_frame.h>
 #include <widgets/msgpanel.h>
@@ -36,10 +37,12 @@
 #include <board_commit.h>
 #include <connectivity/connectivity_data.h>
 #include <progress_reporter.h>
+#include <thread_pool.h>
 
 #include "ar_autoplacer.h"
-#include "ar_matrix.h"
 #include <memory>
+#include <random>
+#include <nanoflann.hpp>
 #include <ratsnest/ratsnest_data.h>
 
 #define AR_GAIN            16
@@ -48,13 +51,66 @@
 
 #define STEP_AR_MM 1.0
 
-/* Bits characterizing cell */
-#define CELL_IS_EMPTY  0x00
-#define CELL_IS_HOLE   0x01   /* a conducting hole or obstacle */
-#define CELL_IS_MODULE 0x02   /* auto placement occupied by a footprint */
-#define CELL_IS_EDGE   0x20   /* Area and auto-placement: limiting cell contour (Board, Zone) */
-#define CELL_IS_FRIEND 0x40   /* Area and auto-placement: cell part of the net */
-#define CELL_IS_ZONE   0x80   /* Area and auto-placement: cell available */
+
+/**
+ * The positions of the pads of a net, in a k-d tree used to find the nearest pad of the net
+ * from a candidate pad position.
+ */
+class AR_NET_ANCHOR_TREE
+{
+public:
+    AR_NET_ANCHOR_TREE( std::vector<VECTOR2I>&& aPoints ) :
+            m_points( std::move( aPoints ) ),
+            m_tree( 2, *this )
+    {
+    }
+
+    // Required by nanoflann
+    size_t kdtree_get_point_count() const { return m_points.size(); }
+
+    // Returns the dim'th component of the idx'th point
+    double kdtree_get_pt( const size_t idx, const size_t dim ) const
+    {
+        if( dim == 0 )
+            return static_cast<double>( m_points[idx].x );
+        else
+            return static_cast<double>( m_points[idx].y );
+    }
+
+    template <class BBOX>
+    bool kdtree_get_bbox( BBOX& ) const
+    {
+        return false;
+    }
+
+    /**
+     * @return the pad of the net nearest to \a aPoint, or false if the net has no other pad.
+     */
+    bool Nearest( const VECTOR2I& aPoint, VECTOR2I& aNearest ) const
+    {
+        if( m_points.empty() )
+            return false;
+
+        const double query_pt[2] = { static_cast<double>( aPoint.x ),
+                                     static_cast<double>( aPoint.y ) };
+        uint32_t     index = 0;
+        double       dist = 0.0;
+
+        if( m_tree.knnSearch( query_pt, 1, &index, &dist ) == 0 )
+            return false;
+
+        aNearest = m_points[index];
+        return true;
+    }
+
+private:
+    using KDTREE = nanoflann::KDTreeSingleIndexAdaptor<
+            nanoflann::L2_Simple_Adaptor<double, AR_NET_ANCHOR_TREE>, AR_NET_ANCHOR_TREE,
+            2 /* dim */>;
+
+    std::vector<VECTOR2I> m_points;
+    KDTREE                m_tree;
+};
 
 
 AR_AUTOPLACER::AR_AUTOPLACER( BOARD* aBoard )
@@ -69,6 +125,7 @@ AR_AUTOPLACER::AR_AUTOPLACER( BOARD* aBoard )
     m_progressReporter = nullptr;
     m_refreshCallback = nullptr;
     m_minCost = 0.0;
+    m_refinementPasses = ADVANCED_CFG::GetCfg().m_AutoplaceRefinementPasses;
 }
 
 
@@ -78,14 +135,18 @@ void AR_AUTOPLACER::placeFootprint( FOOTPRINT* aFootprint, bool aDoNotRecreateRa
     if( !aFootprint )
         return;
 
+    removePadAnchors( aFootprint );
     aFootprint->SetPosition( aPos );
+    addPadAnchors( aFootprint );
     m_connectivity->Update( aFootprint );
 }
 
 
 int AR_AUTOPLACER::genPlacementRoutingMatrix()
 {
-    m_matrix.UnInitRoutingMatrix();
+    m_occupancy.Clear();
+    m_fpObstacles.clear();
+    m_netAnchors.clear();
 
     BOX2I bbox = m_board->GetBoardEdgesBoundingBox();
 
@@ -97,28 +158,20 @@ int AR_AUTOPLACER::genPlacementRoutingMatrix()
     m_topFreeArea = m_boardShape;
     m_bottomFreeArea = m_boardShape;
 
-    m_matrix.ComputeMatrixSize( bbox );
-    int nbCells = m_matrix.m_Ncols * m_matrix.m_Nrows;
-
-    // Choose the number of board sides.
-    m_matrix.m_RoutingLayersCount = 2;
-    m_matrix.InitRoutingMatrix();
-    m_matrix.m_routeLayerBottom = B_Cu;
-    m_matrix.m_routeLayerTop = F_Cu;
-
-    // Fill (mark) the cells inside the board:
-    fillMatrix();
+    m_occupancy.SetBoardShape( m_boardShape );
 
     // Other obstacles can be added here:
-    for( auto drawing : m_board->Drawings() )
+    for( BOARD_ITEM* drawing : m_board->Drawings() )
     {
         switch( drawing->Type() )
         {
         case PCB_SHAPE_T:
             if( drawing->GetLayer() != Edge_Cuts )
             {
-                m_matrix.TracePcbShape( (PCB_SHAPE*) drawing, CELL_IS_HOLE | CELL_IS_EDGE,
-                                        m_matrix.m_GridRouting, AR_MATRIX::WRITE_CELL );
+                BOX2I shapeBBox = drawing->GetBoundingBox();
+                shapeBBox.Inflate( m_gridSize / 2 );
+
+                m_occupancy.AddObstacle( shapeBBox, ( 1 << AR_SIDE_TOP ) | ( 1 << AR_SIDE_BOTTOM ) );
             }
 
             break;
@@ -128,131 +181,10 @@ int AR_AUTOPLACER::genPlacementRoutingMatrix()
         }
     }
 
-    // Initialize top layer. to the same value as the bottom layer
-    if( m_matrix.m_BoardSide[AR_SIDE_TOP] )
-    {
-        memcpy( m_matrix.m_BoardSide[AR_SIDE_TOP], m_matrix.m_BoardSide[AR_SIDE_BOTTOM],
-                nbCells * sizeof(AR_MATRIX::MATRIX_CELL) );
-    }
-
     return 1;
 }
 
 
-bool AR_AUTOPLACER::fillMatrix()
-{
-    std::vector <int> x_coordinates;
-    bool success = true;
-    int step = m_matrix.m_GridRouting;
-    VECTOR2I coord_orgin = m_matrix.GetBrdCoordOrigin(); // Board coordinate of matruix cell (0,0)
-
-    // Create a single board outline:
-    SHAPE_POLY_SET brd_shape = m_boardShape.CloneDropTriangulation();
-    brd_shape.Fracture();
-    const SHAPE_LINE_CHAIN& outline = brd_shape.Outline(0);
-    const BOX2I& rect = outline.BBox();
-
-    // Creates the horizontal segments
-    // Calculate the y limits of the area
-    for( int refy = rect.GetY(), endy = rect.GetBottom(); refy < endy; refy += step )
-    {
-        // The row index (vertical position) of current line scan inside the placement matrix
-        int idy = (refy - coord_orgin.y) / step;
-
-        // Ensure we are still inside the placement matrix
-        if( idy >= m_matrix.m_Nrows )
-            break;
-
-        // Ensure we are inside the placement matrix
-        if( idy <= 0 )
-            continue;
-
-        // find all intersection points of an infinite line with polyline sides
-        x_coordinates.clear();
-
-        for( int v = 0; v < outline.PointCount(); v++ )
-        {
-            int seg_startX = outline.CPoint( v ).x;
-            int seg_startY = outline.CPoint( v ).y;
-            int seg_endX   = outline.CPoint( v + 1 ).x;
-            int seg_endY   = outline.CPoint( v + 1 ).y;
-
-            /* Trivial cases: skip if ref above or below the segment to test */
-            if( ( seg_startY > refy ) && ( seg_endY > refy ) )
-                continue;
-
-            // segment below ref point, or its Y end pos on Y coordinate ref point: skip
-            if( ( seg_startY <= refy ) && (seg_endY <= refy ) )
-                continue;
-
-            /* at this point refy is between seg_startY and seg_endY
-             * see if an horizontal line at Y = refy is intersecting this segment
-             */
-            // calculate the x position of the intersection of this segment and the
-            // infinite line this is more easier if we move the X,Y axis origin to
-            // the segment start point:
-
-            seg_endX -= seg_startX;
-            seg_endY -= seg_startY;
-            double newrefy = (double) ( refy - seg_startY );
-            double intersec_x;
-
-            if ( seg_endY == 0 )    // horizontal segment on the same line: skip
-                continue;
-
-            // Now calculate the x intersection coordinate of the horizontal line at
-            // y = newrefy and the segment from (0,0) to (seg_endX,seg_endY) with the
-            // horizontal line at the new refy position the line slope is:
-            // slope = seg_endY/seg_endX; and inv_slope = seg_endX/seg_endY
-            // and the x pos relative to the new origin is:
-            // intersec_x = refy/slope = refy * inv_slope
-            // Note: because horizontal segments are already tested and skipped, slope
-            // exists (seg_end_y not O)
-            double inv_slope = (double) seg_endX / seg_endY;
-            intersec_x = newrefy * inv_slope;
-            x_coordinates.push_back( (int) intersec_x + seg_startX );
-        }
-
-        // A line scan is finished: build list of segments
-
-        // Sort intersection points by increasing x value:
-        // So 2 consecutive points are the ends of a segment
-        std::sort( x_coordinates.begin(), x_coordinates.end() );
-
-        // An even number of coordinates is expected, because a segment has 2 ends.
-        // An if this algorithm always works, it must always find an even count.
-        if( ( x_coordinates.size() & 1 ) != 0 )
-        {
-            success = false;
-            break;
-        }
-
-        // Fill cells having the same Y coordinate
-        int iimax = x_coordinates.size() - 1;
-
-        for( int ii = 0; ii < iimax; ii += 2 )
-        {
-            int seg_start_x = x_coordinates[ii] - coord_orgin.x;
-            int seg_end_x = x_coordinates[ii + 1] - coord_orgin.x;
-
-            // Fill cells at y coord = idy,
-            // and at x cood >= seg_start_x and <= seg_end_x
-
-            for( int idx = seg_start_x / step; idx < m_matrix.m_Ncols; idx++ )
-            {
-                if( idx * step > seg_end_x )
-                    break;
-
-                if( idx * step >= seg_start_x )
-                    m_matrix.SetCell( idy, idx, AR_SIDE_BOTTOM, CELL_IS_ZONE );
-            }
-        }
-    }   // End examine segments in one area
-
-    return success;
-}
-
-
 void AR_AUTOPLACER::addFpBody( const VECTOR2I& aStart, const VECTOR2I& aEnd, const LSET& aLayerMask )
 {
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
@@ -321,7 +253,7 @@ void AR_AUTOPLACER::buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance )
 
     BOX2I fpBBox = aFootprint->GetBoundingBox( false );
 
-    fpBBox.Inflate( ( m_matrix.m_GridRouting / 2 ) + aFpClearance );
+    fpBBox.Inflate( ( m_gridSize / 2 ) + aFpClearance );
 
     // Add a minimal area to the fp area:
     addFpBody( fpBBox.GetOrigin(), fpBBox.GetEnd(), layerMask );
@@ -329,67 +261,76 @@ void AR_AUTOPLACER::buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance )
     // Trace pads + clearance areas.
     for( PAD* pad : aFootprint->Pads() )
     {
-        int margin = (m_matrix.m_GridRouting / 2) + pad->GetOwnClearance( pad->GetLayer() );
+        int margin = ( m_gridSize / 2 ) + pad->GetOwnClearance( pad->GetLayer() );
         addPad( pad, margin );
     }
 }
 
 
-void AR_AUTOPLACER::genModuleOnRoutingMatrix( FOOTPRINT* aFootprint )
+int AR_AUTOPLACER::footprintSide( FOOTPRINT* aFootprint ) const
 {
-    int   ox, oy, fx, fy;
-    LSET  layerMask;
-    BOX2I fpBBox = aFootprint->GetBoundingBox( false );
-
-    fpBBox.Inflate( m_matrix.m_GridRouting / 2 );
-    ox  = fpBBox.GetX();
-    fx  = fpBBox.GetRight();
-    oy  = fpBBox.GetY();
-    fy  = fpBBox.GetBottom();
+    return aFootprint->GetLayer() == B_Cu ? AR_SIDE_BOTTOM : AR_SIDE_TOP;
+}
 
-    if( ox < m_matrix.m_BrdBox.GetX() )
-        ox = m_matrix.m_BrdBox.GetX();
 
-    if( ox > m_matrix.m_BrdBox.GetRight() )
-        ox = m_matrix.m_BrdBox.GetRight();
+bool AR_AUTOPLACER::hasPadsOnOtherSide( FOOTPRINT* aFootprint ) const
+{
+    LSET other( { aFootprint->GetLayer() == B_Cu ? F_Cu : B_Cu } );
 
-    if( fx < m_matrix.m_BrdBox.GetX() )
-        fx = m_matrix.m_BrdBox.GetX();
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        if( ( pad->GetLayerSet() & other ).any() )
+            return true;
+    }
 
-    if( fx > m_matrix.m_BrdBox.GetRight() )
-        fx = m_matrix.m_BrdBox.GetRight();
+    return false;
+}
 
-    if( oy < m_matrix.m_BrdBox.GetY() )
-        oy = m_matrix.m_BrdBox.GetY();
 
-    if( oy > m_matrix.m_BrdBox.GetBottom() )
-        oy = m_matrix.m_BrdBox.GetBottom();
+BOX2I AR_AUTOPLACER::footprintObstacleBox( FOOTPRINT* aFootprint, const VECTOR2I& aPos ) const
+{
+    BOX2I fpBBox = aFootprint->GetBoundingBox( false );
 
-    if( fy < m_matrix.m_BrdBox.GetY() )
-        fy = m_matrix.m_BrdBox.GetY();
+    // Pads clearance areas.
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        BOX2I padBBox = pad->GetBoundingBox();
+        padBBox.Inflate( pad->GetOwnClearance( pad->GetLayer() ) );
+        fpBBox.Merge( padBBox );
+    }
 
-    if( fy > m_matrix.m_BrdBox.GetBottom() )
-        fy = m_matrix.m_BrdBox.GetBottom();
+    fpBBox.Inflate( m_gridSize / 2 );
+    fpBBox.Move( aPos - aFootprint->GetPosition() );
 
-    if( aFootprint->GetLayer() == F_Cu )
-        layerMask.set( F_Cu );
+    return fpBBox;
+}
 
-    if( aFootprint->GetLayer() == B_Cu )
-        layerMask.set( B_Cu );
 
-    m_matrix.TraceFilledRectangle( ox, oy, fx, fy, layerMask,
-                                   CELL_IS_MODULE, AR_MATRIX::WRITE_OR_CELL );
+void AR_AUTOPLACER::addFootprintObstacle( FOOTPRINT* aFootprint )
+{
+    int sides = 1 << footprintSide( aFootprint );
 
-    // Trace pads + clearance areas.
-    for( PAD* pad : aFootprint->Pads() )
-    {
-        int margin = (m_matrix.m_GridRouting / 2) + pad->GetOwnClearance( pad->GetLayer() );
-        m_matrix.PlacePad( pad, CELL_IS_MODULE, margin, AR_MATRIX::WRITE_OR_CELL );
-    }
+    if( hasPadsOnOtherSide( aFootprint ) )
+        sides = ( 1 << AR_SIDE_TOP ) | ( 1 << AR_SIDE_BOTTOM );
 
     // Trace clearance.
-    int margin = ( m_matrix.m_GridRouting * aFootprint->GetPadCount() ) / AR_GAIN;
-    m_matrix.CreateKeepOutRectangle( ox, oy, fx, fy, margin, AR_KEEPOUT_MARGIN , layerMask );
+    int margin = ( m_gridSize * aFootprint->GetPadCount() ) / AR_GAIN;
+    int handle = m_occupancy.AddObstacle( footprintObstacleBox( aFootprint,
+                                                                aFootprint->GetPosition() ),
+                                          sides, margin, AR_KEEPOUT_MARGIN );
+
+    m_fpObstacles[aFootprint] = handle;
+}
+
+
+void AR_AUTOPLACER::genModuleOnRoutingMatrix( FOOTPRINT* aFootprint )
+{
+    addFootprintObstacle( aFootprint );
+
+    if( !m_overlay )
+        return;
+
+    int margin = ( m_gridSize * aFootprint->GetPadCount() ) / AR_GAIN;
 
     // Build the footprint courtyard
     buildFpAreas( aFootprint, margin );
@@ -400,297 +341,237 @@ void AR_AUTOPLACER::genModuleOnRoutingMatrix( FOOTPRINT* aFootprint )
 }
 
 
-int AR_AUTOPLACER::testRectangle( const BOX2I& aRect, int side )
+void AR_AUTOPLACER::rebuildFreeAreas()
 {
-    BOX2I rect = aRect;
-
-    rect.Inflate( m_matrix.m_GridRouting / 2 );
-
-    VECTOR2I start = rect.GetOrigin();
-    VECTOR2I end     = rect.GetEnd();
-
-    start   -= m_matrix.m_BrdBox.GetOrigin();
-    end     -= m_matrix.m_BrdBox.GetOrigin();
+    if( !m_overlay )
+        return;
 
-    int row_min = start.y / m_matrix.m_GridRouting;
-    int row_max = end.y / m_matrix.m_GridRouting;
-    int col_min = start.x / m_matrix.m_GridRouting;
-    int col_max = end.x / m_matrix.m_GridRouting;
+    m_topFreeArea = m_boardShape;
+    m_bottomFreeArea = m_boardShape;
 
-    if( start.y > row_min * m_matrix.m_GridRouting )
-        row_min++;
+    for( const auto& [footprint, handle] : m_fpObstacles )
+    {
+        buildFpAreas( footprint, ( m_gridSize * footprint->GetPadCount() ) / AR_GAIN );
+        m_topFreeArea.BooleanSubtract( m_fpAreaTop );
+        m_bottomFreeArea.BooleanSubtract( m_fpAreaBottom );
+    }
+}
 
-    if( start.x > col_min * m_matrix.m_GridRouting )
-        col_min++;
 
-    if( row_min < 0 )
-        row_min = 0;
+void AR_AUTOPLACER::addPadAnchors( FOOTPRINT* aFootprint )
+{
+    if( !m_occupancy.GetBoardBox().Contains( aFootprint->GetPosition() ) )
+        return;
 
-    if( row_max >= ( m_matrix.m_Nrows - 1 ) )
-        row_max = m_matrix.m_Nrows - 1;
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        if( pad->GetNetCode() <= 0 )
+            continue;
 
-    if( col_min < 0 )
-        col_min = 0;
+        m_netAnchors[pad->GetNetCode()].push_back( { pad->GetPosition(), aFootprint } );
+    }
+}
 
-    if( col_max >= ( m_matrix.m_Ncols - 1 ) )
-        col_max = m_matrix.m_Ncols - 1;
 
-    for( int row = row_min; row <= row_max; row++ )
+void AR_AUTOPLACER::removePadAnchors( FOOTPRINT* aFootprint )
+{
+    for( PAD* pad : aFootprint->Pads() )
     {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            unsigned int data = m_matrix.GetCell( row, col, side );
+        auto it = m_netAnchors.find( pad->GetNetCode() );
 
-            if( ( data & CELL_IS_ZONE ) == 0 )
-                return AR_OUT_OF_BOARD;
+        if( it == m_netAnchors.end() )
+            continue;
 
-            if( (data & CELL_IS_MODULE) )
-                return AR_OCCUIPED_BY_MODULE;
-        }
+        std::erase_if( it->second,
+                       [&]( const PAD_ANCHOR& aAnchor )
+                       {
+                           return aAnchor.m_parent == aFootprint;
+                       } );
     }
-
-    return AR_FREE_CELL;
 }
 
 
-unsigned int AR_AUTOPLACER::calculateKeepOutArea( const BOX2I& aRect, int side )
+void AR_AUTOPLACER::buildNetAnchorTrees( FOOTPRINT* aFootprint )
 {
-    VECTOR2I start = aRect.GetOrigin();
-    VECTOR2I end = aRect.GetEnd();
+    m_anchorTrees.clear();
 
-    start   -= m_matrix.m_BrdBox.GetOrigin();
-    end     -= m_matrix.m_BrdBox.GetOrigin();
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        int netCode = pad->GetNetCode();
 
-    int row_min = start.y / m_matrix.m_GridRouting;
-    int row_max = end.y / m_matrix.m_GridRouting;
-    int col_min = start.x / m_matrix.m_GridRouting;
-    int col_max = end.x / m_matrix.m_GridRouting;
+        if( netCode <= 0 || m_anchorTrees.count( netCode ) )
+            continue;
 
-    if( start.y > row_min * m_matrix.m_GridRouting )
-        row_min++;
+        std::vector<VECTOR2I> points;
+        auto                  it = m_netAnchors.find( netCode );
 
-    if( start.x > col_min * m_matrix.m_GridRouting )
-        col_min++;
+        if( it != m_netAnchors.end() )
+        {
+            for( const PAD_ANCHOR& anchor : it->second )
+            {
+                if( anchor.m_parent != aFootprint )
+                    points.push_back( anchor.m_pos );
+            }
+        }
 
-    if( row_min < 0 )
-        row_min = 0;
+        m_anchorTrees[netCode] = std::make_shared<AR_NET_ANCHOR_TREE>( std::move( points ) );
+    }
+}
 
-    if( row_max >= ( m_matrix.m_Nrows - 1 ) )
-        row_max = m_matrix.m_Nrows - 1;
 
-    if( col_min < 0 )
-        col_min = 0;
+AR_AUTOPLACER::FP_SNAPSHOT AR_AUTOPLACER::snapshotFootprint( FOOTPRINT* aFootprint ) const
+{
+    FP_SNAPSHOT snapshot;
+    VECTOR2I    fpPos = aFootprint->GetPosition();
 
-    if( col_max >= ( m_matrix.m_Ncols - 1 ) )
-        col_max = m_matrix.m_Ncols - 1;
+    // Move the bounding box to have the footprint position at (0,0)
+    snapshot.m_relBBox = aFootprint->GetBoundingBox( false );
+    snapshot.m_relBBox.Move( -fpPos );
 
-    unsigned int keepOutCost = 0;
+    snapshot.m_side = footprintSide( aFootprint );
+    snapshot.m_testOtherSide = hasPadsOnOtherSide( aFootprint );
+    snapshot.m_keepOutMargin = ( m_gridSize * aFootprint->GetPadCount() ) / AR_GAIN;
 
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            // m_matrix.GetDist returns the "cost" of the cell
-            // at position (row, col)
-            // in autoplace this is the cost of the cell, if it is
-            // inside aRect
-            keepOutCost += m_matrix.GetDist( row, col, side );
-        }
-    }
+    for( PAD* pad : aFootprint->Pads() )
+        snapshot.m_pads.push_back( { pad->GetPosition() - fpPos, pad->GetNetCode() } );
 
-    return keepOutCost;
+    return snapshot;
 }
 
 
-int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSide,
-                                         const VECTOR2I& aOffset )
+double AR_AUTOPLACER::testFootprintOnBoard( const FP_SNAPSHOT& aFootprint, const VECTOR2I& aPos,
+                                            int aIgnore ) const
 {
-    int side = AR_SIDE_TOP;
-    int otherside = AR_SIDE_BOTTOM;
-
-    if( aFootprint->GetLayer() == B_Cu )
-    {
-        side = AR_SIDE_BOTTOM; otherside = AR_SIDE_TOP;
-    }
+    int side = aFootprint.m_side;
+    int otherside = side == AR_SIDE_TOP ? AR_SIDE_BOTTOM : AR_SIDE_TOP;
 
-    BOX2I fpBBox = aFootprint->GetBoundingBox( false );
-    fpBBox.Move( -1*aOffset );
+    BOX2I fpBBox = aFootprint.m_relBBox;
+    fpBBox.Move( aPos );
+    fpBBox.Inflate( m_gridSize / 2 );
 
-    int diag = testRectangle( fpBBox, side );
+    if( !m_occupancy.IsInsideBoard( fpBBox ) )
+        return AR_OUT_OF_BOARD;
 
-    if( diag != AR_FREE_CELL )
-        return diag;
+    if( !m_occupancy.IsFree( fpBBox, side, aIgnore ) )
+        return AR_OCCUIPED_BY_MODULE;
 
-    if( TstOtherSide )
-    {
-        diag = testRectangle( fpBBox, otherside );
+    if( aFootprint.m_testOtherSide && !m_occupancy.IsFree( fpBBox, otherside, aIgnore ) )
+        return AR_OCCUIPED_BY_MODULE;
 
-        if( diag != AR_FREE_CELL )
-            return diag;
-    }
-
-    int marge = ( m_matrix.m_GridRouting * aFootprint->GetPadCount() ) / AR_GAIN;
-
-    fpBBox.Inflate( marge );
-    return calculateKeepOutArea( fpBBox, side );
+    fpBBox.Inflate( aFootprint.m_keepOutMargin );
+    return m_occupancy.KeepOutCost( fpBBox, side, m_gridSize, aIgnore );
 }
 
 
 int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
 {
-    int     error = 1;
-    VECTOR2I lastPosOK;
-    double  min_cost, curr_cost, Score;
-    bool    testOtherSide;
-
-    lastPosOK = m_matrix.m_BrdBox.GetOrigin();
+    struct CANDIDATE
+    {
+        VECTOR2I m_pos;
+        double   m_score = -1.0;
+    };
 
-    VECTOR2I fpPos = aFootprint->GetPosition();
-    BOX2I    fpBBox = aFootprint->GetBoundingBox( false );
+    const BOX2I& boardBox = m_occupancy.GetBoardBox();
 
-    // Move fpBBox to have the footprint position at (0,0)
-    fpBBox.Move( -fpPos );
-    VECTOR2I fpBBoxOrg = fpBBox.GetOrigin();
+    // The workers only read this copy of the footprint and the occupancy map, never the
+    // board items.
+    const FP_SNAPSHOT snapshot = snapshotFootprint( aFootprint );
+    const BOX2I&      fpBBox = snapshot.m_relBBox;
+    VECTOR2I          fpBBoxOrg = fpBBox.GetOrigin();
 
-    // Calculate the limit of the footprint position, relative to the routing matrix area
-    VECTOR2I xylimit = m_matrix.m_BrdBox.GetEnd() - fpBBox.GetEnd();
+    // Calculate the limit of the footprint position, relative to the board area
+    VECTOR2I xylimit = boardBox.GetEnd() - fpBBox.GetEnd();
 
-    VECTOR2I initialPos = m_matrix.m_BrdBox.GetOrigin() - fpBBoxOrg;
+    VECTOR2I initialPos = boardBox.GetOrigin() - fpBBoxOrg;
 
     // Stay on grid.
-    initialPos.x    -= initialPos.x % m_matrix.m_GridRouting;
-    initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
-
-    m_curPosition = initialPos;
-    VECTOR2I fpOffset = fpPos - m_curPosition;
+    initialPos.x    -= initialPos.x % m_gridSize;
+    initialPos.y    -= initialPos.y % m_gridSize;
 
-    // Examine pads, and set testOtherSide to true if a footprint has at least 1 pad through.
-    testOtherSide = false;
-
-    if( m_matrix.m_RoutingLayersCount > 1 )
+    if( xylimit.x <= initialPos.x || xylimit.y <= initialPos.y )
     {
-        LSET other( { aFootprint->GetLayer() == B_Cu ? F_Cu : B_Cu } );
-
-        for( PAD* pad : aFootprint->Pads() )
-        {
-            if( !( pad->GetLayerSet() & other ).any() )
-                continue;
-
-            testOtherSide = true;
-            break;
-        }
+        m_curPosition = boardBox.GetOrigin();
+        m_minCost = -1.0;
+        return 1;
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-
-    min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
+    buildNetAnchorTrees( aFootprint );
 
+    int colCount = ( xylimit.x - initialPos.x + m_gridSize - 1 ) / m_gridSize;
+    int rowCount = ( xylimit.y - initialPos.y + m_gridSize - 1 ) / m_gridSize;
 
-    for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
-    {
-        m_curPosition.y = initialPos.y;
+    std::vector<CANDIDATE> bestInColumn( colCount );
+    thread_pool&           tp = GetKiCadThreadPool();
 
-        for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
-        {
-
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            fpOffset = fpPos - m_curPosition;
-            int keepOutCost = testFootprintOnBoard( aFootprint, testOtherSide, fpOffset );
-
-            if( keepOutCost >= 0 )    // i.e. if the footprint can be put here
+    auto results = tp.submit_loop( 0, colCount,
+            [&]( const int col )
             {
-                error = 0;
-                // m_frame->build_ratsnest_footprint( aFootprint ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aFootprint, fpOffset );
-                Score       = curr_cost + keepOutCost;
+                CANDIDATE& best = bestInColumn[col];
 
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
+                for( int row = 0; row < rowCount; row++ )
                 {
-                    lastPosOK   = m_curPosition;
-                    min_cost    = Score;
-/*
-                    wxString msg;
-                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                ::CoordinateToString( LastPosOK.x ),
-                                ::CoordinateToString( LastPosOK.y ) );
-                    m_frame->SetStatusText( msg );*/
-                }
-            }
-        }
-    }
+                    VECTOR2I pos( initialPos.x + col * m_gridSize,
+                                  initialPos.y + row * m_gridSize );
+                    double   keepOutCost = testFootprintOnBoard( snapshot, pos );
 
-    // Regeneration of the modified variable.
-    m_curPosition = lastPosOK;
+                    if( keepOutCost < 0 )    // i.e. if the footprint cannot be put here
+                        continue;
 
-    m_minCost = min_cost;
-    return error;
-}
+                    double score = computePlacementRatsnestCost( snapshot.m_pads, pos )
+                                   + keepOutCost;
 
+                    if( best.m_score < 0 || score <= best.m_score )
+                    {
+                        best.m_pos = pos;
+                        best.m_score = score;
+                    }
+                }
+            } );
+    results.wait();
 
-const PAD* AR_AUTOPLACER::nearestPad( FOOTPRINT* aRefFP, PAD* aRefPad, const VECTOR2I& aOffset )
-{
-    const PAD* nearest = nullptr;
-    int64_t    nearestDist = INT64_MAX;
+    m_anchorTrees.clear();
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        if ( footprint == aRefFP )
-            continue;
+    // Reduce serially so that the result does not depend on the scheduling of the workers.
+    CANDIDATE best;
+    best.m_pos = boardBox.GetOrigin();
 
-        if( !m_matrix.m_BrdBox.Contains( footprint->GetPosition() ) )
+    for( const CANDIDATE& candidate : bestInColumn )
+    {
+        if( candidate.m_score < 0 )
             continue;
 
-        for( PAD* pad: footprint->Pads() )
-        {
-            if( pad->GetNetCode() != aRefPad->GetNetCode() || pad->GetNetCode() <= 0 )
-                continue;
-
-            auto dist = ( VECTOR2I( aRefPad->GetPosition() - aOffset ) -
-                          VECTOR2I( pad->GetPosition() ) ).EuclideanNorm();
-
-            if ( dist < nearestDist )
-            {
-                nearestDist = dist;
-                nearest = pad;
-            }
-        }
+        if( best.m_score < 0 || candidate.m_score <= best.m_score )
+            best = candidate;
     }
 
-    return nearest;
+    m_curPosition = best.m_pos;
+    m_minCost = best.m_score;
+
+    return best.m_score < 0 ? 1 : 0;
 }
 
 
-double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT* aFootprint, const VECTOR2I& aOffset )
+double AR_AUTOPLACER::computePlacementRatsnestCost( const std::vector<PAD_OFFSET>& aPads,
+                                                    const VECTOR2I& aPos ) const
 {
-    double  curr_cost;
-    VECTOR2I start;      // start point of a ratsnest
-    VECTOR2I end;        // end point of a ratsnest
-    int     dx, dy;
+    double curr_cost = 0;
 
-    curr_cost = 0;
-
-    for( PAD* pad : aFootprint->Pads() )
+    for( const PAD_OFFSET& pad : aPads )
     {
-        const PAD* nearest = nearestPad( aFootprint, pad, aOffset );
+        auto it = m_anchorTrees.find( pad.m_netCode );
 
-        if( !nearest )
+        if( it == m_anchorTrees.end() )
             continue;
 
-        start   = VECTOR2I( pad->GetPosition() ) - VECTOR2I(aOffset);
-        end     = VECTOR2I( nearest->GetPosition() );
+        VECTOR2I start = aPos + pad.m_offset;   // start point of a ratsnest
+        VECTOR2I end;                            // end point of a ratsnest
 
-        //m_overlay->SetIsStroke( true );
-        //m_overlay->SetStrokeColor( COLOR4D(0.0, 1.0, 0.0, 1.0) );
-        //m_overlay->Line( start, end );
+        if( !it->second->Nearest( start, end ) )
+            continue;
 
         // Cost of the ratsnest.
-        dx  = end.x - start.x;
-        dy  = end.y - start.y;
-
-        dx  = abs( dx );
-        dy  = abs( dy );
+        int dx = std::abs( end.x - start.x );
+        int dy = std::abs( end.y - start.y );
 
         // ttry to have always dx >= dy to calculate the cost of the ratsnest
         if( dx < dy )
@@ -709,6 +590,104 @@ double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT* aFootprint, const
 }
 
 
+void AR_AUTOPLACER::refinePlacement( const std::vector<FOOTPRINT*>& aPlaced )
+{
+    if( aPlaced.empty() || m_refinementPasses <= 0 )
+        return;
+
+    // A fixed seed keeps the autoplacer results reproducible.
+    std::mt19937                           rng( 0x4b694361 );
+    std::uniform_real_distribution<double> unit( 0.0, 1.0 );
+
+    const BOX2I& boardBox = m_occupancy.GetBoardBox();
+    double       maxStep = std::max( boardBox.GetWidth(), boardBox.GetHeight() ) / 4.0;
+    double       temperature = -1.0;
+
+    std::vector<FOOTPRINT*> order = aPlaced;
+    std::vector<FOOTPRINT*> moved;
+
+    for( int pass = 0; pass < m_refinementPasses; pass++ )
+    {
+        // Linear shrinking of the move radius, from a quarter of the board to one grid step.
+        double progress = m_refinementPasses > 1 ? (double) pass / ( m_refinementPasses - 1 ) : 1.0;
+        int    radius = std::max( m_gridSize,
+                                  KiROUND( maxStep * ( 1.0 - progress ) / m_gridSize ) * m_gridSize );
+        std::uniform_int_distribution<int> step( -radius / m_gridSize, radius / m_gridSize );
+
+        std::shuffle( order.begin(), order.end(), rng );
+
+        for( FOOTPRINT* footprint : order )
+        {
+            auto obstacleIt = m_fpObstacles.find( footprint );
+
+            if( obstacleIt == m_fpObstacles.end() )
+                continue;
+
+            int               handle = obstacleIt->second;
+            VECTOR2I          fpPos = footprint->GetPosition();
+            const FP_SNAPSHOT snapshot = snapshotFootprint( footprint );
+
+            buildNetAnchorTrees( footprint );
+
+            double curKeepOut = testFootprintOnBoard( snapshot, fpPos, handle );
+
+            if( curKeepOut < 0 )
+                curKeepOut = 0;
+
+            double   curCost = computePlacementRatsnestCost( snapshot.m_pads, fpPos ) + curKeepOut;
+            VECTOR2I newPos = fpPos + VECTOR2I( step( rng ) * m_gridSize,
+                                                step( rng ) * m_gridSize );
+
+            if( newPos == fpPos )
+                continue;
+
+            double newKeepOut = testFootprintOnBoard( snapshot, newPos, handle );
+
+            if( newKeepOut < 0 )
+                continue;
+
+            double newCost = computePlacementRatsnestCost( snapshot.m_pads, newPos ) + newKeepOut;
+            double delta = newCost - curCost;
+
+            // The initial temperature accepts a typical uphill move with a 50% probability
+            if( temperature < 0 )
+                temperature = std::max( std::abs( delta ), 1.0 ) / std::log( 2.0 );
+
+            if( delta > 0 && unit( rng ) >= std::exp( -delta / temperature ) )
+                continue;
+
+            m_occupancy.RemoveObstacle( handle );
+            placeFootprint( footprint, true, newPos );
+            addFootprintObstacle( footprint );
+            moved.push_back( footprint );
+        }
+
+        if( temperature > 0 )
+            temperature *= 0.85;
+
+        // Show the result of the pass
+        if( !moved.empty() )
+        {
+            rebuildFreeAreas();
+            drawPlacementRoutingMatrix();
+
+            if( m_refreshCallback )
+            {
+                for( FOOTPRINT* footprint : moved )
+                    m_refreshCallback( footprint );
+            }
+
+            moved.clear();
+        }
+
+        if( m_progressReporter && !m_progressReporter->KeepRefreshing( false ) )
+            break;
+    }
+
+    m_anchorTrees.clear();
+}
+
+
 // Sort routines
 static bool sortFootprintsByComplexity( FOOTPRINT* ref, FOOTPRINT* compare )
 {
@@ -741,6 +720,10 @@ FOOTPRINT* AR_AUTOPLACER::pickFootprint()
 
     sort( fpList.begin(), fpList.end(), sortFootprintsByComplexity );
 
+    // Footprints are moved only by placeFootprint(), which keeps m_connectivity up to date,
+    // so only the ratsnest needs to be refreshed here.
+    m_connectivity->RecalculateRatsnest();
+
     for( unsigned kk = 0; kk < fpList.size(); kk++ )
     {
         FOOTPRINT* footprint = fpList[kk];
@@ -749,21 +732,12 @@ FOOTPRINT* AR_AUTOPLACER::pickFootprint()
         if( !footprint->NeedsPlaced() )
             continue;
 
-        m_connectivity->Update( footprint );
-    }
-
-    m_connectivity->RecalculateRatsnest();
-
-    for( unsigned kk = 0; kk < fpList.size(); kk++ )
-    {
-        FOOTPRINT* footprint = fpList[kk];
-
         auto edges = m_connectivity->GetRatsnestForComponent( footprint, true );
 
         footprint->SetFlag( edges.size() ) ;
     }
 
-    sort( fpList.begin(), fpList.end(), sortFootprintsByRatsnestSize );
+    std::stable_sort( fpList.begin(), fpList.end(), sortFootprintsByRatsnestSize );
 
     // Search for "best" footprint.
     FOOTPRINT* bestFootprint  = nullptr;
@@ -794,6 +768,9 @@ FOOTPRINT* AR_AUTOPLACER::pickFootprint()
 
 void AR_AUTOPLACER::drawPlacementRoutingMatrix( )
 {
+    if( !m_overlay )
+        return;
+
     // Draw the board free area
     m_overlay->Clear();
     m_overlay->SetIsFill( true );
@@ -833,11 +810,9 @@ AR_RESULT AR_AUTOPLACER::AutoplaceFootprints( std::vector<FOOTPRINT*>& aFootprin
 
     memopos = m_curPosition;
 
-    m_matrix.m_GridRouting = m_gridSize; //(int) m_frame->GetScreen()->GetGridSize().x;
-
-    // Ensure Board.m_GridRouting has a reasonable value:
-    if( m_matrix.m_GridRouting < pcbIUScale.mmToIU( 0.25 ) )
-        m_matrix.m_GridRouting = pcbIUScale.mmToIU( 0.25 );
+    // Ensure the grid has a reasonable value:
+    if( m_gridSize < pcbIUScale.mmToIU( 0.25 ) )
+        m_gridSize = pcbIUScale.mmToIU( 0.25 );
 
     // Compute footprint parameters used in autoplace
     if( genPlacementRoutingMatrix( ) == 0 )
@@ -854,7 +829,7 @@ AR_RESULT AR_AUTOPLACER::AutoplaceFootprints( std::vector<FOOTPRINT*>& aFootprin
     {
         for( FOOTPRINT* footprint : m_board->Footprints() )
         {
-            if( !m_matrix.m_BrdBox.Contains( footprint->GetPosition() ) )
+            if( !m_occupancy.GetBoardBox().Contains( footprint->GetPosition() ) )
                 offboardMods.push_back( footprint );
         }
     }
@@ -873,6 +848,8 @@ AR_RESULT AR_AUTOPLACER::AutoplaceFootprints( std::vector<FOOTPRINT*>& aFootprin
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
+        addPadAnchors( footprint );
+
         if( footprint->NeedsPlaced() )    // Erase from screen
             placedCount++;
         else
@@ -890,7 +867,8 @@ AR_RESULT AR_AUTOPLACER::AutoplaceFootprints( std::vector<FOOTPRINT*>& aFootprin
     if( m_refreshCallback )
         m_refreshCallback( nullptr );
 
-    FOOTPRINT* footprint;
+    FOOTPRINT*              footprint;
+    std::vector<FOOTPRINT*> placed;
 
     while( ( footprint = pickFootprint() ) != nullptr )
     {
@@ -911,6 +889,7 @@ AR_RESULT AR_AUTOPLACER::AutoplaceFootprints( std::vector<FOOTPRINT*>& aFootprin
         genModuleOnRoutingMatrix( footprint );
         footprint->SetIsPlaced( true );
         footprint->SetNeedsPlaced( false );
+        placed.push_back( footprint );
         drawPlacementRoutingMatrix();
 
         if( m_refreshCallback )
@@ -928,9 +907,22 @@ AR_RESULT AR_AUTOPLACER::AutoplaceFootprints( std::vector<FOOTPRINT*>& aFootprin
         }
     }
 
+    if( !cancelled && m_refinementPasses > 0 )
+    {
+        if( m_progressReporter )
+            m_progressReporter->Report( _( "Refining placement..." ) );
+
+        refinePlacement( placed );
+
+        if( m_refreshCallback )
+            m_refreshCallback( nullptr );
+    }
+
     m_curPosition = memopos;
 
-    m_matrix.UnInitRoutingMatrix();
+    m_occupancy.Clear();
+    m_fpObstacles.clear();
+    m_netAnchors.clear();
 
     return cancelled ? AR_CANCELLED : AR_COMPLETED;
 }
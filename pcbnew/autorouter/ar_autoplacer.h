@@ -29,12 +29,16 @@
 #ifndef __AR_AUTOPLACER_H
 #define __AR_AUTOPLACER_H
 
-#include "ar_matrix.h"
+#include "ar_occupancy.h"
 
 #include <board.h>
 #include <footprint.h>
 #include <lset.h>
 
+#include <map>
+#include <memory>
+#include <unordered_map>
+
 #include <connectivity/connectivity_data.h>
 
 #include <view/view_overlay.h>
@@ -54,6 +58,7 @@ enum AR_RESULT
 };
 
 class PROGRESS_REPORTER;
+class AR_NET_ANCHOR_TREE;
 
 class AR_AUTOPLACER
 {
@@ -84,23 +89,110 @@ public:
         m_progressReporter = aReporter;
     }
 
-private:
-    void drawPlacementRoutingMatrix();  // draw the working area (shows free and occupied areas)
+    /**
+     * Set the number of simulated annealing passes run over the newly placed footprints
+     * once they all have an initial position.  0 disables the refinement.
+     */
+    void SetRefinementPasses( int aPasses )
+    {
+        m_refinementPasses = aPasses;
+    }
+
+protected:
+    struct PAD_OFFSET
+    {
+        VECTOR2I m_offset;     ///< Pad position relative to the footprint position
+        int      m_netCode;
+    };
+
+    /**
+     * What testFootprintOnBoard() and computePlacementRatsnestCost() need to know about a
+     * footprint, copied from the board item before the candidate positions are evaluated by
+     * the worker threads.
+     */
+    struct FP_SNAPSHOT
+    {
+        BOX2I                   m_relBBox;       ///< Relative to the footprint position
+        int                     m_side;
+        bool                    m_testOtherSide; ///< The footprint has pads on the other side
+        int                     m_keepOutMargin;
+        std::vector<PAD_OFFSET> m_pads;
+    };
+
     int genPlacementRoutingMatrix();
 
+    FP_SNAPSHOT snapshotFootprint( FOOTPRINT* aFootprint ) const;
+
     /**
-     * Fill m_matrix cells from m_boardShape.
+     * Test a candidate position for a footprint.  Only reads \a aFootprint and the occupancy
+     * map, so it can be called from several threads.
      *
-     * Cells inside m_boardShape are set to CELL_IS_ZONE.
+     * @return the keep out cost (>= 0) if the footprint can be placed at \a aPos, or a
+     *         negative AR_CELL_STATE value otherwise.
+     */
+    double testFootprintOnBoard( const FP_SNAPSHOT& aFootprint, const VECTOR2I& aPos,
+                                 int aIgnore = -1 ) const;
+
+    /**
+     * Build the k-d trees of the pads sharing a net with \a aFootprint, excluding its own pads.
+     */
+    void buildNetAnchorTrees( FOOTPRINT* aFootprint );
+
+    double computePlacementRatsnestCost( const std::vector<PAD_OFFSET>& aPads,
+                                         const VECTOR2I& aPos ) const;
+
+    void addPadAnchors( FOOTPRINT* aFootprint );
+
+private:
+    struct PAD_ANCHOR
+    {
+        VECTOR2I         m_pos;
+        const FOOTPRINT* m_parent;
+    };
+
+    void drawPlacementRoutingMatrix();  // draw the working area (shows free and occupied areas)
+
+    /**
+     * Rebuild the free area polygons from the current footprint positions, after footprints
+     * were moved.  Only needed when an overlay is used.
+     */
+    void rebuildFreeAreas();
+
+    /**
+     * Add \a aFootprint to the occupancy map and remember the obstacle handle in
+     * m_fpObstacles.
+     */
+    void addFootprintObstacle( FOOTPRINT* aFootprint );
+
+    /**
+     * Add \a aFootprint to the occupancy map, and to the free area polygons if an overlay
+     * is used.
      */
-    bool fillMatrix();
     void genModuleOnRoutingMatrix( FOOTPRINT* aFootprint );
 
-    int testRectangle( const BOX2I& aRect, int side );
-    unsigned int calculateKeepOutArea( const  BOX2I& aRect, int side );
-    int testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSide, const VECTOR2I& aOffset );
+    /**
+     * @return the occupancy map obstacle box of \a aFootprint placed at \a aPos.
+     */
+    BOX2I footprintObstacleBox( FOOTPRINT* aFootprint, const VECTOR2I& aPos ) const;
+
+    int footprintSide( FOOTPRINT* aFootprint ) const;
+    bool hasPadsOnOtherSide( FOOTPRINT* aFootprint ) const;
+
+    /**
+     * Evaluate all the grid positions of the board for \a aFootprint, in parallel, and store
+     * the best one in m_curPosition.
+     *
+     * @return 0 if a position was found, 1 if the footprint cannot be placed anywhere.
+     */
     int getOptimalFPPlacement( FOOTPRINT* aFootprint );
-    double computePlacementRatsnestCost( FOOTPRINT* aFootprint, const VECTOR2I& aOffset );
+
+    void removePadAnchors( FOOTPRINT* aFootprint );
+
+    /**
+     * Try to improve the placement of the footprints placed by this session with random
+     * moves accepted by a simulated annealing schedule.
+     */
+    void refinePlacement( const std::vector<FOOTPRINT*>& aPlaced );
 
     /**
      * Find the "best" footprint place. The criteria are:
@@ -111,7 +203,9 @@ private:
 
     void placeFootprint( FOOTPRINT* aFootprint, bool aDoNotRecreateRatsnest, const VECTOR2I& aPos );
 
-    const PAD* nearestPad( FOOTPRINT* aRefFP, PAD* aRefPad, const VECTOR2I& aOffset );
+    // Build m_fpAreaTop and m_fpAreaBottom polygonal shapes for aFootprint.
+    // aFpClearance is a mechanical clearance.
+    void buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance );
 
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
     void addFpBody( const VECTOR2I& aStart, const VECTOR2I& aEnd, const LSET& aLayerMask );
@@ -119,11 +213,7 @@ private:
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
     void addPad( PAD* aPad, int aClearance );
 
-    // Build m_fpAreaTop and m_fpAreaBottom polygonal shapes for aFootprint.
-    // aFpClearance is a mechanical clearance.
-    void buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance );
-
-    AR_MATRIX m_matrix;
+    AR_OCCUPANCY_MAP m_occupancy;
     SHAPE_POLY_SET m_topFreeArea;       // The polygonal description of the top side free areas;
     SHAPE_POLY_SET m_bottomFreeArea;    // The polygonal description of the bottom side free areas;
     SHAPE_POLY_SET m_boardShape;        // The polygonal description of the board;
@@ -137,6 +227,11 @@ private:
     VECTOR2I m_curPosition;
     double   m_minCost;
     int      m_gridSize;
+    int      m_refinementPasses;
+
+    std::map<FOOTPRINT*, int>                           m_fpObstacles;
+    std::unordered_map<int, std::vector<PAD_ANCHOR>>    m_netAnchors;
+    std::map<int, std::shared_ptr<AR_NET_ANCHOR_TREE>>  m_anchorTrees;
 
     std::shared_ptr<KIGFX::VIEW_OVERLAY>        m_overlay;
     std::unique_ptr<CONNECTIVITY_DATA>          m_connectivity;
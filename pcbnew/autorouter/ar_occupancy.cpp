@@ -0,0 +1,218 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "ar_occupancy.h"
+
+
+AR_OCCUPANCY_MAP::AR_OCCUPANCY_MAP()
+{
+}
+
+
+AR_OCCUPANCY_MAP::~AR_OCCUPANCY_MAP()
+{
+}
+
+
+void AR_OCCUPANCY_MAP::Clear()
+{
+    m_boardBox = BOX2I();
+    m_boardShape.RemoveAllContours();
+    m_boardEdges.clear();
+    m_edgeIndex.RemoveAll();
+    m_obstacles.clear();
+
+    for( int side = 0; side < AR_SIDE_COUNT; side++ )
+    {
+        m_obstacleIndex[side].RemoveAll();
+        m_keepOutIndex[side].RemoveAll();
+    }
+}
+
+
+void AR_OCCUPANCY_MAP::SetBoardShape( const SHAPE_POLY_SET& aBoardShape )
+{
+    m_boardShape = aBoardShape.CloneDropTriangulation();
+    m_boardBox = m_boardShape.BBox();
+    m_boardEdges.clear();
+    m_edgeIndex.RemoveAll();
+
+    for( auto it = m_boardShape.CIterateSegmentsWithHoles(); it; it++ )
+    {
+        const SEG seg = *it;
+        const int min[2] = { std::min( seg.A.x, seg.B.x ), std::min( seg.A.y, seg.B.y ) };
+        const int max[2] = { std::max( seg.A.x, seg.B.x ), std::max( seg.A.y, seg.B.y ) };
+
+        m_edgeIndex.Insert( min, max, (intptr_t) m_boardEdges.size() );
+        m_boardEdges.push_back( seg );
+    }
+}
+
+
+int AR_OCCUPANCY_MAP::AddObstacle( const BOX2I& aBox, int aSides, int aKeepOutMargin,
+                                   int aKeepOutCost )
+{
+    OBSTACLE obstacle;
+
+    obstacle.m_box = aBox;
+    obstacle.m_box.Normalize();
+    obstacle.m_keepOutBox = obstacle.m_box;
+    obstacle.m_keepOutBox.Inflate( std::max( aKeepOutMargin, 0 ) );
+    obstacle.m_sides = aSides;
+    obstacle.m_keepOutCost = aKeepOutMargin > 0 ? aKeepOutCost : 0;
+    obstacle.m_valid = true;
+
+    m_obstacles.push_back( obstacle );
+
+    int handle = (int) m_obstacles.size() - 1;
+    insert( handle );
+
+    return handle;
+}
+
+
+void AR_OCCUPANCY_MAP::insert( int aHandle )
+{
+    const OBSTACLE& obstacle = m_obstacles[aHandle];
+
+    const int min[2] = { obstacle.m_box.GetLeft(), obstacle.m_box.GetTop() };
+    const int max[2] = { obstacle.m_box.GetRight(), obstacle.m_box.GetBottom() };
+    const int kmin[2] = { obstacle.m_keepOutBox.GetLeft(), obstacle.m_keepOutBox.GetTop() };
+    const int kmax[2] = { obstacle.m_keepOutBox.GetRight(), obstacle.m_keepOutBox.GetBottom() };
+
+    for( int side = 0; side < AR_SIDE_COUNT; side++ )
+    {
+        if( !( obstacle.m_sides & ( 1 << side ) ) )
+            continue;
+
+        m_obstacleIndex[side].Insert( min, max, aHandle );
+
+        if( obstacle.m_keepOutCost > 0 )
+            m_keepOutIndex[side].Insert( kmin, kmax, aHandle );
+    }
+}
+
+
+void AR_OCCUPANCY_MAP::RemoveObstacle( int aHandle )
+{
+    if( aHandle < 0 || aHandle >= (int) m_obstacles.size() || !m_obstacles[aHandle].m_valid )
+        return;
+
+    OBSTACLE& obstacle = m_obstacles[aHandle];
+
+    const int min[2] = { obstacle.m_box.GetLeft(), obstacle.m_box.GetTop() };
+    const int max[2] = { obstacle.m_box.GetRight(), obstacle.m_box.GetBottom() };
+    const int kmin[2] = { obstacle.m_keepOutBox.GetLeft(), obstacle.m_keepOutBox.GetTop() };
+    const int kmax[2] = { obstacle.m_keepOutBox.GetRight(), obstacle.m_keepOutBox.GetBottom() };
+
+    for( int side = 0; side < AR_SIDE_COUNT; side++ )
+    {
+        if( !( obstacle.m_sides & ( 1 << side ) ) )
+            continue;
+
+        m_obstacleIndex[side].Remove( min, max, aHandle );
+
+        if( obstacle.m_keepOutCost > 0 )
+            m_keepOutIndex[side].Remove( kmin, kmax, aHandle );
+    }
+
+    obstacle.m_valid = false;
+}
+
+
+bool AR_OCCUPANCY_MAP::IsInsideBoard( const BOX2I& aBox ) const
+{
+    if( m_boardEdges.empty() || !m_boardBox.Contains( aBox ) )
+        return false;
+
+    // If no board edge crosses the rectangle, it is either fully inside or fully outside the
+    // board (holes included), so testing a single point is enough.
+    const int min[2] = { aBox.GetLeft(), aBox.GetTop() };
+    const int max[2] = { aBox.GetRight(), aBox.GetBottom() };
+    bool      crossed = false;
+
+    m_edgeIndex.Search( min, max,
+            [&]( const intptr_t& aIdx ) -> bool
+            {
+                const SEG& seg = m_boardEdges[aIdx];
+
+                if( aBox.Intersects( seg.A, seg.B ) )
+                {
+                    crossed = true;
+                    return false;
+                }
+
+                return true;
+            } );
+
+    if( crossed )
+        return false;
+
+    return m_boardShape.Contains( aBox.GetCenter() );
+}
+
+
+bool AR_OCCUPANCY_MAP::IsFree( const BOX2I& aBox, int aSide, int aIgnore ) const
+{
+    const int min[2] = { aBox.GetLeft(), aBox.GetTop() };
+    const int max[2] = { aBox.GetRight(), aBox.GetBottom() };
+    bool      free = true;
+
+    m_obstacleIndex[aSide].Search( min, max,
+            [&]( const intptr_t& aHandle ) -> bool
+            {
+                if( aHandle == aIgnore )
+                    return true;
+
+                free = false;
+                return false;
+            } );
+
+    return free;
+}
+
+
+double AR_OCCUPANCY_MAP::KeepOutCost( const BOX2I& aBox, int aSide, int aGridSize,
+                                      int aIgnore ) const
+{
+    const int    min[2] = { aBox.GetLeft(), aBox.GetTop() };
+    const int    max[2] = { aBox.GetRight(), aBox.GetBottom() };
+    const double cellArea = std::max( (double) aGridSize * aGridSize, 1.0 );
+    double       cost = 0.0;
+
+    m_keepOutIndex[aSide].Search( min, max,
+            [&]( const intptr_t& aHandle ) -> bool
+            {
+                if( aHandle == aIgnore )
+                    return true;
+
+                const OBSTACLE& obstacle = m_obstacles[aHandle];
+                BOX2I           overlap = obstacle.m_keepOutBox;
+
+                overlap = overlap.Intersect( aBox );
+                cost += obstacle.m_keepOutCost * ( (double) overlap.GetArea() / cellArea );
+                return true;
+            } );
+
+    return cost;
+}
@@ -0,0 +1,120 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __AR_OCCUPANCY_H
+#define __AR_OCCUPANCY_H
+
+#include <cstdint>
+#include <vector>
+
+#include <geometry/rtree.h>
+#include <geometry/seg.h>
+#include <geometry/shape_poly_set.h>
+#include <math/box2.h>
+
+#define AR_SIDE_TOP 0
+#define AR_SIDE_BOTTOM 1
+#define AR_SIDE_COUNT 2
+
+
+/**
+ * Spatially indexed occupancy model of a board, used by the autoplacer.
+ *
+ * Each board side holds a set of obstacles (placed footprints, graphic items) in an R-tree,
+ * each one optionally surrounded by a keep-out halo which makes nearby placements more
+ * expensive.  The board outline edges are indexed as well, so testing whether a candidate
+ * rectangle lies inside the board only visits the edges near that rectangle.
+ *
+ * All query methods are const and may be called concurrently from several threads, as long
+ * as no obstacle is added or removed at the same time.
+ */
+class AR_OCCUPANCY_MAP
+{
+public:
+    AR_OCCUPANCY_MAP();
+    ~AR_OCCUPANCY_MAP();
+
+    void Clear();
+
+    /**
+     * Set the keep-in area.  Candidate rectangles must be fully inside \a aBoardShape.
+     */
+    void SetBoardShape( const SHAPE_POLY_SET& aBoardShape );
+
+    const BOX2I& GetBoardBox() const { return m_boardBox; }
+
+    /**
+     * Add an obstacle to the given sides.
+     *
+     * @param aBox is the area which cannot be used by another footprint.
+     * @param aSides is a mask of ( 1 << AR_SIDE_xxx ) bits.
+     * @param aKeepOutMargin is the width of the halo around \a aBox.
+     * @param aKeepOutCost is the cost of one grid cell of the halo overlapped by a candidate.
+     * @return a handle which can be passed to RemoveObstacle() or used as an ignored obstacle.
+     */
+    int AddObstacle( const BOX2I& aBox, int aSides, int aKeepOutMargin = 0, int aKeepOutCost = 0 );
+
+    void RemoveObstacle( int aHandle );
+
+    /**
+     * @return true if \a aBox is fully inside the board shape.
+     */
+    bool IsInsideBoard( const BOX2I& aBox ) const;
+
+    /**
+     * @return true if \a aBox does not overlap any obstacle on \a aSide (other than
+     *         \a aIgnore).
+     */
+    bool IsFree( const BOX2I& aBox, int aSide, int aIgnore = -1 ) const;
+
+    /**
+     * @return the sum of the keep-out costs of the halos overlapped by \a aBox on \a aSide,
+     *         expressed in grid cells of \a aGridSize.
+     */
+    double KeepOutCost( const BOX2I& aBox, int aSide, int aGridSize, int aIgnore = -1 ) const;
+
+private:
+    typedef RTree<intptr_t, int, 2, double> INDEX;
+
+    struct OBSTACLE
+    {
+        BOX2I m_box;
+        BOX2I m_keepOutBox;
+        int   m_sides;
+        int   m_keepOutCost;
+        bool  m_valid;
+    };
+
+    void insert( int aHandle );
+
+    BOX2I                 m_boardBox;
+    SHAPE_POLY_SET        m_boardShape;
+    std::vector<SEG>      m_boardEdges;
+    INDEX                 m_edgeIndex;
+
+    std::vector<OBSTACLE> m_obstacles;
+    INDEX                 m_obstacleIndex[AR_SIDE_COUNT];  ///< Indexed by obstacle box
+    INDEX                 m_keepOutIndex[AR_SIDE_COUNT];   ///< Indexed by keep-out halo box
+};
+
+#endif
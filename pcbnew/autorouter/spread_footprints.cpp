@@ -43,6 +43,7 @@
 #include <pcb_edit_frame.h>
 #include <board.h>
 #include <rectpack2d/finders_interface.h>
+#include <thread_pool.h>
 
 
 constexpr bool allow_flip = true;
@@ -56,24 +57,26 @@ using rect_vector = std::vector<rect_type>;
 const int scale = (int) ( 0.01 * pcbIUScale.IU_PER_MM );
 
 
-static bool compareFootprintsbyRef( FOOTPRINT* ref, FOOTPRINT* compare )
+/**
+ * A footprint to spread, reduced to the data needed by the packing: the placement is computed
+ * on the cached bounding boxes only and applied to the footprints once at the end.
+ */
+struct SPREAD_ITEM
 {
-    const wxString& refPrefix = UTIL::GetRefDesPrefix( ref->GetReference() );
-    const wxString& cmpPrefix = UTIL::GetRefDesPrefix( compare->GetReference() );
+    FOOTPRINT* m_footprint;
+    BOX2I      m_bbox;          ///< Bounding box (text excluded) before spreading
+    wxString   m_refPrefix;
+    int        m_refNumber;
+    VECTOR2I   m_offset;        ///< Accumulated displacement
+};
 
-    if( refPrefix != cmpPrefix )
-    {
-        return refPrefix < cmpPrefix;
-    }
-    else
-    {
-        const int refInt = GetTrailingInt( ref->GetReference() );
-        const int cmpInt = GetTrailingInt( compare->GetReference() );
 
-        return refInt < cmpInt;
-    }
+static bool compareItemsByRef( const SPREAD_ITEM* ref, const SPREAD_ITEM* compare )
+{
+    if( ref->m_refPrefix != compare->m_refPrefix )
+        return ref->m_refPrefix < compare->m_refPrefix;
 
-    return false;
+    return ref->m_refNumber < compare->m_refNumber;
 }
 
 
@@ -125,23 +128,41 @@ std::optional<rectpack2D::rect_wh> spreadRectangles( rect_vector& vecSubRects, i
 void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBoxPosition,
                        bool aGroupBySheet, int aComponentGap, int aGroupGap )
 {
-    using FpBBoxToFootprintsPair = std::pair<BOX2I, std::vector<FOOTPRINT*>>;
-    using SheetBBoxToFootprintsMapPair =
-            std::pair<BOX2I, std::map<VECTOR2I, FpBBoxToFootprintsPair>>;
+    using FpBBoxToItemsPair = std::pair<BOX2I, std::vector<SPREAD_ITEM*>>;
+    using SheetBBoxToItemsMapPair = std::pair<BOX2I, std::map<VECTOR2I, FpBBoxToItemsPair>>;
 
-    std::map<wxString, SheetBBoxToFootprintsMapPair> sheetsMap;
+    std::vector<SPREAD_ITEM> items( aFootprints->size() );
+
+    // Bounding boxes are by far the most expensive part of the spread, and each footprint only
+    // touches its own cache, so compute them (and the sort keys) in parallel.
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( 0, items.size(),
+            [&]( const int ii )
+            {
+                SPREAD_ITEM& item = items[ii];
+                FOOTPRINT*   footprint = ( *aFootprints )[ii];
+
+                item.m_footprint = footprint;
+                item.m_bbox = footprint->GetBoundingBox( false );
+                item.m_refPrefix = UTIL::GetRefDesPrefix( footprint->GetReference() );
+                item.m_refNumber = GetTrailingInt( footprint->GetReference() );
+            } )
+            .wait();
+
+    std::map<wxString, SheetBBoxToItemsMapPair> sheetsMap;
 
     // Fill in the maps
-    for( FOOTPRINT* footprint : *aFootprints )
+    for( SPREAD_ITEM& item : items )
     {
-        wxString path =
-                aGroupBySheet ? footprint->GetPath().AsString().BeforeLast( '/' ) : wxString( wxS( "" ) );
+        wxString path = aGroupBySheet ? item.m_footprint->GetPath().AsString().BeforeLast( '/' )
+                                      : wxString( wxS( "" ) );
 
-        VECTOR2I size = footprint->GetBoundingBox( false ).GetSize();
+        VECTOR2I size = item.m_bbox.GetSize();
         size.x += aComponentGap;
         size.y += aComponentGap;
 
-        sheetsMap[path].second[size].second.push_back( footprint );
+        sheetsMap[path].second[size].second.push_back( &item );
     }
 
     for( auto& [sheetPath, sheetPair] : sheetsMap )
@@ -150,39 +171,39 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
 
         for( auto& [fpSize, fpPair] : sizeToFpMap )
         {
-            auto& [block_bbox, footprints] = fpPair;
+            auto& [block_bbox, blockItems] = fpPair;
 
             // Find optimal arrangement of same-size footprints
 
-            double blockEstimateArea = (double) fpSize.x * fpSize.y * footprints.size();
+            double blockEstimateArea = (double) fpSize.x * fpSize.y * blockItems.size();
             double initialSide = std::sqrt( blockEstimateArea );
             bool   vertical = fpSize.x >= fpSize.y;
 
-            int initialCountPerLine = footprints.size();
+            int initialCountPerLine = blockItems.size();
 
             const int singleLineRatio = 5;
 
             // Wrap the line if the ratio is not satisfied
             if( vertical )
             {
-                if( ( fpSize.y * footprints.size() / fpSize.x ) > singleLineRatio )
+                if( ( fpSize.y * blockItems.size() / fpSize.x ) > singleLineRatio )
                     initialCountPerLine = initialSide / fpSize.y;
             }
             else
             {
-                if( ( fpSize.x * footprints.size() / fpSize.y ) > singleLineRatio )
+                if( ( fpSize.x * blockItems.size() / fpSize.y ) > singleLineRatio )
                     initialCountPerLine = initialSide / fpSize.x;
             }
 
             int optimalCountPerLine = initialCountPerLine;
-            int optimalRemainder = footprints.size() % optimalCountPerLine;
+            int optimalRemainder = blockItems.size() % optimalCountPerLine;
 
             if( optimalRemainder != 0 )
             {
                 for( int i = std::max( 2, initialCountPerLine - 2 );
-                     i <= std::min( (int) footprints.size() - 2, initialCountPerLine + 2 ); i++ )
+                     i <= std::min( (int) blockItems.size() - 2, initialCountPerLine + 2 ); i++ )
                 {
-                    int r = footprints.size() % i;
+                    int r = blockItems.size() % i;
 
                     if( r == 0 || r >= optimalRemainder )
                     {
@@ -192,12 +213,12 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
                 }
             }
 
-            std::sort( footprints.begin(), footprints.end(), compareFootprintsbyRef );
+            std::sort( blockItems.begin(), blockItems.end(), compareItemsByRef );
 
             // Arrange footprints in rows or columns (blocks)
-            for( unsigned i = 0; i < footprints.size(); i++ )
+            for( unsigned i = 0; i < blockItems.size(); i++ )
             {
-                FOOTPRINT* footprint = footprints[i];
+                SPREAD_ITEM* item = blockItems[i];
 
                 VECTOR2I position = fpSize / 2;
 
@@ -212,10 +233,10 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
                     position.y += fpSize.y * ( i / optimalCountPerLine );
                 }
 
-                BOX2I old_fp_bbox = footprint->GetBoundingBox( false );
-                footprint->Move( position - old_fp_bbox.GetOrigin() );
+                item->m_offset = position - item->m_bbox.GetOrigin();
 
-                BOX2I new_fp_bbox = footprint->GetBoundingBox( false );
+                BOX2I new_fp_bbox = item->m_bbox;
+                new_fp_bbox.Move( item->m_offset );
                 new_fp_bbox.Inflate( aComponentGap / 2 );
                 block_bbox.Merge( new_fp_bbox );
             }
@@ -227,7 +248,7 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
         // Fill in arrays for packing of blocks
         for( auto& [fpSize, fpPair] : sizeToFpMap )
         {
-            auto& [block_bbox, footprints] = fpPair;
+            auto& [block_bbox, blockItems] = fpPair;
 
             vecSubRects.emplace_back( 0, 0, block_bbox.GetWidth() / scale,
                                       block_bbox.GetHeight() / scale, false );
@@ -244,7 +265,7 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
         // Move footprints to the new block locations
         for( auto& [fpSize, pair] : sizeToFpMap )
         {
-            auto& [src_bbox, footprints] = pair;
+            auto& [src_bbox, blockItems] = pair;
 
             rect_type srect = vecSubRects[block_i];
 
@@ -259,10 +280,13 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
             if( (uint64_t) target_pos.y + (uint64_t) target_size.y > INT_MAX / 2 )
                 target_pos.y -= INT_MAX / 2;
 
-            for( FOOTPRINT* footprint : footprints )
+            for( SPREAD_ITEM* item : blockItems )
             {
-                footprint->Move( target_pos - src_bbox.GetPosition() );
-                sheet_bbox.Merge( footprint->GetBoundingBox( false ) );
+                item->m_offset += target_pos - src_bbox.GetPosition();
+
+                BOX2I new_fp_bbox = item->m_bbox;
+                new_fp_bbox.Move( item->m_offset );
+                sheet_bbox.Merge( new_fp_bbox );
             }
 
             block_i++;
@@ -292,7 +316,7 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
 
     unsigned srect_i = 0;
 
-    // Move footprints to the new hierarchical sheet group locations
+    // Offset footprints to the new hierarchical sheet group locations
     for( auto& [sheetPath, sheetPair] : sheetsMap )
     {
         auto& [src_bbox, sizeToFpMap] = sheetPair;
@@ -313,13 +337,16 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
 
         for( auto& [fpSize, fpPair] : sizeToFpMap )
         {
-            auto& [block_bbox, footprints] = fpPair;
-            for( FOOTPRINT* footprint : footprints )
-            {
-                footprint->Move( target_pos - src_bbox.GetPosition() );
-            }
+            auto& [block_bbox, blockItems] = fpPair;
+
+            for( SPREAD_ITEM* item : blockItems )
+                item->m_offset += target_pos - src_bbox.GetPosition();
         }
 
         srect_i++;
     }
+
+    // Each footprint is moved exactly once, to its final location
+    for( SPREAD_ITEM& item : items )
+        item.m_footprint->Move( item.m_offset );
 }
@@ -103,6 +103,7 @@ BOARD::BOARD() :
     // A too large value do not allow safely connecting 2 shapes like very short segments.
     m_outlinesChainingEpsilon = pcbIUScale.mmToIU( DEFAULT_CHAINING_EPSILON_MM );
 
+    m_CopperItemRTreeClearance = 0;
     m_DRCMaxClearance = 0;
     m_DRCMaxPhysicalClearance = 0;
     m_boardOutline = new PCB_BOARD_OUTLINE( this );
@@ -265,7 +266,7 @@ void BOARD::IncrementTimeStamp()
 
     if( !m_IntersectsAreaCache.empty() || !m_EnclosedByAreaCache.empty() || !m_IntersectsCourtyardCache.empty()
         || !m_IntersectsFCourtyardCache.empty() || !m_IntersectsBCourtyardCache.empty()
-        || !m_LayerExpressionCache.empty() || !m_ZoneBBoxCache.empty() || m_CopperItemRTreeCache
+        || !m_LayerExpressionCache.empty() || !m_ZoneBBoxCache.empty() || !m_ZoneFillHitTestCache.empty()
         || m_maxClearanceValue.has_value() || !m_itemByIdCache.empty() || !m_ItemNetclassCache.empty() )
     {
         m_IntersectsAreaCache.clear();
@@ -277,8 +278,9 @@ void BOARD::IncrementTimeStamp()
         m_ItemNetclassCache.clear();
 
         m_ZoneBBoxCache.clear();
+        m_ZoneFillHitTestCache.clear();
 
-        m_CopperItemRTreeCache = nullptr;
+        // m_CopperItemRTreeCache is not cleared: it is updated incrementally by the next DRC run.
 
         // These are always regenerated before use, but still probably safer to clear them
         // while we're here.
@@ -1228,6 +1230,10 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectivity
 
     m_itemByIdCache.insert( { aBoardItem->m_Uuid, aBoardItem } );
 
+    // The item may reuse the address of an item deleted since the last DRC run
+    markCopperItemRTreeDirty( { aBoardItem } );
+    invalidateOutlineCache( { aBoardItem } );
+
     switch( aBoardItem->Type() )
     {
     case PCB_NETINFO_T: m_NetInfo.AppendNet( (NETINFO_ITEM*) aBoardItem ); break;
@@ -1383,6 +1389,7 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
     wxASSERT( aBoardItem );
 
     m_itemByIdCache.erase( aBoardItem->m_Uuid );
+    invalidateOutlineCache( { aBoardItem } );
 
     switch( aBoardItem->Type() )
     {
@@ -1554,6 +1561,7 @@ void BOARD::RemoveAll( std::initializer_list<KICAD_T> aTypes )
         }
     }
 
+    invalidateOutlineCache( removed );
     IncrementTimeStamp();
 
     FinalizeBulkRemove( removed );
@@ -3030,14 +3038,132 @@ ZONE* BOARD::AddArea( PICKED_ITEMS_LIST* aNewZonesList, int aNetcode, PCB_LAYER_
 }
 
 
+/**
+ * @return true if \a aFootprint has shapes on Edge.Cuts or NPTH pads, which can both be part of
+ *         the board outlines.
+ */
+static bool footprintAffectsOutline( const FOOTPRINT* aFootprint )
+{
+    for( const BOARD_ITEM* item : aFootprint->GraphicalItems() )
+    {
+        if( item->Type() == PCB_SHAPE_T && item->GetLayer() == Edge_Cuts )
+            return true;
+    }
+
+    for( const PAD* pad : aFootprint->Pads() )
+    {
+        if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
+            return true;
+    }
+
+    return false;
+}
+
+
+bool BOARD::isOutlineItem( const BOARD_ITEM* aItem ) const
+{
+    if( m_outlineCacheItems.count( aItem ) || m_outlineCacheItems.count( aItem->GetParentFootprint() ) )
+        return true;
+
+    switch( aItem->Type() )
+    {
+    case PCB_FOOTPRINT_T: return footprintAffectsOutline( static_cast<const FOOTPRINT*>( aItem ) );
+    case PCB_PAD_T:       return static_cast<const PAD*>( aItem )->GetAttribute() == PAD_ATTRIB::NPTH;
+    case PCB_SHAPE_T:     return aItem->GetLayer() == Edge_Cuts;
+    default:              return false;
+    }
+}
+
+
+void BOARD::invalidateOutlineCache( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::lock_guard<std::mutex> lock( m_outlineCacheMutex );
+
+    if( m_outlineCache.empty() || aItems.empty() )
+        return;
+
+    for( const BOARD_ITEM* item : aItems )
+    {
+        if( isOutlineItem( item ) )
+        {
+            m_outlineCache.clear();
+            m_outlineCacheItems.clear();
+            return;
+        }
+    }
+
+    // Any other item can still move the board bounding box used for inferred outlines
+    std::erase_if( m_outlineCache,
+                   []( const OUTLINE_CACHE_ENTRY& aEntry )
+                   {
+                       return aEntry.m_inferred;
+                   } );
+}
+
+
+void BOARD::invalidateOutlineCacheForRemoved( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::lock_guard<std::mutex> lock( m_outlineCacheMutex );
+
+    if( m_outlineCache.empty() || aItems.empty() )
+        return;
+
+    // The items may already be deleted (e.g. a reverted addition), so only their addresses
+    // are used.  Remove() has invalidated the cache for them while they were alive anyway.
+    for( const BOARD_ITEM* item : aItems )
+    {
+        if( m_outlineCacheItems.count( item ) )
+        {
+            m_outlineCache.clear();
+            m_outlineCacheItems.clear();
+            return;
+        }
+    }
+
+    std::erase_if( m_outlineCache,
+                   []( const OUTLINE_CACHE_ENTRY& aEntry )
+                   {
+                       return aEntry.m_inferred;
+                   } );
+}
+
+
 bool BOARD::GetBoardPolygonOutlines( SHAPE_POLY_SET& aOutlines, bool aInferOutlineIfNecessary,
                                      OUTLINE_ERROR_HANDLER* aErrorHandler, bool aAllowUseArcsInPolygons,
                                      bool aIncludeNPTHAsOutlines )
 {
     // max dist from one endPt to next startPt: use the current value
     int chainingEpsilon = GetOutlinesChainingEpsilon();
+    int maxError = GetDesignSettings().m_MaxError;
 
-    bool success = BuildBoardPolygonOutlines( this, aOutlines, GetDesignSettings().m_MaxError, chainingEpsilon,
+    // The outlines are kept until an item which can change them is added, removed or modified
+    // (see invalidateOutlineCache()).  An error handler always gets a fresh build, so that the
+    // errors are reported again.
+    std::lock_guard<std::mutex> lock( m_outlineCacheMutex );
+
+    auto matches =
+            [&]( const OUTLINE_CACHE_ENTRY& aEntry )
+            {
+                return aEntry.m_inferOutline == aInferOutlineIfNecessary
+                       && aEntry.m_allowArcs == aAllowUseArcsInPolygons
+                       && aEntry.m_includeNPTH == aIncludeNPTHAsOutlines
+                       && aEntry.m_maxError == maxError
+                       && aEntry.m_chainingEpsilon == chainingEpsilon;
+            };
+
+    if( !aErrorHandler )
+    {
+        for( const OUTLINE_CACHE_ENTRY& entry : m_outlineCache )
+        {
+            if( matches( entry ) )
+            {
+                aOutlines = *entry.m_outlines;
+                return entry.m_success;
+            }
+        }
+    }
+
+    bool success = BuildBoardPolygonOutlines( this, aOutlines, maxError, chainingEpsilon,
                                               aInferOutlineIfNecessary, aErrorHandler, aAllowUseArcsInPolygons );
 
     // Now add NPTH oval holes as holes in outlines if required
@@ -3077,6 +3203,38 @@ bool BOARD::GetBoardPolygonOutlines( SHAPE_POLY_SET& aOutlines, bool aInferOutli
     // Make polygon strictly simple to avoid issues (especially in 3D viewer)
     aOutlines.Simplify();
 
+    bool hasBoardEdges = false;
+
+    m_outlineCacheItems.clear();
+
+    for( BOARD_ITEM* item : Drawings() )
+    {
+        if( item->Type() == PCB_SHAPE_T && item->GetLayer() == Edge_Cuts )
+        {
+            m_outlineCacheItems.insert( item );
+            hasBoardEdges = true;
+        }
+    }
+
+    for( FOOTPRINT* fp : Footprints() )
+    {
+        if( footprintAffectsOutline( fp ) )
+            m_outlineCacheItems.insert( fp );
+    }
+
+    std::erase_if( m_outlineCache, matches );
+
+    OUTLINE_CACHE_ENTRY& entry = m_outlineCache.emplace_back();
+
+    entry.m_inferOutline = aInferOutlineIfNecessary;
+    entry.m_allowArcs = aAllowUseArcsInPolygons;
+    entry.m_includeNPTH = aIncludeNPTHAsOutlines;
+    entry.m_maxError = maxError;
+    entry.m_chainingEpsilon = chainingEpsilon;
+    entry.m_success = success;
+    entry.m_inferred = aInferOutlineIfNecessary && ( !success || !hasBoardEdges );
+    entry.m_outlines = std::make_shared<SHAPE_POLY_SET>( aOutlines );
+
     return success;
 }
 
@@ -3229,14 +3387,31 @@ void BOARD::RemoveAllListeners()
 }
 
 
+void BOARD::markCopperItemRTreeDirty( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_CachesMutex );
+
+    // Removed items and items with a new bounding box are found by DRC_CACHE_GENERATOR, but
+    // it can't tell an item modified in place, or a new item at a recycled address.
+    if( m_CopperItemRTreeCache )
+        m_CopperItemRTreeDirtyItems.insert( aItems.begin(), aItems.end() );
+}
+
+
 void BOARD::OnItemChanged( BOARD_ITEM* aItem )
 {
+    markCopperItemRTreeDirty( { aItem } );
+    invalidateOutlineCache( { aItem } );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *this, aItem );
 }
 
 
 void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 {
+    markCopperItemRTreeDirty( aItems );
+    invalidateOutlineCache( aItems );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *this, aItems );
 }
 
@@ -3244,6 +3419,11 @@ void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 void BOARD::OnItemsCompositeUpdate( std::vector<BOARD_ITEM*>& aAddedItems, std::vector<BOARD_ITEM*>& aRemovedItems,
                                     std::vector<BOARD_ITEM*>& aChangedItems )
 {
+    markCopperItemRTreeDirty( aChangedItems );
+    invalidateOutlineCache( aAddedItems );
+    invalidateOutlineCacheForRemoved( aRemovedItems );
+    invalidateOutlineCache( aChangedItems );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardCompositeUpdate, *this, aAddedItems, aRemovedItems, aChangedItems );
 }
 
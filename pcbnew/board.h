@@ -39,9 +39,11 @@
 #include <pcb_plot_params.h>
 #include <title_block.h>
 #include <tools/pcb_selection.h>
+#include <mutex>
 #include <shared_mutex>
 #include <project.h>
 #include <list>
+#include <unordered_set>
 
 class BOARD_DESIGN_SETTINGS;
 class BOARD_CONNECTED_ITEM;
@@ -63,6 +65,7 @@ class MSG_PANEL_ITEM;
 class NETLIST;
 class REPORTER;
 class SHAPE_POLY_SET;
+class POLY_SET_HIT_TESTER;
 class CONNECTIVITY_DATA;
 class COMPONENT;
 class PROJECT;
@@ -1446,7 +1449,15 @@ public:
     std::unordered_map< wxString, LSET >                  m_LayerExpressionCache;
     std::unordered_map<ZONE*, std::unique_ptr<DRC_RTREE>> m_CopperZoneRTreeCache;
     std::shared_ptr<DRC_RTREE>                            m_CopperItemRTreeCache;
+
+    // The copper item tree is kept between DRC runs and updated by DRC_CACHE_GENERATOR.  These
+    // are the parameters it was built with, and the items modified in place since.
+    int                                                   m_CopperItemRTreeClearance;
+    LSET                                                  m_CopperItemRTreeLayers;
+    std::unordered_set<const BOARD_ITEM*>                 m_CopperItemRTreeDirtyItems;
     mutable std::unordered_map<const ZONE*, BOX2I>        m_ZoneBBoxCache;
+    mutable std::unordered_map<PTR_LAYER_CACHE_KEY, std::shared_ptr<POLY_SET_HIT_TESTER>>
+                                                          m_ZoneFillHitTestCache;
     mutable std::optional<int>                            m_maxClearanceValue;
 
     mutable std::unordered_map<const BOARD_ITEM*, wxString> m_ItemNetclassCache;
@@ -1476,6 +1487,21 @@ private:
     // Refresh user layer opposites.
     void recalcOpposites();
 
+    void markCopperItemRTreeDirty( const std::vector<BOARD_ITEM*>& aItems );
+
+    /**
+     * Drop the cached board outlines which may depend on \a aItems, which were just added,
+     * removed or modified.
+     */
+    void invalidateOutlineCache( const std::vector<BOARD_ITEM*>& aItems );
+
+    /**
+     * Same as invalidateOutlineCache() for items which were removed from the board and may
+     * have been deleted since: the items are not dereferenced.
+     */
+    void invalidateOutlineCacheForRemoved( const std::vector<BOARD_ITEM*>& aItems );
+    bool isOutlineItem( const BOARD_ITEM* aItem ) const;
+
     friend class PCB_EDIT_FRAME;
 
 private:
@@ -1554,6 +1580,26 @@ private:
 
     std::unique_ptr<COMPONENT_CLASS_MANAGER>  m_componentClassManager;
     std::unique_ptr<LENGTH_DELAY_CALCULATION> m_lengthDelayCalc;
+
+    /// One GetBoardPolygonOutlines() result, for one combination of its options
+    struct OUTLINE_CACHE_ENTRY
+    {
+        bool                            m_inferOutline;
+        bool                            m_allowArcs;
+        bool                            m_includeNPTH;
+        int                             m_maxError;
+        int                             m_chainingEpsilon;
+
+        bool                            m_success;
+        bool                            m_inferred;  ///< Made from the board bounding box, so it
+                                                     ///< depends on all items
+        std::shared_ptr<SHAPE_POLY_SET> m_outlines;
+    };
+
+    std::mutex                            m_outlineCacheMutex;
+    std::vector<OUTLINE_CACHE_ENTRY>      m_outlineCache;
+    std::unordered_set<const BOARD_ITEM*> m_outlineCacheItems;  ///< Edge.Cuts shapes and footprints
+                                                                ///< the cached outlines came from
 };
 
 
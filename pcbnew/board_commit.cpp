@@ -43,6 +43,7 @@
 #include <connectivity/connectivity_algo.h>
 #include <teardrop/teardrop.h>
 #include <pcb_board_outline.h>
+#include <geometry/rtree.h>
 
 #include <functional>
 #include <project/project_file.h>
@@ -130,17 +131,20 @@ COMMIT& BOARD_COMMIT::Stage( const PICKED_ITEMS_LIST& aItems, UNDO_REDO aModFlag
 
 
 void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>* aStaleZones,
-                                    std::vector<BOX2I>& aStaleRuleAreas )
+                                    std::vector<DAMAGE>& aDamage, std::vector<BOX2I>& aStaleRuleAreas )
 {
     wxCHECK( aChangedItem, /* void */ );
 
     if( aStaleZones && aChangedItem->Type() == PCB_ZONE_T )
         aStaleZones->push_back( static_cast<ZONE*>( aChangedItem ) );
 
-    aChangedItem->RunOnChildren( std::bind( &BOARD_COMMIT::propagateDamage, this, _1, aStaleZones, aStaleRuleAreas ),
-                                 RECURSE_MODE::NO_RECURSE );
+    aChangedItem->RunOnChildren(
+            [&]( BOARD_ITEM* aChild )
+            {
+                propagateDamage( aChild, aStaleZones, aDamage, aStaleRuleAreas );
+            },
+            RECURSE_MODE::NO_RECURSE );
 
-    BOARD* board = static_cast<BOARD*>( m_toolMgr->GetModel() );
     BOX2I  damageBBox = aChangedItem->GetBoundingBox();
     LSET   damageLayers = aChangedItem->GetLayerSet();
 
@@ -159,16 +163,57 @@ void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>
             damageLayers &= LSET::AllCuMask();
 
         if( damageLayers.any() )
-        {
-            for( ZONE* zone : board->Zones() )
-            {
-                if( zone->GetIsRuleArea() )
-                    continue;
+            aDamage.push_back( { damageBBox, damageLayers } );
+    }
+}
 
-                if( ( zone->GetLayerSet() & damageLayers ).any() && zone->GetBoundingBox().Intersects( damageBBox ) )
-                    aStaleZones->push_back( zone );
-            }
-        }
+
+void BOARD_COMMIT::findDamagedZones( const std::vector<DAMAGE>& aDamage, std::vector<ZONE*>& aStaleZones )
+{
+    using DAMAGE_TREE = RTree<int, int, 2, double>;
+
+    BOARD* board = static_cast<BOARD*>( m_toolMgr->GetModel() );
+    LSET   damageLayers;
+
+    // A commit can touch many thousands of items, so the damage is indexed once and each zone
+    // makes a single query, rather than testing every zone against every damaged item.
+    std::vector<std::pair<DAMAGE_TREE::Rect, int>> entries;
+    entries.reserve( aDamage.size() );
+
+    for( int ii = 0; ii < (int) aDamage.size(); ++ii )
+    {
+        const BOX2I& bbox = aDamage[ii].m_bbox;
+
+        entries.push_back( { { { bbox.GetX(), bbox.GetY() }, { bbox.GetRight(), bbox.GetBottom() } }, ii } );
+        damageLayers |= aDamage[ii].m_layers;
+    }
+
+    DAMAGE_TREE tree;
+    tree.BulkLoad( entries );
+
+    for( ZONE* zone : board->Zones() )
+    {
+        if( zone->GetIsRuleArea() || ( zone->GetLayerSet() & damageLayers ).none() )
+            continue;
+
+        const BOX2I& zoneBBox = zone->GetBoundingBox();
+        const int    mmin[2] = { zoneBBox.GetX(), zoneBBox.GetY() };
+        const int    mmax[2] = { zoneBBox.GetRight(), zoneBBox.GetBottom() };
+
+        tree.Search( mmin, mmax,
+                     [&]( const int& aIndex ) -> bool
+                     {
+                         const DAMAGE& damage = aDamage[aIndex];
+
+                         if( ( zone->GetLayerSet() & damage.m_layers ).any()
+                                 && zoneBBox.Intersects( damage.m_bbox ) )
+                         {
+                             aStaleZones.push_back( zone );
+                             return false;
+                         }
+
+                         return true;
+                     } );
     }
 }
 
@@ -194,6 +239,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     std::set<PCB_TRACK*>     staleTeardropTracks;
     std::vector<ZONE*>       staleZonesStorage;
     std::vector<ZONE*>*      staleZones = nullptr;
+    std::vector<DAMAGE>      damage;
     std::vector<BOX2I>       staleRuleAreas;
 
     if( Empty() )
@@ -328,7 +374,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             }
 
             if( boardItem->Type() != PCB_MARKER_T )
-                propagateDamage( boardItem, staleZones, staleRuleAreas );
+                propagateDamage( boardItem, staleZones, damage, staleRuleAreas );
 
             if( view && boardItem->Type() != PCB_NETINFO_T )
                 view->Add( boardItem );
@@ -361,7 +407,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 parentGroup->RemoveItem( boardItem );
 
             if( boardItem->Type() != PCB_MARKER_T )
-                propagateDamage( boardItem, staleZones, staleRuleAreas );
+                propagateDamage( boardItem, staleZones, damage, staleRuleAreas );
 
             switch( boardItem->Type() )
             {
@@ -446,8 +492,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
 
             if( boardItem->Type() != PCB_MARKER_T )
             {
-                propagateDamage( boardItemCopy, staleZones, staleRuleAreas );   // before
-                propagateDamage( boardItem, staleZones, staleRuleAreas );       // after
+                propagateDamage( boardItemCopy, staleZones, damage, staleRuleAreas );   // before
+                propagateDamage( boardItem, staleZones, damage, staleRuleAreas );       // after
             }
 
             updateComponentClasses( boardItem );
@@ -477,6 +523,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 RECURSE_MODE::RECURSE );
     } // ... and regenerate them.
 
+    if( staleZones && !damage.empty() )
+        findDamagedZones( damage, *staleZones );
+
     // Invalidate component classes
     board->GetComponentClassManager().InvalidateComponentClasses();
 
@@ -26,6 +26,8 @@
 #pragma once
 
 #include <commit.h>
+#include <lset.h>
+#include <math/box2.h>
 
 class BOARD_ITEM;
 class PCB_SHAPE;
@@ -76,8 +78,21 @@ private:
 
     EDA_ITEM* makeImage( EDA_ITEM* aItem ) const override;
 
+    /// Area and copper layers of a changed item, which can make the zone fills around it stale
+    struct DAMAGE
+    {
+        BOX2I m_bbox;
+        LSET  m_layers;
+    };
+
+    /**
+     * Record the damage done by a changed item and its children.  The zones touched by the
+     * damage are found afterwards, all at once, by findDamagedZones().
+     */
     void propagateDamage( BOARD_ITEM* aItem, std::vector<ZONE*>* aStaleZones,
-                          std::vector<BOX2I>& aStaleRuleAreas );
+                          std::vector<DAMAGE>& aDamage, std::vector<BOX2I>& aStaleRuleAreas );
+
+    void findDamagedZones( const std::vector<DAMAGE>& aDamage, std::vector<ZONE*>& aStaleZones );
 
 private:
     TOOL_MANAGER*  m_toolMgr;
@@ -377,142 +377,80 @@ INSPECT_RESULT GENERAL_COLLECTOR::Inspect( EDA_ITEM* aTestItem, void* aTestData
         }
     }
 
-    if( boardItem
-            && ( boardItem->IsOnLayer( m_Guide->GetPreferredLayer() ) )
-            && ( !boardItem->IsLocked() || !m_Guide->IgnoreLockedItems() ) )
-    {
-        // Footprints and their subcomponents: reference, value and pads are not sensitive to the
-        // layer visibility controls; they all have their own separate visibility controls.
-        // For vias, GetLayer() has no meaning, but IsOnLayer() works fine.
-        // User text and fields in a footprint *are* sensitive to layer visibility but they were
-        // already handled.
+    // Items on the preferred layer go to the primary list.  For now, "secondary" means
+    // "tolerate any visible layer".  It has no effect on other criteria, since there is a
+    // separate "ignore" control for those in the COLLECTORS_GUIDE.
+    if( !boardItem || ( boardItem->IsLocked() && m_Guide->IgnoreLockedItems() ) )
+        return INSPECT_RESULT::CONTINUE;
 
-        int accuracy = m_Guide->Accuracy();
+    const bool primary = boardItem->IsOnLayer( m_Guide->GetPreferredLayer() );
 
-        if( zone )
-        {
-            if( zone->HitTestForCorner( m_refPos, accuracy * 2 ) || zone->HitTestForEdge( m_refPos, accuracy ) )
-            {
-                Append( zone );
-                return INSPECT_RESULT::CONTINUE;
-            }
-            else if( !m_Guide->IgnoreZoneFills() )
-            {
-                for( PCB_LAYER_ID layer : zone->GetLayerSet() )
-                {
-                    if( m_Guide->IsLayerVisible( layer ) && zone->HitTestFilledArea( layer, m_refPos ) )
-                    {
-                        Append( zone );
-                        return INSPECT_RESULT::CONTINUE;
-                    }
-                }
-            }
-        }
-        else if( aTestItem == footprint )
-        {
-            if( footprint->HitTest( m_refPos, accuracy ) && footprint->HitTestAccurate( m_refPos, accuracy ) )
-            {
-                Append( footprint );
-                return INSPECT_RESULT::CONTINUE;
-            }
-        }
-        else if( pad || via )
-        {
-            if( boardItem->HitTest( m_refPos, accuracy ) )
-            {
-                Append( boardItem );
-                return INSPECT_RESULT::CONTINUE;
-            }
-        }
-        else
-        {
-            PCB_LAYER_ID layer = boardItem->GetLayer();
+    if( !primary && !m_Guide->IncludeSecondary() )
+        return INSPECT_RESULT::CONTINUE;
 
-            if( m_Guide->IsLayerVisible( layer ) )
-            {
-                if( dimension )
-                {
-                    // Dimensions feel particularly hard to select, probably due to their noisy
-                    // shape making it feel like they should have a larger boundary.
-                    accuracy = KiROUND( accuracy * 1.5 );
-                }
+    // Both lists use the same hit test, so it is only run once per item.
 
-                if( boardItem->HitTest( m_refPos, accuracy ) )
-                {
-                    Append( boardItem );
-                    return INSPECT_RESULT::CONTINUE;
-                }
-            }
-        }
-    }
-
-    if( m_Guide->IncludeSecondary()
-            && ( !boardItem || !boardItem->IsLocked() || !m_Guide->IgnoreLockedItems() ) )
-    {
-        // For now, "secondary" means "tolerate any visible layer".  It has no effect on other
-        // criteria, since there is a separate "ignore" control for those in the COLLECTORS_GUIDE
+    // Footprints and their subcomponents: reference, value and pads are not sensitive to the
+    // layer visibility controls; they all have their own separate visibility controls.
+    // For vias, GetLayer() has no meaning, but IsOnLayer() works fine.
+    // User text and fields in a footprint *are* sensitive to layer visibility but they were
+    // already handled.
 
-        // Footprints and their subcomponents: reference, value and pads are not sensitive to the
-        // layer visibility controls; they all have their own separate visibility controls.
-        // For vias, GetLayer() has no meaning, but IsOnLayer() works fine.
-        // User text and fields in a footprint *are* sensitive to layer visibility but they were
-        // already handled.
+    int  accuracy = m_Guide->Accuracy();
+    bool hit = false;
 
-        int accuracy = m_Guide->Accuracy();
+    if( zone )
+    {
+        // Zones are large and often overlap, so reject the ones whose outline is away from the
+        // cursor before walking their corners, edges and fills.
+        BOX2I bbox = zone->GetBoundingBox();
+        bbox.Inflate( accuracy * 2 );
 
-        if( zone )
+        if( bbox.Contains( m_refPos ) )
         {
             if( zone->HitTestForCorner( m_refPos, accuracy * 2 ) || zone->HitTestForEdge( m_refPos, accuracy ) )
             {
-                Append2nd( zone );
-                return INSPECT_RESULT::CONTINUE;
+                hit = true;
             }
             else if( !m_Guide->IgnoreZoneFills() )
             {
                 for( PCB_LAYER_ID layer : zone->GetLayerSet() )
                 {
-                    if( m_Guide->IsLayerVisible( layer ) && zone->HitTestFilledArea( layer, m_refPos ) )
+                    if( m_Guide->IsLayerVisible( layer ) && zone->HitTestFilledAreaCached( layer, m_refPos ) )
                     {
-                        Append2nd( zone );
-                        return INSPECT_RESULT::CONTINUE;
+                        hit = true;
+                        break;
                     }
                 }
             }
         }
-        else if( aTestItem->Type() == PCB_FOOTPRINT_T )
-        {
-            // Already tested above, but Coverity can't figure that out
-            wxCHECK( footprint, INSPECT_RESULT::CONTINUE );
-
-            if( footprint->HitTest( m_refPos, accuracy ) && footprint->HitTestAccurate( m_refPos, accuracy ) )
-            {
-                Append2nd( footprint );
-                return INSPECT_RESULT::CONTINUE;
-            }
-        }
-        else if( pad || via )
+    }
+    else if( aTestItem == footprint )
+    {
+        hit = footprint->HitTest( m_refPos, accuracy ) && footprint->HitTestAccurate( m_refPos, accuracy );
+    }
+    else if( pad || via )
+    {
+        hit = boardItem->HitTest( m_refPos, accuracy );
+    }
+    else if( m_Guide->IsLayerVisible( boardItem->GetLayer() ) )
+    {
+        if( dimension )
         {
-            if( boardItem->HitTest( m_refPos, accuracy ) )
-            {
-                Append2nd( boardItem );
-                return INSPECT_RESULT::CONTINUE;
-            }
+            // Dimensions feel particularly hard to select, probably due to their noisy shape
+            // making it feel like they should have a larger boundary.
+            accuracy = KiROUND( accuracy * 1.5 );
         }
-        else if( boardItem && m_Guide->IsLayerVisible( boardItem->GetLayer() ) )
-        {
-            if( dimension )
-            {
-                // Dimensions feel particularly hard to select, probably due to their noisy shape
-                // making it feel like they should have a larger boundary.
-                accuracy = KiROUND( accuracy * 1.5 );
-            }
 
-            if( boardItem->HitTest( m_refPos, accuracy ) )
-            {
-                Append2nd( boardItem );
-                return INSPECT_RESULT::CONTINUE;
-            }
-        }
+        hit = boardItem->HitTest( m_refPos, accuracy );
+    }
+
+    if( hit )
+    {
+        if( primary )
+            Append( boardItem );
+        else
+            Append2nd( boardItem );
     }
 
     return INSPECT_RESULT::CONTINUE; // always when collecting
@@ -323,6 +323,29 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS
 CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones, int aSingleNet )
+{
+    return searchClusters( aMode, aExcludeZones,
+                           [aSingleNet]( int aNet )
+                           {
+                               return aSingleNet < 0 || aNet == aSingleNet;
+                           } );
+}
+
+
+const CN_CONNECTIVITY_ALGO::CLUSTERS
+CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::set<int>& aNets )
+{
+    return searchClusters( aMode, ( aMode == CSM_PROPAGATE ),
+                           [&aNets]( int aNet )
+                           {
+                               return aNets.contains( aNet );
+                           } );
+}
+
+
+const CN_CONNECTIVITY_ALGO::CLUSTERS
+CN_CONNECTIVITY_ALGO::searchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones,
+                                      const std::function<bool( int )>& aNetFilter )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
@@ -337,7 +360,7 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZo
     std::set<CN_ITEM*> visited;
 
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, &aExcludeZones]( CN_ITEM *aItem )
+            [&item_set, withinAnyNet, &aNetFilter, &aExcludeZones]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -345,7 +368,7 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZo
                 if( !aItem->Valid() )
                     return;
 
-                if( aSingleNet >=0 && aItem->Net() != aSingleNet )
+                if( !aNetFilter( aItem->Net() ) )
                     return;
 
                 if( aExcludeZones && aItem->Parent()->Type() == PCB_ZONE_T )
@@ -644,59 +667,146 @@ void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
 }
 
 
-void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>>& aMap,
-                                                   bool aConnectivityAlreadyRebuilt )
+void CN_CONNECTIVITY_ALGO::addZones( const std::vector<ZONE*>& aZones )
 {
-    int progressDelta = 50;
-    int ii = 0;
+    std::vector<CN_ZONE_LAYER*> zitems;
+
+    for( ZONE* zone : aZones )
+    {
+        if( !zone->IsOnCopperLayer() )
+            continue;
+
+        m_itemMap[zone] = ITEM_MAP_ENTRY();
+        markItemNetAsDirty( zone );
+
+        // Don't check for connections on layers that only exist in the zone but
+        // were disabled in the board
+        BOARD* board = zone->GetBoard();
+        LSET layerset = board->GetEnabledLayers() & zone->GetLayerSet();
+
+        layerset.RunOnLayers(
+                [&]( PCB_LAYER_ID layer )
+                {
+                    for( int j = 0; j < zone->GetFilledPolysList( layer )->OutlineCount(); j++ )
+                        zitems.push_back( new CN_ZONE_LAYER( zone, layer, j ) );
+                } );
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( 0, zitems.size(),
+            [&]( const int ii )
+            {
+                CN_ZONE_LAYER* zitem = zitems[ii];
+                ZONE*          zone = static_cast<ZONE*>( zitem->Parent() );
+
+                zitem->BuildRTree();
+
+                const SHAPE_POLY_SET& fill = *zone->GetFilledPolysList( zitem->GetLayer() );
+
+                for( const VECTOR2I& pt : fill.COutline( zitem->SubpolyIndex() ).CPoints() )
+                    zitem->AddAnchor( pt );
+            } )
+            .wait();
+
+    for( CN_ZONE_LAYER* zitem : zitems )
+    {
+        m_itemList.Add( zitem );
+        m_itemMap[ zitem->Parent() ].Link( zitem );
+    }
+}
 
-    progressDelta = std::max( progressDelta, (int) aMap.size() / 4 );
 
+void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>>& aMap,
+                                                   bool aConnectivityAlreadyRebuilt )
+{
     if( !aConnectivityAlreadyRebuilt )
     {
+        std::vector<ZONE*> zones;
+
         for( const auto& [ zone, islands ] : aMap )
         {
             Remove( zone );
-            Add( zone );
-            ii++;
+            zones.push_back( zone );
+        }
 
-            if( m_progressReporter && ( ii % progressDelta ) == 0 )
-            {
-                m_progressReporter->SetCurrentProgress( (double) ii / (double) aMap.size() );
-                m_progressReporter->KeepRefreshing( false );
-            }
+        addZones( zones );
+
+        if( m_progressReporter )
+        {
+            m_progressReporter->SetCurrentProgress( 0.5 );
+            m_progressReporter->KeepRefreshing( false );
 
-            if( m_progressReporter && m_progressReporter->IsCancelled() )
+            if( m_progressReporter->IsCancelled() )
                 return;
         }
     }
 
-    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
+    // Only the nets of the zones being checked matter: clusters never span several nets in
+    // connectivity-check mode.
+    std::set<int> nets;
+
+    for( const auto& [ zone, zoneIslands ] : aMap )
+        nets.insert( zone->GetNetCode() );
+
+    const CLUSTERS clusters = SearchClusters( CSM_CONNECTIVITY_CHECK, nets );
+
+    std::unordered_map<const CN_ITEM*, const CN_CLUSTER*> itemClusters;
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : clusters )
+    {
+        for( CN_ITEM* item : *cluster )
+            itemClusters[item] = cluster.get();
+    }
+
+    // Each (zone, layer) pair only reads the cluster lookup and writes its own islands entry,
+    // so the classification runs in parallel.
+    std::vector<std::tuple<ZONE*, PCB_LAYER_ID, ISOLATED_ISLANDS*>> zoneLayers;
 
     for( auto& [ zone, zoneIslands ] : aMap )
     {
         for( auto& [ layer, layerIslands ] : zoneIslands )
         {
-            if( zone->GetFilledPolysList( layer )->IsEmpty() )
-                continue;
+            if( !zone->GetFilledPolysList( layer )->IsEmpty() )
+                zoneLayers.emplace_back( zone, layer, &layerIslands );
+        }
+    }
 
-            for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( 0, zoneLayers.size(),
+            [&]( const int ii )
             {
-                for( CN_ITEM* item : *cluster )
+                auto [ zone, layer, layerIslands ] = zoneLayers[ii];
+                auto entry = m_itemMap.find( zone );
+
+                if( entry == m_itemMap.end() )
+                    return;
+
+                for( CN_ITEM* item : entry->second.GetItems() )
                 {
-                    if( item->Parent() == zone && item->GetBoardLayer() == layer )
-                    {
-                        CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+                    if( !item->Valid() || item->GetBoardLayer() != layer )
+                        continue;
 
-                        if( cluster->IsOrphaned() )
-                            layerIslands.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
-                        else if( z->HasSingleConnection() )
-                            layerIslands.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
-                    }
+                    auto clusterIt = itemClusters.find( item );
+
+                    if( clusterIt == itemClusters.end() )
+                        continue;
+
+                    CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+
+                    if( clusterIt->second->IsOrphaned() )
+                        layerIslands->m_IsolatedOutlines.push_back( z->SubpolyIndex() );
+                    else if( z->HasSingleConnection() )
+                        layerIslands->m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
                 }
-            }
-        }
-    }
+
+                std::sort( layerIslands->m_IsolatedOutlines.begin(),
+                           layerIslands->m_IsolatedOutlines.end() );
+                std::sort( layerIslands->m_SingleConnectionOutlines.begin(),
+                           layerIslands->m_SingleConnectionOutlines.end() );
+            } )
+            .wait();
 }
 
 
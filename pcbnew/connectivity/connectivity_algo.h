@@ -42,6 +42,7 @@
 #include <functional>
 #include <vector>
 #include <deque>
+#include <set>
 
 #include <connectivity/connectivity_rtree.h>
 #include <connectivity/connectivity_data.h>
@@ -265,6 +266,11 @@ public:
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones, int aSingleNet );
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
+    /**
+     * Search clusters only for items belonging to one of \a aNets.
+     */
+    const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, const std::set<int>& aNets );
+
     /**
      * Propagate nets from pads to other items in clusters.
      * @param aCommit is used to store undo information for items modified by the call.
@@ -321,6 +327,15 @@ private:
 
     void markItemNetAsDirty( const BOARD_ITEM* aItem );
 
+    const CLUSTERS searchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones,
+                                   const std::function<bool( int )>& aNetFilter );
+
+    /**
+     * Add zones whose filled polygons have (re)changed.  The per-outline RTrees and anchors are
+     * built in parallel, only the insertion into the item list is serial.
+     */
+    void addZones( const std::vector<ZONE*>& aZones );
+
     void updateJumperPads();
 
 private:
@@ -34,6 +34,7 @@
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
 #include <connectivity/from_to_cache.h>
+#include <core/trace_events.h>
 #include <board_item.h>
 #include <project/net_settings.h>
 #include <board_design_settings.h>
@@ -98,6 +99,8 @@ bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 
 bool CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
+    TRACE_ZONE traceZone( "Build connectivity", "connectivity" );
+
     aBoard->CacheTriangulation( aReporter );
 
     std::unique_lock<KISPINLOCK> lock( m_lock, std::try_to_lock );
@@ -487,7 +490,7 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
                 if( aItem->Type() == PCB_PAD_T && zoneLayer )
                 {
                     const PAD*    pad = static_cast<const PAD*>( aItem );
-                    ZONE*         zone = static_cast<ZONE*>( zoneLayer->Parent() );
+                    const ZONE*   zone = static_cast<const ZONE*>( zoneLayer->Parent() );
                     int           islandIdx = zoneLayer->SubpolyIndex();
 
                     if( zone->IsFilled() )
@@ -513,7 +516,7 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
                 else if( aItem->Type() == PCB_VIA_T && zoneLayer )
                 {
                     const PCB_VIA* via = static_cast<const PCB_VIA*>( aItem );
-                    ZONE*          zone = static_cast<ZONE*>( zoneLayer->Parent() );
+                    const ZONE*    zone = static_cast<const ZONE*>( zoneLayer->Parent() );
                     int            islandIdx = zoneLayer->SubpolyIndex();
 
                     if( zone->IsFilled() )
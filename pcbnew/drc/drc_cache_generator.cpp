@@ -32,6 +32,7 @@
 #include <drc/drc_rtree.h>
 #include <drc/drc_cache_generator.h>
 #include <mutex>
+#include <unordered_set>
 
 bool DRC_CACHE_GENERATOR::Run()
 {
@@ -62,9 +63,10 @@ bool DRC_CACHE_GENERATOR::Run()
             {
                 zone->Outline()->BuildBBoxCaches();
 
+                // Only the bounding box caches change, so leave the fill revision alone
                 for( PCB_LAYER_ID layer : copperLayers )
                 {
-                    if( SHAPE_POLY_SET* fill = zone->GetFill( layer ) )
+                    if( SHAPE_POLY_SET* fill = zone->GetFilledPolysList( layer ).get() )
                         fill->BuildBBoxCaches();
                 }
             };
@@ -111,6 +113,28 @@ bool DRC_CACHE_GENERATOR::Run()
     size_t              count = 0;
     std::atomic<size_t> done( 1 );
 
+    // The copper item tree is kept by the board between runs.  It only needs to be rebuilt from
+    // scratch when the inflation used for its boxes or the copper layers change; otherwise only
+    // the items which were added, removed, moved or modified since the last run are updated.
+    std::unordered_set<const BOARD_ITEM*> dirtyItems;
+    std::unordered_set<const BOARD_ITEM*> visitedItems;
+
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_board->m_CachesMutex );
+
+        if( !m_board->m_CopperItemRTreeCache
+                || !m_board->m_CopperItemRTreeCache->IsRemovable()
+                || m_board->m_CopperItemRTreeClearance != largestClearance
+                || m_board->m_CopperItemRTreeLayers != boardCopperLayers )
+        {
+            m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>( true );
+            m_board->m_CopperItemRTreeClearance = largestClearance;
+            m_board->m_CopperItemRTreeLayers = boardCopperLayers;
+        }
+
+        dirtyItems.swap( m_board->m_CopperItemRTreeDirtyItems );
+    }
+
     auto countItems =
             [&]( BOARD_ITEM* item ) -> bool
             {
@@ -118,13 +142,25 @@ bool DRC_CACHE_GENERATOR::Run()
                 return true;
             };
 
+    auto isDirty =
+            [&]( BOARD_ITEM* item ) -> bool
+            {
+                if( dirtyItems.empty() )
+                    return false;
+
+                // Footprint children and table cells are modified through their parent
+                return dirtyItems.count( item ) || dirtyItems.count( item->GetParent() )
+                       || dirtyItems.count( item->GetParentFootprint() );
+            };
+
     auto addToCopperTree =
             [&]( BOARD_ITEM* item ) -> bool
             {
                 if( m_drcEngine->IsCancelled() )
                     return false;
 
-                LSET copperLayers = item->GetLayerSet() & boardCopperLayers;
+                DRC_RTREE* copperTree = m_board->m_CopperItemRTreeCache.get();
+                LSET       copperLayers = item->GetLayerSet() & boardCopperLayers;
 
                 // Special-case pad holes which pierce all the copper layers
                 if( item->Type() == PCB_PAD_T )
@@ -135,11 +171,18 @@ bool DRC_CACHE_GENERATOR::Run()
                         copperLayers = boardCopperLayers;
                 }
 
-                copperLayers.RunOnLayers(
-                        [&]( PCB_LAYER_ID layer )
-                        {
-                            m_board->m_CopperItemRTreeCache->Insert( item, layer, largestClearance );
-                        } );
+                visitedItems.insert( item );
+
+                if( !copperTree->IsIndexed( item, copperLayers ) || isDirty( item ) )
+                {
+                    copperTree->Remove( item );
+
+                    copperLayers.RunOnLayers(
+                            [&]( PCB_LAYER_ID layer )
+                            {
+                                copperTree->Insert( item, layer, largestClearance );
+                            } );
+                }
 
                 done.fetch_add( 1 );
                 return true;
@@ -165,10 +208,28 @@ bool DRC_CACHE_GENERATOR::Run()
             {
                 std::unique_lock<std::shared_mutex> writeLock( m_board->m_CachesMutex );
 
-                if( !m_board->m_CopperItemRTreeCache )
-                    m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
-
                 forEachGeometryItem( itemTypes, boardCopperLayers, addToCopperTree );
+
+                if( m_drcEngine->IsCancelled() )
+                {
+                    // Partially updated, and the dirty items are lost
+                    m_board->m_CopperItemRTreeCache = nullptr;
+                    return;
+                }
+
+                // Anything left over was deleted or moved off the copper layers since the last
+                // run.  These pointers may be dangling, so they are only used as keys.
+                std::vector<const BOARD_ITEM*> staleItems;
+
+                m_board->m_CopperItemRTreeCache->ForEachIndexedItem(
+                        [&]( const BOARD_ITEM* item )
+                        {
+                            if( !visitedItems.count( item ) )
+                                staleItems.push_back( item );
+                        } );
+
+                for( const BOARD_ITEM* item : staleItems )
+                    m_board->m_CopperItemRTreeCache->Remove( item );
             } );
 
     std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
@@ -43,6 +43,7 @@
 #include <pcb_track.h>
 #include <pcb_shape.h>
 #include <core/profile.h>
+#include <core/trace_events.h>
 #include <thread_pool.h>
 #include <zone.h>
 #include <project/project_file.h>
@@ -907,6 +908,8 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
         if( m_logReporter )
             m_logReporter->Report( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
 
+        TRACE_ZONE traceZone( provider->GetName().ToStdString(), "drc" );
+
         if( !provider->RunTests( aUnits ) )
             break;
     }
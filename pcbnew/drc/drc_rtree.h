@@ -28,7 +28,10 @@
 #include <board_item.h>
 #include <pad.h>
 #include <pcb_field.h>
+#include <pcb_track.h>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <set>
 #include <vector>
@@ -77,7 +80,13 @@ private:
     using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
 
 public:
-    DRC_RTREE()
+    /**
+     * @param aRemovable set to true to remember where each item was inserted, so that it can
+     *                   later be removed with Remove().  This costs some memory, and is only
+     *                   useful for trees which are kept up to date between DRC runs.
+     */
+    DRC_RTREE( bool aRemovable = false ) :
+            m_removable( aRemovable )
     {
         for( int layer : LSET::AllLayersMask() )
             m_tree[layer] = new drc_rtree();
@@ -113,6 +122,18 @@ public:
     {
         wxCHECK( aTargetLayer != UNDEFINED_LAYER, /* void */ );
 
+        INDEXED_ITEM* indexed = nullptr;
+
+        if( m_removable )
+        {
+            indexed = &m_indexedItems[aItem];
+            indexed->m_bbox = aItem->GetBoundingBox();
+            indexed->m_layers.set( aTargetLayer );
+
+            if( flashedByConnection( aItem, aRefLayer ) )
+                indexed->m_flashedLayers.set( aTargetLayer );
+        }
+
         if( aItem->Type() == PCB_FIELD_T && !static_cast<PCB_FIELD*>( aItem )->IsVisible() )
             return;
 
@@ -146,6 +167,9 @@ public:
 
             m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
             m_count++;
+
+            if( indexed )
+                indexed->m_entries.push_back( { aTargetLayer, bbox, itemShape } );
         }
 
         if( aItem->Type() == PCB_PAD_T && aItem->HasHole() )
@@ -161,9 +185,81 @@ public:
 
             m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
             m_count++;
+
+            if( indexed )
+                indexed->m_entries.push_back( { aTargetLayer, bbox, itemShape } );
+        }
+    }
+
+    /**
+     * Remove all the entries of an item, on all layers.  Only available for trees constructed
+     * with aRemovable set.
+     *
+     * The item itself is never dereferenced, so it is safe to call this for an item which has
+     * already been deleted.
+     */
+    void Remove( const BOARD_ITEM* aItem )
+    {
+        wxCHECK( m_removable, /* void */ );
+
+        auto it = m_indexedItems.find( aItem );
+
+        if( it == m_indexedItems.end() )
+            return;
+
+        for( const INDEXED_ENTRY& entry : it->second.m_entries )
+        {
+            const int mmin[2] = { entry.m_bbox.GetX(), entry.m_bbox.GetY() };
+            const int mmax[2] = { entry.m_bbox.GetRight(), entry.m_bbox.GetBottom() };
+
+            if( !m_tree[entry.m_layer]->Remove( mmin, mmax, entry.m_itemShape ) )
+                m_count--;
+
+            delete entry.m_itemShape;
+        }
+
+        m_indexedItems.erase( it );
+    }
+
+    /**
+     * Check if an item was inserted on \a aLayers, and hasn't changed its bounding box nor, for
+     * pads and vias which remove their unconnected layers, the layers it is flashed on since.
+     * Only available for trees constructed with aRemovable set, and filled with the same
+     * reference and target layers.
+     */
+    bool IsIndexed( const BOARD_ITEM* aItem, const LSET& aLayers ) const
+    {
+        auto it = m_indexedItems.find( aItem );
+
+        if( it == m_indexedItems.end()
+                || it->second.m_layers != aLayers
+                || it->second.m_bbox != aItem->GetBoundingBox() )
+        {
+            return false;
+        }
+
+        // Connectivity and zone fills change these shapes without changing the bounding box
+        for( PCB_LAYER_ID layer : aLayers )
+        {
+            if( flashedByConnection( aItem, layer ) != it->second.m_flashedLayers.test( layer ) )
+                return false;
         }
+
+        return true;
+    }
+
+    /**
+     * Call \a aFunc for each item inserted in a removable tree.  The items may have been
+     * deleted since, and must not be dereferenced.
+     */
+    void ForEachIndexedItem( const std::function<void( const BOARD_ITEM* )>& aFunc ) const
+    {
+        for( const auto& [item, _] : m_indexedItems )
+            aFunc( item );
     }
 
+    bool IsRemovable() const { return m_removable; }
+
     /**
      * Remove all items from the RTree.
      */
@@ -172,6 +268,13 @@ public:
         for( auto& [_, tree] : m_tree )
             tree->RemoveAll();
 
+        for( auto& [_, indexed] : m_indexedItems )
+        {
+            for( const INDEXED_ENTRY& entry : indexed.m_entries )
+                delete entry.m_itemShape;
+        }
+
+        m_indexedItems.clear();
         m_count = 0;
     }
 
@@ -604,8 +707,46 @@ public:
 
 
 private:
+    struct INDEXED_ENTRY
+    {
+        int              m_layer;
+        BOX2I            m_bbox;
+        ITEM_WITH_SHAPE* m_itemShape;
+    };
+
+    struct INDEXED_ITEM
+    {
+        BOX2I                      m_bbox;     ///< Item bounding box when it was inserted
+        LSET                       m_layers;
+        LSET                       m_flashedLayers;  ///< See flashedByConnection()
+        std::vector<INDEXED_ENTRY> m_entries;
+    };
+
+    /**
+     * @return true if \a aItem is a pad or via which only has copper on \a aLayer because it
+     *         is connected there, and is currently flashed on it.
+     */
+    static bool flashedByConnection( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer )
+    {
+        if( aItem->Type() == PCB_PAD_T )
+        {
+            const PAD* pad = static_cast<const PAD*>( aItem );
+            return pad->ConditionallyFlashed( aLayer ) && pad->FlashLayer( aLayer );
+        }
+        else if( aItem->Type() == PCB_VIA_T )
+        {
+            const PCB_VIA* via = static_cast<const PCB_VIA*>( aItem );
+            return via->ConditionallyFlashed( aLayer ) && via->FlashLayer( aLayer );
+        }
+
+        return false;
+    }
+
     std::map<int, drc_rtree*> m_tree;
     size_t                    m_count;
+
+    bool                                                  m_removable;
+    std::unordered_map<const BOARD_ITEM*, INDEXED_ITEM>   m_indexedItems;
 };
 
 
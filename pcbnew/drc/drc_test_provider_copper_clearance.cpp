@@ -1315,12 +1315,14 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
 
         for( size_t ii : zone_idx_by_layer[layer] )
         {
-            if( SHAPE_POLY_SET* poly = m_board->m_DRCCopperZones[ii]->GetFill( layer ) )
+            const ZONE* zone = m_board->m_DRCCopperZones[ii];
+
+            if( const SHAPE_POLY_SET* poly = zone->GetFill( layer ) )
             {
                 std::vector<SEG>& zone_layer_poly_segs = poly_segments[ii][layer];
                 zone_layer_poly_segs.reserve( poly->FullPointCount() );
 
-                for( auto it = poly->IterateSegmentsWithHoles(); it; it++ )
+                for( auto it = poly->CIterateSegmentsWithHoles(); it; it++ )
                 {
                     SEG seg = *it;
 
@@ -1354,8 +1356,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     continue;
 
                 // Examine a candidate zone: compare zoneB to zoneA
-                SHAPE_POLY_SET* polyA = nullptr;
-                SHAPE_POLY_SET* polyB = nullptr;
+                const SHAPE_POLY_SET* polyA = nullptr;
+                const SHAPE_POLY_SET* polyB = nullptr;
 
                 if( sameNet )
                 {
@@ -1364,8 +1366,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                 }
                 else
                 {
-                    polyA = zoneA->GetFill( layer );
-                    polyB = zoneB->GetFill( layer );
+                    polyA = zoneA->GetFilledPolysList( layer ).get();
+                    polyB = zoneB->GetFilledPolysList( layer ).get();
                 }
 
                 if( !polyA->BBoxFromCaches().Intersects( polyB->BBoxFromCaches() ) )
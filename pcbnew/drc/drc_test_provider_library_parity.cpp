@@ -38,6 +38,9 @@
 #include <drc/drc_test_provider.h>
 #include <project_pcb.h>
 #include <string_utils.h>
+#include <thread_pool.h>
+
+#include <atomic>
 
 
 /*
@@ -1067,12 +1070,14 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
 
     FOOTPRINT_LIBRARY_ADAPTER* adapter = PROJECT_PCB::FootprintLibAdapter( project );
     wxString      msg;
-    int           ii = 0;
-    const int     progressDelta = 250;
 
     if( !reportPhase( _( "Checking board footprints against library..." ) ) )
         return false;
 
+    // Footprints to compare with their library footprint, and the library footprints to load
+    std::vector<FOOTPRINT*> footprints;
+    std::set<LIB_ID>        libFpids;
+
     for( FOOTPRINT* footprint : board->Footprints() )
     {
         if( m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES )
@@ -1081,12 +1086,8 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
             return true;    // Continue with other tests
         }
 
-        if( !reportProgress( ii++, (int) board->Footprints().size(), progressDelta ) )
-            return false;   // DRC cancelled
-
         LIB_ID               fpID = footprint->GetFPID();
         wxString             libName = fpID.GetLibNickname();
-        wxString             fpName = fpID.GetLibItemName();
         LIBRARY_TABLE_ROW*   libTableRow = nullptr;
 
         if( libName.IsEmpty() )
@@ -1142,56 +1143,75 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
             continue;
         }
 
-        auto                       cacheIt = libFootprintCache.find( fpID );
-        std::shared_ptr<FOOTPRINT> libFootprint;
+        footprints.push_back( footprint );
+        libFpids.insert( fpID );
+    }
 
-        if( cacheIt != libFootprintCache.end() )
-        {
-            libFootprint = cacheIt->second;
-        }
-        else
-        {
-            try
-            {
-                libFootprint.reset( adapter->LoadFootprint( libName, fpName, true ) );
+    // Load each library footprint once, however many instances of it the board has
+    for( auto& [fpID, libFootprint] : adapter->LoadFootprints( libFpids, true ) )
+        libFootprintCache[ fpID ] = std::move( libFootprint );
 
-                if( libFootprint )
-                    libFootprintCache[ fpID ] = libFootprint;
-            }
-            catch( const IO_ERROR& )
-            {
-            }
-        }
+    thread_pool& tp = GetKiCadThreadPool();
 
-        if( !libFootprint )
-        {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
-            {
-                std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_ISSUES );
-                msg.Printf( _( "Footprint '%s' not found in library '%s'" ),
-                            fpName,
-                            libName );
-                drcItem->SetErrorMessage( msg );
-                drcItem->SetItems( footprint );
-                reportViolation( drcItem, footprint->GetCenter(), UNDEFINED_LAYER );
-            }
-        }
-        else if( footprint->FootprintNeedsUpdate( libFootprint.get(), BOARD_ITEM::COMPARE_FLAGS::DRC ) )
-        {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
+    std::atomic<size_t> done( 0 );
+
+    auto returns = tp.submit_loop( 0, footprints.size(),
+            [&]( size_t ii )
             {
-                std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_MISMATCH );
-                msg.Printf( _( "Footprint '%s' does not match copy in library '%s'" ),
-                            fpName,
-                            libName );
-                drcItem->SetErrorMessage( msg );
-                drcItem->SetItems( footprint );
-                reportViolation( drcItem, footprint->GetCenter(), UNDEFINED_LAYER );
-            }
-        }
+                if( m_drcEngine->IsCancelled()
+                        || ( m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES )
+                             && m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) ) )
+                {
+                    return;
+                }
+
+                FOOTPRINT*                        footprint = footprints[ii];
+                const LIB_ID&                     fpID = footprint->GetFPID();
+                const std::shared_ptr<FOOTPRINT>& libFootprint = libFootprintCache.at( fpID );
+                wxString                          libName = fpID.GetLibNickname();
+                wxString                          fpName = fpID.GetLibItemName();
+                wxString                          errMsg;
+
+                if( !libFootprint )
+                {
+                    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
+                    {
+                        std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_ISSUES );
+                        errMsg.Printf( _( "Footprint '%s' not found in library '%s'" ),
+                                       fpName,
+                                       libName );
+                        drcItem->SetErrorMessage( errMsg );
+                        drcItem->SetItems( footprint );
+                        reportViolation( drcItem, footprint->GetCenter(), UNDEFINED_LAYER );
+                    }
+                }
+                else if( footprint->FootprintNeedsUpdate( libFootprint.get(), BOARD_ITEM::COMPARE_FLAGS::DRC ) )
+                {
+                    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
+                    {
+                        std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_MISMATCH );
+                        errMsg.Printf( _( "Footprint '%s' does not match copy in library '%s'" ),
+                                       fpName,
+                                       libName );
+                        drcItem->SetErrorMessage( errMsg );
+                        drcItem->SetItems( footprint );
+                        reportViolation( drcItem, footprint->GetCenter(), UNDEFINED_LAYER );
+                    }
+                }
+
+                ++done;
+            } );
+
+    for( auto& ret : returns )
+    {
+        if( !ret.valid() )
+            continue;
+
+        while( ret.wait_for( std::chrono::milliseconds( 250 ) ) == std::future_status::timeout )
+            reportProgress( done, footprints.size() );
     }
 
-    return true;
+    return !m_drcEngine->IsCancelled();
 }
 
 
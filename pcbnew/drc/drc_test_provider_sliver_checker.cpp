@@ -115,7 +115,7 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
                 forEachGeometryItem( s_allBasicItems, LSET().set( layer ),
                         [&]( BOARD_ITEM* item ) -> bool
                         {
-                            if( ZONE* zone = dynamic_cast<ZONE*>( item) )
+                            if( const ZONE* zone = dynamic_cast<const ZONE*>( item ) )
                             {
                                 if( !zone->GetIsRuleArea() )
                                 {
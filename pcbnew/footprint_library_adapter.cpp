@@ -415,6 +415,46 @@ FOOTPRINT* FOOTPRINT_LIBRARY_ADAPTER::LoadFootprintWithOptionalNickname( const L
 }
 
 
+std::map<LIB_ID, std::unique_ptr<FOOTPRINT>>
+FOOTPRINT_LIBRARY_ADAPTER::LoadFootprints( const std::set<LIB_ID>& aFootprintIds, bool aKeepUUID )
+{
+    std::map<wxString, std::vector<LIB_ID>> libraries;
+
+    for( const LIB_ID& fpid : aFootprintIds )
+        libraries[ fpid.GetLibNickname() ].push_back( fpid );
+
+    thread_pool& tp = GetKiCadThreadPool();
+    std::vector<std::future<std::vector<std::pair<LIB_ID, FOOTPRINT*>>>> returns;
+
+    for( const auto& [nickname, fpids] : libraries )
+    {
+        returns.push_back( tp.submit_task(
+                [this, &nickname, &fpids, aKeepUUID]()
+                {
+                    std::vector<std::pair<LIB_ID, FOOTPRINT*>> loaded;
+
+                    for( const LIB_ID& fpid : fpids )
+                    {
+                        loaded.emplace_back( fpid, LoadFootprint( nickname, fpid.GetLibItemName(),
+                                                                  aKeepUUID ) );
+                    }
+
+                    return loaded;
+                } ) );
+    }
+
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> footprints;
+
+    for( std::future<std::vector<std::pair<LIB_ID, FOOTPRINT*>>>& ret : returns )
+    {
+        for( const auto& [fpid, footprint] : ret.get() )
+            footprints[ fpid ].reset( footprint );
+    }
+
+    return footprints;
+}
+
+
 FOOTPRINT_LIBRARY_ADAPTER::SAVE_T FOOTPRINT_LIBRARY_ADAPTER::SaveFootprint( const wxString& aNickname,
                                                                             const FOOTPRINT* aFootprint,
                                                                             bool aOverwrite )
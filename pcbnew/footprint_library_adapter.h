@@ -22,6 +22,10 @@
 #ifndef FOOTPRINT_LIBRARY_ADAPTER_H
 #define FOOTPRINT_LIBRARY_ADAPTER_H
 
+#include <map>
+#include <memory>
+#include <set>
+
 #include <lib_id.h>
 #include <libraries/library_manager.h>
 #include <pcb_io/pcb_io.h>
@@ -116,6 +120,18 @@ public:
      */
     FOOTPRINT* LoadFootprintWithOptionalNickname( const LIB_ID& aFootprintId, bool aKeepUUID );
 
+    /**
+     * Load each of @a aFootprintIds once, reading the libraries in parallel.  A library plugin
+     * is not reentrant, so all the footprints of one library are read by the same thread.
+     *
+     * @param aFootprintIds the footprints to load, which must all have a nickname.
+     * @param aKeepUUID see LoadFootprint().
+     * @return the loaded footprints, owned by the caller, or nullptr for the ones which can't
+     *         be found or read.
+     */
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> LoadFootprints( const std::set<LIB_ID>& aFootprintIds,
+                                                                 bool aKeepUUID );
+
     // TODO(JE) library tables - hoist out?
     /**
      * The set of return values from SaveSymbol() below.
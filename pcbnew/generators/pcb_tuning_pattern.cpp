@@ -41,6 +41,8 @@
 #include <scoped_set_reset.h>
 #include <core/mirror.h>
 #include <string_utils.h>
+#include <hash.h>
+#include <hash_eda.h>
 
 #include <board.h>
 #include <board_design_settings.h>
@@ -48,6 +50,13 @@
 #include <pcb_track.h>
 #include <pcb_shape.h>
 #include <pcb_group.h>
+#include <footprint.h>
+#include <netclass.h>
+#include <pad.h>
+#include <project.h>
+#include <project/project_file.h>
+#include <project/tuning_profiles.h>
+#include <zone.h>
 
 #include <tool/edit_points.h>
 #include <tool/tool_manager.h>
@@ -1344,6 +1353,284 @@ void PCB_TUNING_PATTERN::EditCancel( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD
 }
 
 
+static void hashMinOptMax( size_t& aHash, const MINOPTMAX<int>& aValue )
+{
+    hash_combine( aHash, aValue.HasMin(), aValue.Min(), aValue.HasOpt(), aValue.Opt(),
+                  aValue.HasMax(), aValue.Max() );
+}
+
+
+static size_t hashTrack( const PCB_TRACK* aTrack )
+{
+    size_t hash = hash_val( static_cast<int>( aTrack->Type() ), aTrack->GetStart(), aTrack->GetEnd(),
+                            aTrack->GetWidth(), static_cast<int>( aTrack->GetLayer() ),
+                            aTrack->GetNetCode() );
+
+    if( aTrack->Type() == PCB_ARC_T )
+    {
+        hash_combine( hash, static_cast<const PCB_ARC*>( aTrack )->GetMid() );
+    }
+    else if( aTrack->Type() == PCB_VIA_T )
+    {
+        const PCB_VIA* via = static_cast<const PCB_VIA*>( aTrack );
+
+        hash_combine( hash, static_cast<int>( via->TopLayer() ),
+                      static_cast<int>( via->BottomLayer() ), via->GetDrillValue() );
+    }
+
+    return hash;
+}
+
+
+static size_t hashDependency( const BOARD_ITEM* aItem )
+{
+    const BOX2I bbox = aItem->GetBoundingBox();
+
+    // The bounding box also covers what the hashes below leave out, e.g. the text of a text item
+    size_t hash = hash_val( static_cast<int>( aItem->Type() ), bbox.GetOrigin(), bbox.GetSize() );
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+        hash_combine( hash, hashTrack( static_cast<const PCB_TRACK*>( aItem ) ) );
+        break;
+
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+
+        hash_combine( hash, zone->GetDoNotAllowTracks(), zone->GetDoNotAllowVias(),
+                      zone->GetDoNotAllowPads(), zone->GetDoNotAllowFootprints(),
+                      std::hash<BASE_SET>()( zone->GetLayerSet() ) );
+
+        for( auto it = zone->Outline()->CIterate(); it; ++it )
+            hash_combine( hash, *it );
+
+        break;
+    }
+
+    default:
+        hash_combine( hash, hash_fp_item( aItem, HASH_POS | HASH_ROT | HASH_LAYER | HASH_NET
+                                                         | HASH_REF | HASH_VALUE ) );
+        break;
+    }
+
+    return hash;
+}
+
+
+static void hashStackup( size_t& aHash, const BOARD* aBoard )
+{
+    const BOARD_DESIGN_SETTINGS& bds = aBoard->GetDesignSettings();
+
+    hash_combine( aHash, aBoard->GetCopperLayerCount(), bds.GetBoardThickness() );
+
+    for( const BOARD_STACKUP_ITEM* item : bds.GetStackupDescriptor().GetList() )
+    {
+        hash_combine( aHash, static_cast<int>( item->GetType() ),
+                      static_cast<int>( item->GetBrdLayerId() ) );
+
+        for( int ii = 0; ii < item->GetSublayersCount(); ++ii )
+            hash_combine( aHash, item->GetThickness( ii ), item->GetEpsilonR( ii ) );
+    }
+}
+
+
+static void hashTuningProfile( size_t& aHash, const BOARD* aBoard, const NETCLASS* aNetClass )
+{
+    const PROJECT* project = aBoard->GetProject();
+
+    if( !project || !aNetClass )
+        return;
+
+    const wxString& profileName = aNetClass->GetTuningProfile();
+
+    for( const TUNING_PROFILE& profile :
+         project->GetProjectFile().TuningProfileParameters()->GetTuningProfiles() )
+    {
+        if( profile.m_ProfileName != profileName )
+            continue;
+
+        hash_combine( aHash, static_cast<int>( profile.m_Type ), profile.m_TargetImpedance,
+                      profile.m_EnableTimeDomainTuning, profile.m_ViaPropagationDelay );
+
+        for( const DELAY_PROFILE_TRACK_PROPAGATION_ENTRY& entry : profile.m_TrackPropagationEntries )
+        {
+            hash_combine( aHash, static_cast<int>( entry.GetSignalLayer() ),
+                          static_cast<int>( entry.GetTopReferenceLayer() ),
+                          static_cast<int>( entry.GetBottomReferenceLayer() ), entry.GetWidth(),
+                          entry.GetDiffPairGap(), entry.GetDelay( true ) );
+        }
+
+        for( const DELAY_PROFILE_VIA_OVERRIDE_ENTRY& entry : profile.m_ViaOverrides )
+        {
+            hash_combine( aHash, static_cast<int>( entry.m_SignalLayerFrom ),
+                          static_cast<int>( entry.m_SignalLayerTo ),
+                          static_cast<int>( entry.m_ViaLayerFrom ),
+                          static_cast<int>( entry.m_ViaLayerTo ), entry.m_Delay );
+        }
+
+        break;
+    }
+}
+
+
+size_t PCB_TUNING_PATTERN::GetRegenerationHash( BOARD* aBoard, GENERATOR_ITEM_INDEX& aIndex ) const
+{
+    if( !m_baseLine || m_baseLine->PointCount() < 2 )
+        return 0;
+
+    // The track under the origin, as found by snapToNearestTrack() when the pattern is updated
+    const PCB_TRACK* track = nullptr;
+    SEG::ecoord      minDist_sq = VECTOR2I::ECOORD_MAX;
+
+    aIndex.QueryArea( BOX2I( m_origin ).Inflate( 1 ),
+                      [&]( const BOARD_ITEM* aItem )
+                      {
+                          if( aItem->Type() != PCB_TRACE_T && aItem->Type() != PCB_ARC_T )
+                              return;
+
+                          const PCB_TRACK* candidate = static_cast<const PCB_TRACK*>( aItem );
+                          VECTOR2I         nearest;
+
+                          if( candidate->Type() == PCB_ARC_T )
+                          {
+                              const PCB_ARC* arc = static_cast<const PCB_ARC*>( candidate );
+
+                              nearest = SHAPE_ARC( arc->GetStart(), arc->GetMid(), arc->GetEnd(),
+                                                   arc->GetWidth() ).NearestPoint( m_origin );
+                          }
+                          else
+                          {
+                              nearest = SEG( candidate->GetStart(), candidate->GetEnd() )
+                                                .NearestPoint( m_origin );
+                          }
+
+                          SEG::ecoord dist_sq = ( nearest - m_origin ).SquaredEuclideanNorm();
+
+                          if( dist_sq < minDist_sq )
+                          {
+                              minDist_sq = dist_sq;
+                              track = candidate;
+                          }
+                      } );
+
+    // The origin is not on a track; let the pattern work out what to do
+    if( !track )
+        return 0;
+
+    NETINFO_ITEM* net = track->GetNet();
+    NETINFO_ITEM* coupledNet = nullptr;
+
+    if( m_tuningMode != SINGLE )
+        coupledNet = aBoard->DpCoupledNet( net );
+
+    size_t hash = hash_val( static_cast<int>( GetLayer() ), static_cast<int>( m_tuningMode ),
+                            m_origin, m_end, static_cast<int>( m_settings.m_initialSide ),
+                            m_settings.m_isTimeDomain, m_settings.m_overrideCustomRules,
+                            m_settings.m_minAmplitude, m_settings.m_maxAmplitude,
+                            m_settings.m_spacing, m_settings.m_cornerRadiusPercentage,
+                            m_settings.m_singleSided, static_cast<int>( m_settings.m_cornerStyle ) );
+
+    hashMinOptMax( hash, m_settings.m_targetLength );
+    hashMinOptMax( hash, m_settings.m_targetLengthDelay );
+    hashMinOptMax( hash, m_settings.m_targetSkew );
+    hashMinOptMax( hash, m_settings.m_targetSkewDelay );
+
+    for( const std::optional<SHAPE_LINE_CHAIN>* baseLine : { &m_baseLine, &m_baseLineCoupled } )
+    {
+        if( *baseLine )
+        {
+            for( const VECTOR2I& pt : ( *baseLine )->CPoints() )
+                hash_combine( hash, pt );
+        }
+    }
+
+    std::shared_ptr<DRC_ENGINE> drcEngine = aBoard->GetDesignSettings().m_DRCEngine;
+
+    // The rules are evaluated the same way as in ShowPropertiesDialog(), so that a rule edit
+    // only invalidates the patterns whose constraints it actually changes.
+    if( drcEngine )
+    {
+        std::vector<DRC_CONSTRAINT_T> constraintTypes = { CLEARANCE_CONSTRAINT,
+                                                          TRACK_WIDTH_CONSTRAINT,
+                                                          EDGE_CLEARANCE_CONSTRAINT,
+                                                          HOLE_CLEARANCE_CONSTRAINT };
+
+        if( m_tuningMode != SINGLE )
+            constraintTypes.push_back( DIFF_PAIR_GAP_CONSTRAINT );
+
+        if( !m_settings.m_overrideCustomRules )
+            constraintTypes.push_back( m_tuningMode == DIFF_PAIR_SKEW ? SKEW_CONSTRAINT
+                                                                      : LENGTH_CONSTRAINT );
+
+        for( DRC_CONSTRAINT_T constraintType : constraintTypes )
+        {
+            DRC_CONSTRAINT constraint = drcEngine->EvalRules( constraintType, track, nullptr,
+                                                              GetLayer() );
+
+            hash_combine( hash, static_cast<int>( constraintType ), constraint.IsNull(),
+                          constraint.GetOption( DRC_CONSTRAINT::OPTIONS::TIME_DOMAIN ) );
+            hashMinOptMax( hash, constraint.GetValue() );
+        }
+    }
+
+    // Lengths and delays of vias depend on the stackup, delays on the net's tuning profile
+    hashStackup( hash, aBoard );
+    hashTuningProfile( hash, aBoard, track->GetEffectiveNetClass() );
+
+    // Everything the meander placer sees: the whole of the tuned net(s), whose length is being
+    // matched, and anything close enough to be an obstacle (copper, board edges and rule
+    // areas, including the ones in footprints).  The per-item hashes are summed as the order
+    // of the items isn't stable.
+    std::unordered_set<const BOARD_ITEM*> tunedNetItems;
+    size_t                                itemsHash = 0;
+
+    for( const NETINFO_ITEM* tunedNet : { net, coupledNet } )
+    {
+        if( !tunedNet )
+            continue;
+
+        for( const BOARD_CONNECTED_ITEM* item : aIndex.NetItems( tunedNet->GetNetCode() ) )
+        {
+            tunedNetItems.insert( item );
+            itemsHash += hashDependency( item );
+        }
+    }
+
+    BOX2I area = getOutline().BBox();
+    area.Inflate( aBoard->GetMaxClearanceValue() + m_settings.m_maxAmplitude );
+
+    aIndex.QueryArea( area,
+                      [&]( const BOARD_ITEM* aItem )
+                      {
+                          if( tunedNetItems.count( aItem ) )
+                              return;
+
+                          size_t itemHash = hashDependency( aItem );
+
+                          // The router also honours pairwise clearance rules and the clearance
+                          // of the neighbour's net class, which the track alone doesn't show.
+                          if( drcEngine )
+                          {
+                              DRC_CONSTRAINT clearance = drcEngine->EvalRules( CLEARANCE_CONSTRAINT,
+                                                                               track, aItem,
+                                                                               GetLayer() );
+
+                              hash_combine( itemHash, clearance.IsNull() );
+                              hashMinOptMax( itemHash, clearance.GetValue() );
+                          }
+
+                          itemsHash += itemHash;
+                      } );
+
+    hash_combine( hash, itemsHash );
+    return hash;
+}
+
+
 bool PCB_TUNING_PATTERN::MakeEditPoints( EDIT_POINTS& aPoints ) const
 {
     VECTOR2I centerlineOffset;
@@ -141,6 +141,8 @@ public:
 
     void Remove( GENERATOR_TOOL* aTool, BOARD* aBoard, BOARD_COMMIT* aCommit ) override;
 
+    size_t GetRegenerationHash( BOARD* aBoard, GENERATOR_ITEM_INDEX& aIndex ) const override;
+
     bool MakeEditPoints( EDIT_POINTS& points ) const override;
 
     bool UpdateFromEditPoints( EDIT_POINTS& aEditPoints ) override;
@@ -42,6 +42,8 @@
 #include <string_utils.h>
 #include <pcbnew_settings.h>
 #include <pcb_edit_frame.h>
+#include <footprint_library_adapter.h>
+#include <project_pcb.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <connectivity/connectivity_data.h>
 #include <reporter.h>
@@ -54,6 +56,21 @@ BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBo
     m_frame( aFrame ),
     m_commit( aFrame ),
     m_board( aBoard )
+{
+    init();
+}
+
+
+BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( TOOL_MANAGER* aToolMgr, BOARD* aBoard ) :
+    m_frame( nullptr ),
+    m_commit( aToolMgr ),
+    m_board( aBoard )
+{
+    init();
+}
+
+
+void BOARD_NETLIST_UPDATER::init()
 {
     m_reporter = &NULL_REPORTER::GetInstance();
 
@@ -138,6 +155,104 @@ VECTOR2I BOARD_NETLIST_UPDATER::estimateFootprintInsertionPosition()
 }
 
 
+void BOARD_NETLIST_UPDATER::preloadFootprints( const std::vector<LIB_ID>& aFootprintIds )
+{
+    FOOTPRINT_LIBRARY_ADAPTER* adapter = PROJECT_PCB::FootprintLibAdapter( m_board->GetProject() );
+    std::set<LIB_ID>           fpids;
+
+    for( const LIB_ID& fpid : aFootprintIds )
+    {
+        // Footprints without a nickname are searched for in every library, so they are left
+        // to loadFootprint()
+        if( !fpid.GetLibNickname().empty() && !m_libraryFootprints.count( fpid ) )
+            fpids.insert( fpid );
+    }
+
+    if( !adapter || fpids.empty() )
+        return;
+
+    for( auto& [fpid, footprint] : adapter->LoadFootprints( fpids, false ) )
+        cacheLibraryFootprint( fpid, std::move( footprint ) );
+}
+
+
+void BOARD_NETLIST_UPDATER::cacheLibraryFootprint( const LIB_ID&              aFootprintId,
+                                                   std::unique_ptr<FOOTPRINT> aFootprint )
+{
+    // Prepared the same way as by PCB_BASE_FRAME::LoadFootprint()
+    if( aFootprint )
+    {
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+        aFootprint->ClearAllNets();
+        aFootprint->ApplyDefaultSettings( *m_board, bds.m_StyleFPFields, bds.m_StyleFPText,
+                                          bds.m_StyleFPShapes, bds.m_StyleFPDimensions,
+                                          bds.m_StyleFPBarcodes );
+    }
+
+    m_libraryFootprints[ aFootprintId ] = std::move( aFootprint );
+}
+
+
+FOOTPRINT* BOARD_NETLIST_UPDATER::loadFootprint( const LIB_ID& aFootprintId )
+{
+    if( !m_libraryFootprints.count( aFootprintId ) )
+    {
+        FOOTPRINT_LIBRARY_ADAPTER* adapter = PROJECT_PCB::FootprintLibAdapter( m_board->GetProject() );
+        std::unique_ptr<FOOTPRINT> footprint;
+
+        if( adapter )
+        {
+            try
+            {
+                footprint.reset( adapter->LoadFootprintWithOptionalNickname( aFootprintId, false ) );
+            }
+            catch( const IO_ERROR& )
+            {
+            }
+        }
+
+        cacheLibraryFootprint( aFootprintId, std::move( footprint ) );
+    }
+
+    const std::unique_ptr<FOOTPRINT>& libFootprint = m_libraryFootprints.at( aFootprintId );
+
+    if( !libFootprint )
+        return nullptr;
+
+    // Same as a library load: the instance gets new UUIDs
+    return static_cast<FOOTPRINT*>( libFootprint->Duplicate( IGNORE_PARENT_GROUP ) );
+}
+
+
+FOOTPRINT* BOARD_NETLIST_UPDATER::getUndoCopy( FOOTPRINT* aFootprint )
+{
+    if( m_commit.GetStatus( aFootprint ) )
+        return nullptr;
+
+    std::unique_ptr<FOOTPRINT>& copy = m_undoCopies[ aFootprint ];
+
+    if( !copy )
+    {
+        copy.reset( static_cast<FOOTPRINT*>( aFootprint->Clone() ) );
+        copy->SetParentGroup( nullptr );
+    }
+
+    return copy.get();
+}
+
+
+void BOARD_NETLIST_UPDATER::stageModified( FOOTPRINT* aFootprint )
+{
+    auto it = m_undoCopies.find( aFootprint );
+
+    wxCHECK( it != m_undoCopies.end(), /* void */ );
+
+    m_commit.Modified( aFootprint, it->second.release() );
+    m_undoCopies.erase( it );
+}
+
+
 FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent )
 {
     return addNewFootprint( aComponent, aComponent->GetFPID() );
@@ -157,7 +272,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent, const
         return nullptr;
     }
 
-    FOOTPRINT* footprint = m_frame->LoadFootprint( aFootprintId );
+    FOOTPRINT* footprint = loadFootprint( aFootprintId );
 
     if( footprint == nullptr )
     {
@@ -186,7 +301,8 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent, const
         for( PAD* pad : footprint->Pads() )
         {
             // Set the pads ratsnest settings to the global settings
-            pad->SetLocalRatsnestVisible( m_frame->GetPcbNewSettings()->m_Display.m_ShowGlobalRatsnest );
+            if( m_frame )
+                pad->SetLocalRatsnestVisible( m_frame->GetPcbNewSettings()->m_Display.m_ShowGlobalRatsnest );
 
             // Pads in the library all have orphaned nets.  Replace with Default.
             pad->SetNetCode( 0 );
@@ -239,14 +355,8 @@ bool BOARD_NETLIST_UPDATER::updateComponentClass( FOOTPRINT* aFootprint, COMPONE
     if( curClassName == newClassName )
         return false;
 
-    // Create a copy for undo if the footprint has not been added during this update
-    FOOTPRINT* copy = nullptr;
-
-    if( !m_isDryRun && !m_commit.GetStatus( aFootprint ) )
-    {
-        copy = static_cast<FOOTPRINT*>( aFootprint->Clone() );
-        copy->SetParentGroup( nullptr );
-    }
+    // Get a copy for undo if the footprint has not been added during this update
+    FOOTPRINT* copy = m_isDryRun ? nullptr : getUndoCopy( aFootprint );
 
     wxString msg;
 
@@ -302,7 +412,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentClass( FOOTPRINT* aFootprint, COMPONE
     m_reporter->Report( msg, RPT_SEVERITY_ACTION );
 
     if( copy )
-        m_commit.Modified( aFootprint, copy );
+        stageModified( aFootprint );
 
     return true;
 }
@@ -322,7 +432,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
         return nullptr;
     }
 
-    FOOTPRINT* newFootprint = m_frame->LoadFootprint( aNewComponent->GetFPID() );
+    FOOTPRINT* newFootprint = loadFootprint( aNewComponent->GetFPID() );
 
     if( newFootprint == nullptr )
     {
@@ -372,6 +482,12 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
             delete newFootprint;
             return nullptr;
         }
+        else if( !m_frame )
+        {
+            wxFAIL_MSG( wxT( "Exchanging footprints requires the board editor" ) );
+            delete newFootprint;
+            return nullptr;
+        }
         else
         {
              // Expand the footprint pad layers
@@ -396,14 +512,8 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
 {
     wxString msg;
 
-    // Create a copy only if the footprint has not been added during this update
-    FOOTPRINT* copy = nullptr;
-
-    if( !m_commit.GetStatus( aPcbFootprint ) )
-    {
-        copy = static_cast<FOOTPRINT*>( aPcbFootprint->Clone() );
-        copy->SetParentGroup( nullptr );
-    }
+    // Get a copy only if the footprint has not been added during this update
+    FOOTPRINT* copy = getUndoCopy( aPcbFootprint );
 
     bool       changed = false;
 
@@ -878,9 +988,7 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     }
 
     if( changed && copy )
-        m_commit.Modified( aPcbFootprint, copy );
-    else
-        delete copy;
+        stageModified( aPcbFootprint );
 
     return true;
 }
@@ -894,14 +1002,8 @@ bool BOARD_NETLIST_UPDATER::updateFootprintGroup( FOOTPRINT* aPcbFootprint,
 
     wxString msg;
 
-    // Create a copy only if the footprint has not been added during this update
-    FOOTPRINT* copy = nullptr;
-
-    if( !m_commit.GetStatus( aPcbFootprint ) )
-    {
-        copy = static_cast<FOOTPRINT*>( aPcbFootprint->Clone() );
-        copy->SetParentGroup( nullptr );
-    }
+    // Get a copy only if the footprint has not been added during this update
+    FOOTPRINT* copy = getUndoCopy( aPcbFootprint );
 
     bool changed = false;
 
@@ -991,9 +1093,7 @@ bool BOARD_NETLIST_UPDATER::updateFootprintGroup( FOOTPRINT* aPcbFootprint,
     }
 
     if( changed && copy )
-        m_commit.Modified( aPcbFootprint, copy );
-    else if( copy )
-        delete copy;
+        stageModified( aPcbFootprint );
 
     return changed;
 }
@@ -1004,14 +1104,8 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
 {
     wxString msg;
 
-    // Create a copy only if the footprint has not been added during this update
-    FOOTPRINT* copy = nullptr;
-
-    if( !m_isDryRun && !m_commit.GetStatus( aFootprint ) )
-    {
-        copy = static_cast<FOOTPRINT*>( aFootprint->Clone() );
-        copy->SetParentGroup( nullptr );
-    }
+    // Get a copy only if the footprint has not been added during this update
+    FOOTPRINT* copy = m_isDryRun ? nullptr : getUndoCopy( aFootprint );
 
     bool changed = false;
 
@@ -1025,9 +1119,25 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
                    return a->m_Uuid < b->m_Uuid;
                } );
 
+    // Map the pin names (stacked pins expanded) to their nets once, rather than searching the
+    // symbol pins for each pad.  The first net wins, as in COMPONENT::GetNet().
+    static const COMPONENT_NET                         noNet;
+    std::unordered_map<wxString, const COMPONENT_NET*> pinNets;
+
+    for( unsigned ii = 0; ii < aNewComponent->GetNetCount(); ii++ )
+    {
+        const COMPONENT_NET& net = aNewComponent->GetNet( ii );
+
+        pinNets.emplace( net.GetPinName(), &net );
+
+        for( const wxString& pinName : ExpandStackedPinNotation( net.GetPinName() ) )
+            pinNets.emplace( pinName, &net );
+    }
+
     for( PAD* pad : pads )
     {
-        const COMPONENT_NET& net = aNewComponent->GetNet( pad->GetNumber() );
+        auto                 pinNet = pinNets.find( pad->GetNumber() );
+        const COMPONENT_NET& net = pinNet != pinNets.end() ? *pinNet->second : noNet;
 
         wxLogTrace( wxT( "NETLIST_UPDATE" ),
                     wxT( "Processing pad %s of component %s" ),
@@ -1219,9 +1329,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
     }
 
     if( changed && copy )
-        m_commit.Modified( aFootprint, copy );
-    else if( copy )
-        delete copy;
+        stageModified( aFootprint );
 
     return true;
 }
@@ -1267,14 +1375,8 @@ bool BOARD_NETLIST_UPDATER::updateComponentUnits( FOOTPRINT* aFootprint, COMPONE
         return false; // no actual change on board during dry run
     }
 
-    // Create a copy only if the footprint has not been added during this update
-    FOOTPRINT* copy = nullptr;
-
-    if( !m_commit.GetStatus( aFootprint ) )
-    {
-        copy = static_cast<FOOTPRINT*>( aFootprint->Clone() );
-        copy->SetParentGroup( nullptr );
-    }
+    // Get a copy only if the footprint has not been added during this update
+    FOOTPRINT* copy = getUndoCopy( aFootprint );
 
     aFootprint->SetUnitInfo( newUnits );
 
@@ -1282,7 +1384,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentUnits( FOOTPRINT* aFootprint, COMPONE
     m_reporter->Report( msg, RPT_SEVERITY_ACTION );
 
     if( copy )
-        m_commit.Modified( aFootprint, copy );
+        stageModified( aFootprint );
 
     return true;
 }
@@ -1346,13 +1448,7 @@ void BOARD_NETLIST_UPDATER::applyComponentVariants( COMPONENT* aComponent,
         if( !footprint )
             continue;
 
-        FOOTPRINT* copy = nullptr;
-
-        if( !m_isDryRun && !m_commit.GetStatus( footprint ) )
-        {
-            copy = static_cast<FOOTPRINT*>( footprint->Clone() );
-            copy->SetParentGroup( nullptr );
-        }
+        FOOTPRINT* copy = m_isDryRun ? nullptr : getUndoCopy( footprint );
 
         bool changed = false;
 
@@ -1501,9 +1597,7 @@ void BOARD_NETLIST_UPDATER::applyComponentVariants( COMPONENT* aComponent,
         }
 
         if( !m_isDryRun && changed && copy )
-            m_commit.Modified( footprint, copy );
-        else
-            delete copy;
+            stageModified( footprint );
     }
 }
 
@@ -1845,7 +1939,6 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
 
 bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 {
-    FOOTPRINT* lastPreexistingFootprint = nullptr;
     COMPONENT* component = nullptr;
     wxString   msg;
     std::unordered_set<wxString> sheetPaths;
@@ -1857,8 +1950,104 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     std::map<COMPONENT*, FOOTPRINT*> footprintMap;
 
-    if( !m_board->Footprints().empty() )
-        lastPreexistingFootprint = m_board->Footprints().back();
+    // Index the footprints by symbol UUID or by reference, so each symbol finds its footprints
+    // without walking the whole board.  Footprints added by this update are staged in the
+    // commit and not on the board, so the list doesn't change while symbols are processed.
+    std::vector<FOOTPRINT*> boardFootprints( m_board->Footprints().begin(),
+                                             m_board->Footprints().end() );
+    std::unordered_map<KIID, std::vector<size_t>>     footprintsByUuid;
+    std::unordered_map<wxString, std::vector<size_t>> footprintsByRef;
+
+    for( size_t ii = 0; ii < boardFootprints.size(); ++ii )
+    {
+        FOOTPRINT* footprint = boardFootprints[ii];
+
+        if( m_lookupByTimestamp )
+        {
+            if( !footprint->GetPath().empty() )
+                footprintsByUuid[ footprint->GetPath().back() ].push_back( ii );
+        }
+        else
+        {
+            footprintsByRef[ footprint->GetReference().Lower() ].push_back( ii );
+        }
+    }
+
+    auto findMatchingFootprints =
+            [&]( COMPONENT* aComponent ) -> std::vector<FOOTPRINT*>
+            {
+                std::vector<size_t> matches;
+
+                if( m_lookupByTimestamp )
+                {
+                    for( const KIID& uuid : aComponent->GetKIIDs() )
+                    {
+                        auto it = footprintsByUuid.find( uuid );
+
+                        if( it == footprintsByUuid.end() )
+                            continue;
+
+                        KIID_PATH base = aComponent->GetPath();
+                        base.push_back( uuid );
+
+                        for( size_t ii : it->second )
+                        {
+                            if( boardFootprints[ii]->GetPath() == base )
+                                matches.push_back( ii );
+                        }
+                    }
+
+                    // Keep the board order
+                    std::sort( matches.begin(), matches.end() );
+                    matches.erase( std::unique( matches.begin(), matches.end() ), matches.end() );
+                }
+                else
+                {
+                    auto it = footprintsByRef.find( aComponent->GetReference().Lower() );
+
+                    if( it != footprintsByRef.end() )
+                        matches = it->second;
+                }
+
+                std::vector<FOOTPRINT*> footprints;
+                footprints.reserve( matches.size() );
+
+                for( size_t ii : matches )
+                    footprints.push_back( boardFootprints[ii] );
+
+                return footprints;
+            };
+
+    // Load the library footprints of the symbols which will need a new one up front, so that
+    // the libraries can be read in parallel
+    std::vector<LIB_ID> neededFpids;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( component->GetFPID().empty()
+                || component->GetProperties().count( wxT( "exclude_from_board" ) ) )
+        {
+            continue;
+        }
+
+        std::vector<FOOTPRINT*> matches = findMatchingFootprints( component );
+
+        if( !matches.empty() && !m_replaceFootprints )
+            continue;
+
+        if( std::none_of( matches.begin(), matches.end(),
+                          [&]( FOOTPRINT* aFootprint )
+                          {
+                              return aFootprint->GetFPID() == component->GetFPID();
+                          } ) )
+        {
+            neededFpids.push_back( component->GetFPID() );
+        }
+    }
+
+    preloadFootprints( neededFpids );
 
     cacheCopperZoneConnections();
 
@@ -1890,40 +2079,7 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
         const LIB_ID& baseFpid = component->GetFPID();
         const bool    hasBaseFpid = !baseFpid.empty();
-        std::vector<FOOTPRINT*> matchingFootprints;
-
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            bool match = false;
-
-            if( m_lookupByTimestamp )
-            {
-                for( const KIID& uuid : component->GetKIIDs() )
-                {
-                    KIID_PATH base = component->GetPath();
-                    base.push_back( uuid );
-
-                    if( footprint->GetPath() == base )
-                    {
-                        match = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
-            }
-
-            if( match )
-                matchingFootprints.push_back( footprint );
-
-            if( footprint == lastPreexistingFootprint )
-            {
-                // No sense going through the newly-created footprints: end of loop
-                break;
-            }
-        }
+        std::vector<FOOTPRINT*> matchingFootprints = findMatchingFootprints( component );
 
         std::vector<LIB_ID> expectedFpids;
         std::unordered_set<wxString> expectedFpidKeys;
@@ -2070,11 +2226,64 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
         if( !componentFootprints.empty() )
             applyComponentVariants( component, componentFootprints, baseFpid );
+
+        // Copies of footprints which didn't change
+        m_undoCopies.clear();
     }
 
     updateCopperZoneNets( aNetlist );
     updateGroups( aNetlist );
 
+    // Same lookups as NETLIST::GetComponentByPath() and NETLIST::GetComponentByReference()
+    std::unordered_map<KIID, std::vector<COMPONENT*>> componentsByUuid;
+    std::unordered_map<wxString, COMPONENT*>          componentsByRef;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( m_lookupByTimestamp )
+        {
+            for( const KIID& uuid : component->GetKIIDs() )
+                componentsByUuid[ uuid ].push_back( component );
+        }
+        else
+        {
+            componentsByRef.emplace( component->GetReference(), component );
+        }
+    }
+
+    auto findComponent =
+            [&]( FOOTPRINT* aFootprint ) -> COMPONENT*
+            {
+                if( m_lookupByTimestamp )
+                {
+                    const KIID_PATH& path = aFootprint->GetPath();
+
+                    if( path.empty() )
+                        return nullptr;
+
+                    auto it = componentsByUuid.find( path.back() );
+
+                    if( it == componentsByUuid.end() )
+                        return nullptr;
+
+                    KIID_PATH base = path;
+                    base.pop_back();
+
+                    for( COMPONENT* candidate : it->second )
+                    {
+                        if( candidate->GetPath() == base )
+                            return candidate;
+                    }
+
+                    return nullptr;
+                }
+
+                auto it = componentsByRef.find( aFootprint->GetReference() );
+                return it != componentsByRef.end() ? it->second : nullptr;
+            };
+
     // Finally go through the board footprints and update all those that *don't* have matching
     // component entries.
     //
@@ -2094,10 +2303,7 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         }
         else
         {
-            if( m_lookupByTimestamp )
-                component = aNetlist.GetComponentByPath( footprint->GetPath() );
-            else
-                component = aNetlist.GetComponentByReference( footprint->GetReference() );
+            component = findComponent( footprint );
 
             if( component && component->GetProperties().count( wxT( "exclude_from_board" ) ) == 0 )
             {
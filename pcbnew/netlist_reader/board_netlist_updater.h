@@ -35,8 +35,14 @@ class NETLIST;
 class COMPONENT;
 class FOOTPRINT;
 class PCB_EDIT_FRAME;
+class TOOL_MANAGER;
 
 #include <board_commit.h>
+#include <lib_id.h>
+
+#include <map>
+#include <memory>
+#include <unordered_map>
 
 /**
  * Update the #BOARD with a new netlist.
@@ -66,6 +72,13 @@ class BOARD_NETLIST_UPDATER
 {
 public:
     BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBoard );
+
+    /**
+     * Update \a aBoard without an editor frame, committing through \a aToolMgr.  Footprints
+     * can be added, but not exchanged.
+     */
+    BOARD_NETLIST_UPDATER( TOOL_MANAGER* aToolMgr, BOARD* aBoard );
+
     ~BOARD_NETLIST_UPDATER();
 
     /**
@@ -100,6 +113,8 @@ public:
     std::vector<FOOTPRINT*> GetAddedFootprints() const { return m_addedFootprints; }
 
 private:
+    void init();
+
     void cacheNetname( PAD* aPad, const wxString& aNetname );
     wxString getNetname( PAD* aPad );
 
@@ -108,6 +123,38 @@ private:
 
     VECTOR2I estimateFootprintInsertionPosition();
 
+    /**
+     * Load the library footprints \a aFootprintIds which are not cached yet, reading the
+     * libraries in parallel.
+     */
+    void preloadFootprints( const std::vector<LIB_ID>& aFootprintIds );
+
+    /**
+     * Return a new instance of the library footprint \a aFootprintId, or nullptr if it can't
+     * be found.  Each library footprint is only loaded once per update.
+     */
+    FOOTPRINT* loadFootprint( const LIB_ID& aFootprintId );
+
+    /**
+     * Prepare the library footprint \a aFootprint for the board and cache it, nullptr
+     * meaning it wasn't found.
+     */
+    void cacheLibraryFootprint( const LIB_ID& aFootprintId, std::unique_ptr<FOOTPRINT> aFootprint );
+
+    /**
+     * Return the undo copy of \a aFootprint, taking it on first use, or nullptr if the
+     * footprint is already in the commit.
+     *
+     * The copy is shared by all the update steps of the footprint, so a footprint which needs
+     * no change is only cloned once.
+     */
+    FOOTPRINT* getUndoCopy( FOOTPRINT* aFootprint );
+
+    /**
+     * Stage \a aFootprint as modified in the commit, with the copy from getUndoCopy().
+     */
+    void stageModified( FOOTPRINT* aFootprint );
+
     FOOTPRINT* addNewFootprint( COMPONENT* aComponent );
     FOOTPRINT* addNewFootprint( COMPONENT* aComponent, const LIB_ID& aFootprintId );
 
@@ -148,6 +195,9 @@ private:
     std::vector<FOOTPRINT*>            m_addedFootprints;
     std::map<wxString, NETINFO_ITEM*>  m_addedNets;
 
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>>               m_libraryFootprints; // null if not found
+    std::unordered_map<FOOTPRINT*, std::unique_ptr<FOOTPRINT>> m_undoCopies;
+
     bool m_deleteUnusedFootprints;
     bool m_isDryRun;
     bool m_replaceFootprints;
@@ -39,6 +39,7 @@ using namespace std::placeholders;
 #include <board.h>
 #include <footprint.h>
 #include <spread_footprints.h>
+#include <connectivity/connectivity_data.h>
 #include <ratsnest/ratsnest_data.h>
 #include <pcb_io/pcb_io_mgr.h>
 #include "board_netlist_updater.h"
@@ -145,6 +146,17 @@ void PCB_EDIT_FRAME::OnNetlistChanged( BOARD_NETLIST_UPDATER& aUpdater, bool* aR
 
     SpreadFootprints( &newFootprints, { 0, 0 }, true );
 
+    // The spread moves the footprints outside of any commit: refresh their connectivity and
+    // queue their view updates in one pass.  The ratsnest itself is rebuilt once, below.
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = GetBoard()->GetConnectivity();
+    KIGFX::VIEW*                       view = GetCanvas()->GetView();
+
+    for( FOOTPRINT* footprint : newFootprints )
+    {
+        connectivity->Update( footprint );
+        view->Update( footprint );
+    }
+
     // Start drag command for new footprints
     if( !newFootprints.empty() )
     {
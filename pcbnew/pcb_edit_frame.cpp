@@ -1592,6 +1592,9 @@ void PCB_EDIT_FRAME::ShowBoardSetupDialog( const wxString& aInitialPage, wxWindo
         TOOL_EVENT toolEvent( TC_COMMAND, TA_MODEL_CHANGE, AS_ACTIVE );
         toolEvent.SetHasPosition( false );
         m_toolManager->ProcessEvent( toolEvent );
+
+        // Rule, net class and stackup changes move the generators' targets and clearances
+        m_toolManager->RunAction( PCB_ACTIONS::regenerateOutdated );
     }
 
     GetCanvas()->SetFocus();
@@ -1825,6 +1828,9 @@ void PCB_EDIT_FRAME::OnBoardLoaded()
 
     GetBoard()->InitializeClearanceCache();
 
+    // The generators were saved regenerated; remember what they were regenerated against
+    m_toolManager->GetTool<GENERATOR_TOOL>()->RecordRegenerationHashes();
+
     UpdateTitle();
 
     // Display a warning that the file is read only
@@ -25,6 +25,149 @@
 #include "pcb_generator.h"
 
 #include <board.h>
+#include <footprint.h>
+#include <macros.h>
+#include <pad.h>
+#include <pcb_field.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <geometry/rtree.h>
+
+
+struct GENERATOR_ITEM_INDEX::ITEM_TREE : public RTree<const BOARD_ITEM*, int, 2, double>
+{
+};
+
+
+GENERATOR_ITEM_INDEX::GENERATOR_ITEM_INDEX( BOARD* aBoard ) :
+        m_board( aBoard ),
+        m_valid( false ),
+        m_tree( std::make_unique<ITEM_TREE>() )
+{
+}
+
+
+GENERATOR_ITEM_INDEX::~GENERATOR_ITEM_INDEX()
+{
+}
+
+
+void GENERATOR_ITEM_INDEX::build()
+{
+    std::vector<std::pair<ITEM_TREE::Rect, const BOARD_ITEM*>> entries;
+
+    m_netItems.clear();
+
+    auto add =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                const BOX2I bbox = aItem->GetBoundingBox();
+
+                entries.push_back( { { { bbox.GetX(), bbox.GetY() },
+                                       { bbox.GetRight(), bbox.GetBottom() } },
+                                     aItem } );
+
+                if( aItem->Type() == PCB_PAD_T || aItem->Type() == PCB_TRACE_T
+                        || aItem->Type() == PCB_ARC_T || aItem->Type() == PCB_VIA_T )
+                {
+                    const BOARD_CONNECTED_ITEM* item = static_cast<const BOARD_CONNECTED_ITEM*>( aItem );
+                    m_netItems[item->GetNetCode()].push_back( item );
+                }
+            };
+
+    // The same items as the router syncs into its world
+    auto addGraphic =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                switch( aItem->Type() )
+                {
+                case PCB_FIELD_T:
+                    if( !static_cast<const PCB_FIELD*>( aItem )->IsVisible() )
+                        return;
+
+                    KI_FALLTHROUGH;
+
+                case PCB_SHAPE_T:
+                case PCB_TEXT_T:
+                case PCB_TEXTBOX_T:
+                case PCB_TABLE_T:
+                    if( aItem->IsOnCopperLayer() || aItem->GetLayer() == Edge_Cuts
+                            || aItem->GetLayer() == Margin )
+                    {
+                        add( aItem );
+                    }
+
+                    break;
+
+                default:
+                    break;
+                }
+            };
+
+    auto addRuleArea =
+            [&]( const ZONE* aZone )
+            {
+                if( aZone->GetIsRuleArea() && aZone->HasKeepoutParametersSet() )
+                    add( aZone );
+            };
+
+    for( const BOARD_ITEM* item : m_board->Drawings() )
+        addGraphic( item );
+
+    for( const ZONE* zone : m_board->Zones() )
+        addRuleArea( zone );
+
+    for( const FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( const PAD* pad : footprint->Pads() )
+            add( pad );
+
+        for( const PCB_FIELD* field : footprint->GetFields() )
+            addGraphic( field );
+
+        for( const BOARD_ITEM* item : footprint->GraphicalItems() )
+            addGraphic( item );
+
+        for( const ZONE* zone : footprint->Zones() )
+            addRuleArea( zone );
+    }
+
+    for( const PCB_TRACK* track : m_board->Tracks() )
+        add( track );
+
+    m_tree->BulkLoad( entries );
+    m_valid = true;
+}
+
+
+void GENERATOR_ITEM_INDEX::QueryArea( const BOX2I& aArea,
+                                      const std::function<void( const BOARD_ITEM* )>& aFunction )
+{
+    if( !m_valid )
+        build();
+
+    const int mmin[2] = { aArea.GetX(), aArea.GetY() };
+    const int mmax[2] = { aArea.GetRight(), aArea.GetBottom() };
+
+    m_tree->Search( mmin, mmax,
+                    [&]( const BOARD_ITEM* aItem ) -> bool
+                    {
+                        aFunction( aItem );
+                        return true;
+                    } );
+}
+
+
+const std::vector<const BOARD_CONNECTED_ITEM*>& GENERATOR_ITEM_INDEX::NetItems( int aNetCode )
+{
+    static const std::vector<const BOARD_CONNECTED_ITEM*> empty;
+
+    if( !m_valid )
+        build();
+
+    auto it = m_netItems.find( aNetCode );
+    return it != m_netItems.end() ? it->second : empty;
+}
 
 
 PCB_GENERATOR::PCB_GENERATOR( BOARD_ITEM* aParent, PCB_LAYER_ID aLayer ) :
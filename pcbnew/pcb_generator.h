@@ -26,7 +26,11 @@
 #define GENERATOR_H_
 
 
+#include <functional>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <string_any_map.h>
 
 #include <lset.h>
@@ -35,11 +39,51 @@
 class EDIT_POINTS;
 class BOARD;
 class BOARD_ITEM;
+class BOARD_CONNECTED_ITEM;
 class PCB_BASE_EDIT_FRAME;
 class GENERATOR_TOOL;
 class STATUS_MIN_MAX_POPUP;
 
 
+/**
+ * The board items which generated items can depend on (tracks, pads, copper and board edge
+ * graphics and rule areas), indexed by bounding box and by net.
+ *
+ * It is shared by the generators of a regeneration pass so that each of them only visits the
+ * items around it.  The index is built on first use and must be invalidated when the board
+ * changes.
+ */
+class GENERATOR_ITEM_INDEX
+{
+public:
+    GENERATOR_ITEM_INDEX( BOARD* aBoard );
+    ~GENERATOR_ITEM_INDEX();
+
+    void Invalidate() { m_valid = false; }
+
+    /**
+     * Call \a aFunction for each indexed item whose bounding box intersects \a aArea.
+     */
+    void QueryArea( const BOX2I& aArea, const std::function<void( const BOARD_ITEM* )>& aFunction );
+
+    /**
+     * @return the indexed tracks and pads of the net \a aNetCode.
+     */
+    const std::vector<const BOARD_CONNECTED_ITEM*>& NetItems( int aNetCode );
+
+private:
+    struct ITEM_TREE;
+
+    void build();
+
+    BOARD*                     m_board;
+    bool                       m_valid;
+    std::unique_ptr<ITEM_TREE> m_tree;
+
+    std::unordered_map<int, std::vector<const BOARD_CONNECTED_ITEM*>> m_netItems;
+};
+
+
 class PCB_GENERATOR : public PCB_GROUP
 {
 public:
@@ -104,6 +148,27 @@ public:
     virtual wxString GetPluralName() const = 0;
     virtual wxString GetCommitMessage() const = 0;
 
+    /**
+     * Return a hash of everything the generated items depend on: the generator's own settings,
+     * the rules which apply to it and the board items around it.
+     *
+     * An automatic regeneration is skipped when this still matches GetRegeneratedHash().
+     * Returns 0 when the generator can't tell, in which case only an explicit regeneration
+     * updates it.
+     *
+     * @param aIndex holds the items of \a aBoard, to look up the ones around the generator.
+     */
+    virtual size_t GetRegenerationHash( BOARD* aBoard, GENERATOR_ITEM_INDEX& aIndex ) const
+    {
+        return 0;
+    }
+
+    /**
+     * The regeneration hash recorded after the last regeneration (not saved to file).
+     */
+    size_t GetRegeneratedHash() const { return m_regeneratedHash; }
+    void   SetRegeneratedHash( size_t aHash ) { m_regeneratedHash = aHash; }
+
 #if defined(DEBUG)
     void Show( int nestLevel, std::ostream& os ) const override { ShowDummy( os ); }
 #endif
@@ -122,6 +187,8 @@ protected:
 
     VECTOR2I m_origin;
 
+    size_t   m_regeneratedHash = 0;
+
 #ifdef GENERATOR_ORDER
     int m_updateOrder = 0;
 #endif
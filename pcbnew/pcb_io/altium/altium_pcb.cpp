@@ -2954,7 +2954,7 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_PCB_COMPOUND_FILE&     aAltiumP
             }
 
             if( zone->HasFilledPolysForLayer( klayer ) )
-                fill.BooleanAdd( *zone->GetFill( klayer ) );
+                fill.BooleanAdd( *zone->GetFilledPolysList( klayer ) );
 
             fill.Fracture();
 
@@ -2186,14 +2186,16 @@ void CADSTAR_PCB_ARCHIVE_LOADER::loadCoppers()
                 fill.Inflate( copperWidth / 2, CORNER_STRATEGY::ROUND_ALL_CORNERS, ARC_HIGH_DEF );
             }
 
-            if( pouredZone->HasFilledPolysForLayer( getKiCadLayer( csCopper.LayerID ) ) )
+            PCB_LAYER_ID copperLayer = getKiCadLayer( csCopper.LayerID );
+
+            if( pouredZone->HasFilledPolysForLayer( copperLayer ) )
             {
-                fill.BooleanAdd( *pouredZone->GetFill( getKiCadLayer( csCopper.LayerID ) ) );
+                fill.BooleanAdd( *pouredZone->GetFilledPolysList( copperLayer ) );
             }
 
             fill.Fracture();
 
-            pouredZone->SetFilledPolysList( getKiCadLayer( csCopper.LayerID ), fill );
+            pouredZone->SetFilledPolysList( copperLayer, fill );
             pouredZone->SetIsFilled( true );
             pouredZone->SetNeedRefill( false );
             continue;
@@ -8346,7 +8346,7 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
             SHAPE_POLY_SET layerFill;
 
             if( zone->HasFilledPolysForLayer( layer ) )
-                layerFill = SHAPE_POLY_SET( *zone->GetFill( layer ) );
+                layerFill = SHAPE_POLY_SET( *zone->GetFilledPolysList( layer ) );
 
             for( const auto& seg : segments )
             {
@@ -26,6 +26,7 @@
 #include <wx/uri.h>
 
 #include <config.h>
+#include <core/trace_events.h>
 #include <kiway_player.h>
 #include <wildcards_and_files_ext.h>
 #include <libraries/library_table.h>
@@ -168,6 +169,7 @@ BOARD* PCB_IO_MGR::Load( PCB_FILE_T aFileType, const wxString& aFileName, BOARD*
                      const std::map<std::string, UTF8>* aProperties, PROJECT* aProject,
                      PROGRESS_REPORTER* aProgressReporter )
 {
+    TRACE_ZONE          traceZone( "Load board", "io" );
     IO_RELEASER<PCB_IO> pi( FindPlugin( aFileType ) );
 
     if( pi )  // test pi->plugin
@@ -183,6 +185,7 @@ BOARD* PCB_IO_MGR::Load( PCB_FILE_T aFileType, const wxString& aFileName, BOARD*
 void PCB_IO_MGR::Save( PCB_FILE_T aFileType, const wxString& aFileName, BOARD* aBoard,
                    const std::map<std::string, UTF8>* aProperties )
 {
+    TRACE_ZONE          traceZone( "Save board", "io" );
     IO_RELEASER<PCB_IO> pi( FindPlugin( aFileType ) );
 
     if( pi )
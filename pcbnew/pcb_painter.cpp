@@ -596,7 +596,9 @@ PCB_PAINTER::PCB_PAINTER( GAL* aGal, FRAME_T aFrameType ) :
     m_frameType( aFrameType ),
     m_maxError( ARC_HIGH_DEF ),
     m_holePlatingThickness( 0 ),
-    m_lockedShadowMargin( 0 )
+    m_lockedShadowMargin( 0 ),
+    m_padLabelCacheBoard( nullptr ),
+    m_padLabelCacheTimeStamp( 0 )
 {
 }
 
@@ -1323,82 +1325,110 @@ void PCB_PAINTER::draw( const PCB_VIA* aVia, int aLayer )
 }
 
 
-void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
+const PCB_PAINTER::PAD_LABEL_LAYOUT& PCB_PAINTER::getPadLabelLayout( const PAD* aPad,
+                                                                     PCB_LAYER_ID aLayer )
 {
-    COLOR4D      color = m_pcbSettings.GetColor( aPad, aLayer );
-    const int    copperLayer = IsPadCopperLayer( aLayer ) ? aLayer - LAYER_PAD_COPPER_START : aLayer;
-    PCB_LAYER_ID pcbLayer = static_cast<PCB_LAYER_ID>( copperLayer );
+    PCBNEW_SETTINGS::DISPLAY_OPTIONS* displayOpts = pcbconfig() ? &pcbconfig()->m_Display : nullptr;
+    const bool   isCvpcb = dynamic_cast<CVPCB_SETTINGS*>( viewer_settings() ) != nullptr;
+    const bool   showPadNumbers = viewer_settings()->m_ViewersDisplay.m_DisplayPadNumbers;
+    const int    netNames = ( displayOpts && !isCvpcb ) ? displayOpts->m_NetNames : -1;
+    const int    displayMode = ( netNames + 1 ) * 4 + ( isCvpcb ? 2 : 0 ) + ( showPadNumbers ? 1 : 0 );
+    const BOARD* board = aPad->GetBoard();
 
-    if( IsNetnameLayer( aLayer ) )
+    // Pads in pad edit mode take their label box from the footprint's graphic items, which
+    // can be edited without moving the pad
+    if( !board || aPad->IsEntered() )
     {
-        PCBNEW_SETTINGS::DISPLAY_OPTIONS* displayOpts = pcbconfig() ? &pcbconfig()->m_Display : nullptr;
-        wxString                          netname;
-        wxString                          padNumber;
+        computePadLabelLayout( aPad, aLayer, displayMode, m_uncachedPadLabel );
+        return m_uncachedPadLabel;
+    }
 
-        if( viewer_settings()->m_ViewersDisplay.m_DisplayPadNumbers )
-        {
-            padNumber = UnescapeString( aPad->GetNumber() );
+    // Any board modification (including a net rename) bumps the time stamp, which also takes
+    // care of deleted pads whose address gets reused.
+    if( board != m_padLabelCacheBoard || board->GetTimeStamp() != m_padLabelCacheTimeStamp )
+    {
+        m_padLabelCache.clear();
+        m_padLabelCacheBoard = board;
+        m_padLabelCacheTimeStamp = board->GetTimeStamp();
+    }
 
-            if( dynamic_cast<CVPCB_SETTINGS*>( viewer_settings() ) )
-                netname = aPad->GetPinFunction();
-        }
+    auto [it, inserted] = m_padLabelCache.try_emplace( { aPad, aLayer } );
+    PAD_LABEL_LAYOUT& layout = it->second;
 
-        if( displayOpts && !dynamic_cast<CVPCB_SETTINGS*>( viewer_settings() ) )
-        {
-            if( displayOpts->m_NetNames == 1 || displayOpts->m_NetNames == 3 )
-                netname = aPad->GetDisplayNetname();
+    // Pads being moved, rotated or resized (e.g. with the point editor) are only committed at
+    // the end of the operation
+    if( inserted || layout.m_displayMode != displayMode || layout.m_padPos != aPad->GetPosition()
+        || layout.m_padAngle != aPad->GetOrientation()
+        || layout.m_padBBox != aPad->GetBoundingBox()
+        || layout.m_padShape != aPad->GetShape( aLayer )
+        || layout.m_padSize != aPad->GetSize( aLayer )
+        || layout.m_padOffset != aPad->GetOffset( aLayer ) )
+    {
+        computePadLabelLayout( aPad, aLayer, displayMode, layout );
+    }
 
-            if( aPad->IsNoConnectPad() )
-                netname = wxT( "x" );
-            else if( aPad->IsFreePad() )
-                netname = wxT( "*" );
-        }
+    return layout;
+}
 
-        if( netname.IsEmpty() && padNumber.IsEmpty() )
-            return;
 
-        BOX2I    padBBox = aPad->GetBoundingBox();
-        VECTOR2D position = padBBox.Centre();
-        VECTOR2D padsize = VECTOR2D( padBBox.GetSize() );
+void PCB_PAINTER::computePadLabelLayout( const PAD* aPad, PCB_LAYER_ID aLayer, int aDisplayMode,
+                                         PAD_LABEL_LAYOUT& aLayout )
+{
+    PCBNEW_SETTINGS::DISPLAY_OPTIONS* displayOpts = pcbconfig() ? &pcbconfig()->m_Display : nullptr;
+    wxString                          netname;
+    wxString                          padNumber;
 
-        if( aPad->IsEntered() )
-        {
-            FOOTPRINT* fp = aPad->GetParentFootprint();
+    aLayout.m_padPos = aPad->GetPosition();
+    aLayout.m_padAngle = aPad->GetOrientation();
+    aLayout.m_padBBox = aPad->GetBoundingBox();
+    aLayout.m_padShape = aPad->GetShape( aLayer );
+    aLayout.m_padSize = aPad->GetSize( aLayer );
+    aLayout.m_padOffset = aPad->GetOffset( aLayer );
+    aLayout.m_displayMode = aDisplayMode;
+    aLayout.m_netname.clear();
+    aLayout.m_padNumber.clear();
 
-            // Find the number box
-            for( const BOARD_ITEM* aItem : fp->GraphicalItems() )
-            {
-                if( aItem->Type() == PCB_SHAPE_T )
-                {
-                    const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+    if( viewer_settings()->m_ViewersDisplay.m_DisplayPadNumbers )
+    {
+        padNumber = UnescapeString( aPad->GetNumber() );
 
-                    if( shape->IsProxyItem() && shape->GetShape() == SHAPE_T::RECTANGLE )
-                    {
-                        position = shape->GetCenter();
-                        padsize = shape->GetBotRight() - shape->GetTopLeft();
+        if( dynamic_cast<CVPCB_SETTINGS*>( viewer_settings() ) )
+            netname = aPad->GetPinFunction();
+    }
 
-                        // We normally draw a bit outside the pad, but this will be somewhat
-                        // unexpected when the user has drawn a box.
-                        padsize *= 0.9;
+    if( displayOpts && !dynamic_cast<CVPCB_SETTINGS*>( viewer_settings() ) )
+    {
+        if( displayOpts->m_NetNames == 1 || displayOpts->m_NetNames == 3 )
+            netname = aPad->GetDisplayNetname();
 
-                        break;
-                    }
-                }
-            }
-        }
-        else if( aPad->GetShape( pcbLayer ) == PAD_SHAPE::CUSTOM )
+        if( aPad->IsNoConnectPad() )
+            netname = wxT( "x" );
+        else if( aPad->IsFreePad() )
+            netname = wxT( "*" );
+    }
+
+    if( netname.IsEmpty() && padNumber.IsEmpty() )
+        return;
+
+    BOX2I    padBBox = aPad->GetBoundingBox();
+    VECTOR2D position = padBBox.Centre();
+    VECTOR2D padsize = VECTOR2D( padBBox.GetSize() );
+
+    if( aPad->IsEntered() )
+    {
+        FOOTPRINT* fp = aPad->GetParentFootprint();
+
+        // Find the number box
+        for( const BOARD_ITEM* aItem : fp->GraphicalItems() )
         {
-            // See if we have a number box
-            for( const std::shared_ptr<PCB_SHAPE>& primitive : aPad->GetPrimitives( pcbLayer ) )
+            if( aItem->Type() == PCB_SHAPE_T )
             {
-                if( primitive->IsProxyItem() && primitive->GetShape() == SHAPE_T::RECTANGLE )
-                {
-                    position = primitive->GetCenter();
-                    RotatePoint( position, aPad->GetOrientation() );
-                    position += aPad->ShapePos( pcbLayer );
+                const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
 
-                    padsize.x = abs( primitive->GetBotRight().x - primitive->GetTopLeft().x );
-                    padsize.y = abs( primitive->GetBotRight().y - primitive->GetTopLeft().y );
+                if( shape->IsProxyItem() && shape->GetShape() == SHAPE_T::RECTANGLE )
+                {
+                    position = shape->GetCenter();
+                    padsize = shape->GetBotRight() - shape->GetTopLeft();
 
                     // We normally draw a bit outside the pad, but this will be somewhat
                     // unexpected when the user has drawn a box.
@@ -1408,37 +1438,141 @@ void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
                 }
             }
         }
-
-        if( aPad->GetShape( pcbLayer ) != PAD_SHAPE::CUSTOM )
+    }
+    else if( aPad->GetShape( aLayer ) == PAD_SHAPE::CUSTOM )
+    {
+        // See if we have a number box
+        for( const std::shared_ptr<PCB_SHAPE>& primitive : aPad->GetPrimitives( aLayer ) )
         {
-            // Don't allow a 45° rotation to bloat a pad's bounding box unnecessarily
-            double limit = std::min( aPad->GetSize( pcbLayer ).x,
-                                     aPad->GetSize( pcbLayer ).y ) * 1.1;
-
-            if( padsize.x > limit && padsize.y > limit )
+            if( primitive->IsProxyItem() && primitive->GetShape() == SHAPE_T::RECTANGLE )
             {
-                padsize.x = limit;
-                padsize.y = limit;
+                position = primitive->GetCenter();
+                RotatePoint( position, aPad->GetOrientation() );
+                position += aPad->ShapePos( aLayer );
+
+                padsize.x = abs( primitive->GetBotRight().x - primitive->GetTopLeft().x );
+                padsize.y = abs( primitive->GetBotRight().y - primitive->GetTopLeft().y );
+
+                // We normally draw a bit outside the pad, but this will be somewhat
+                // unexpected when the user has drawn a box.
+                padsize *= 0.9;
+
+                break;
             }
         }
+    }
 
-        double maxSize = PCB_RENDER_SETTINGS::MAX_FONT_SIZE;
-        double size = padsize.y;
+    if( aPad->GetShape( aLayer ) != PAD_SHAPE::CUSTOM )
+    {
+        // Don't allow a 45° rotation to bloat a pad's bounding box unnecessarily
+        double limit = std::min( aPad->GetSize( aLayer ).x,
+                                 aPad->GetSize( aLayer ).y ) * 1.1;
 
-        m_gal->Save();
-        m_gal->Translate( position );
+        if( padsize.x > limit && padsize.y > limit )
+        {
+            padsize.x = limit;
+            padsize.y = limit;
+        }
+    }
 
-        // Keep the size ratio for the font, but make it smaller
-        if( padsize.x < ( padsize.y * 0.95 ) )
+    double maxSize = PCB_RENDER_SETTINGS::MAX_FONT_SIZE;
+    double size = padsize.y;
+
+    // The labels are drawn relative to the center of the pad's bounding box
+    aLayout.m_center = position;
+    aLayout.m_vertical = false;
+
+    // Keep the size ratio for the font, but make it smaller
+    if( padsize.x < ( padsize.y * 0.95 ) )
+    {
+        aLayout.m_vertical = true;
+        size = padsize.x;
+        std::swap( padsize.x, padsize.y );
+    }
+
+    // Font size limits
+    if( size > maxSize )
+        size = maxSize;
+
+    // Divide the space, to display both pad numbers and netnames and set the Y text
+    // offset position to display 2 lines
+    int Y_offset_numpad = 0;
+    int Y_offset_netname = 0;
+
+    if( !netname.IsEmpty() && !padNumber.IsEmpty() )
+    {
+        // The magic numbers are defined experimentally for a better look.
+        size = size / 2.5;
+        Y_offset_netname = size / 1.4;  // netname size is usually smaller than num pad
+                                        // so the offset can be smaller
+        Y_offset_numpad = size / 1.7;
+    }
+
+    // We are using different fonts to display names, depending on the graphic
+    // engine (OpenGL or Cairo).
+    // Xscale_for_stroked_font adjust the text X size for cairo (stroke fonts) engine
+    const double Xscale_for_stroked_font = 0.9;
+
+    if( !netname.IsEmpty() )
+    {
+        // approximate the size of net name text:
+        // We use a size for at least 5 chars, to give a good look even for short names
+        // (like VCC, GND...)
+        double tsize = 1.5 * padsize.x / std::max( PrintableCharCount( netname )+1, 5 );
+        tsize = std::min( tsize, size );
+
+        // Use a smaller text size to handle interline, pen size...
+        tsize *= 0.85;
+
+        // Round and oval pads have less room to display the net name than other
+        // (i.e RECT) shapes, so reduce the text size for these shapes
+        if( aPad->GetShape( aLayer ) == PAD_SHAPE::CIRCLE
+            || aPad->GetShape( aLayer ) == PAD_SHAPE::OVAL )
         {
-            m_gal->Rotate( -ANGLE_90.AsRadians() );
-            size = padsize.x;
-            std::swap( padsize.x, padsize.y );
+            tsize *= 0.9;
         }
 
-        // Font size limits
-        if( size > maxSize )
-            size = maxSize;
+        aLayout.m_netname = netname;
+        aLayout.m_netnameSize = VECTOR2D( tsize*Xscale_for_stroked_font, tsize );
+        aLayout.m_netnameOffset = (int) std::min( tsize * 1.4, double( Y_offset_netname ) );
+    }
+
+    if( !padNumber.IsEmpty() )
+    {
+        // approximate the size of the pad number text:
+        // We use a size for at least 3 chars, to give a good look even for short numbers
+        double tsize = 1.5 * padsize.x / std::max( PrintableCharCount( padNumber ), 3 );
+        tsize = std::min( tsize, size );
+
+        // Use a smaller text size to handle interline, pen size...
+        tsize *= 0.85;
+        tsize = std::min( tsize, size );
+
+        aLayout.m_padNumber = padNumber;
+        aLayout.m_padNumberSize = VECTOR2D( tsize*Xscale_for_stroked_font, tsize );
+        aLayout.m_padNumberOffset = -Y_offset_numpad;
+    }
+}
+
+
+void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
+{
+    COLOR4D      color = m_pcbSettings.GetColor( aPad, aLayer );
+    const int    copperLayer = IsPadCopperLayer( aLayer ) ? aLayer - LAYER_PAD_COPPER_START : aLayer;
+    PCB_LAYER_ID pcbLayer = static_cast<PCB_LAYER_ID>( copperLayer );
+
+    if( IsNetnameLayer( aLayer ) )
+    {
+        const PAD_LABEL_LAYOUT& label = getPadLabelLayout( aPad, pcbLayer );
+
+        if( label.m_netname.IsEmpty() && label.m_padNumber.IsEmpty() )
+            return;
+
+        m_gal->Save();
+        m_gal->Translate( label.m_center );
+
+        if( label.m_vertical )
+            m_gal->Rotate( -ANGLE_90.AsRadians() );
 
         // Default font settings
         m_gal->ResetTextAttributes();
@@ -1452,74 +1586,22 @@ void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
         m_gal->SetIsStroke( true );
         m_gal->SetIsFill( false );
 
-        // We have already translated the GAL to be centered at the center of the pad's
-        // bounding box
-        VECTOR2I textpos( 0, 0 );
-
-        // Divide the space, to display both pad numbers and netnames and set the Y text
-        // offset position to display 2 lines
-        int Y_offset_numpad = 0;
-        int Y_offset_netname = 0;
-
-        if( !netname.IsEmpty() && !padNumber.IsEmpty() )
+        if( !label.m_netname.IsEmpty() )
         {
-            // The magic numbers are defined experimentally for a better look.
-            size = size / 2.5;
-            Y_offset_netname = size / 1.4;  // netname size is usually smaller than num pad
-                                            // so the offset can be smaller
-            Y_offset_numpad = size / 1.7;
-        }
-
-        // We are using different fonts to display names, depending on the graphic
-        // engine (OpenGL or Cairo).
-        // Xscale_for_stroked_font adjust the text X size for cairo (stroke fonts) engine
-        const double Xscale_for_stroked_font = 0.9;
-
-        if( !netname.IsEmpty() )
-        {
-            // approximate the size of net name text:
-            // We use a size for at least 5 chars, to give a good look even for short names
-            // (like VCC, GND...)
-            double tsize = 1.5 * padsize.x / std::max( PrintableCharCount( netname )+1, 5 );
-            tsize = std::min( tsize, size );
-
-            // Use a smaller text size to handle interline, pen size...
-            tsize *= 0.85;
-
-            // Round and oval pads have less room to display the net name than other
-            // (i.e RECT) shapes, so reduce the text size for these shapes
-            if( aPad->GetShape( pcbLayer ) == PAD_SHAPE::CIRCLE
-                || aPad->GetShape( pcbLayer ) == PAD_SHAPE::OVAL )
-            {
-                tsize *= 0.9;
-            }
-
-            VECTOR2D namesize( tsize*Xscale_for_stroked_font, tsize );
-            textpos.y = std::min( tsize * 1.4, double( Y_offset_netname ) );
-
-            m_gal->SetGlyphSize( namesize );
-            m_gal->SetLineWidth( namesize.x / 6.0 );
+            m_gal->SetGlyphSize( label.m_netnameSize );
+            m_gal->SetLineWidth( label.m_netnameSize.x / 6.0 );
             m_gal->SetFontBold( true );
-            m_gal->BitmapText( netname, textpos, ANGLE_HORIZONTAL );
+            m_gal->BitmapText( label.m_netname, VECTOR2I( 0, label.m_netnameOffset ),
+                               ANGLE_HORIZONTAL );
         }
 
-        if( !padNumber.IsEmpty() )
+        if( !label.m_padNumber.IsEmpty() )
         {
-            // approximate the size of the pad number text:
-            // We use a size for at least 3 chars, to give a good look even for short numbers
-            double tsize = 1.5 * padsize.x / std::max( PrintableCharCount( padNumber ), 3 );
-            tsize = std::min( tsize, size );
-
-            // Use a smaller text size to handle interline, pen size...
-            tsize *= 0.85;
-            tsize = std::min( tsize, size );
-            VECTOR2D numsize( tsize*Xscale_for_stroked_font, tsize );
-            textpos.y = -Y_offset_numpad;
-
-            m_gal->SetGlyphSize( numsize );
-            m_gal->SetLineWidth( numsize.x / 6.0 );
+            m_gal->SetGlyphSize( label.m_padNumberSize );
+            m_gal->SetLineWidth( label.m_padNumberSize.x / 6.0 );
             m_gal->SetFontBold( true );
-            m_gal->BitmapText( padNumber, textpos, ANGLE_HORIZONTAL );
+            m_gal->BitmapText( label.m_padNumber, VECTOR2I( 0, label.m_padNumberOffset ),
+                               ANGLE_HORIZONTAL );
         }
 
         m_gal->Restore();
@@ -32,8 +32,11 @@
 #include <gal/painter.h>
 #include <padstack.h>   // PAD_DRILL_SHAPE
 #include <pcb_display_options.h>
+#include <math/box2.h>
 #include <math/vector2d.h>
+#include <map>
 #include <memory>
+#include <geometry/eda_angle.h>
 #include <geometry/shape_segment.h>
 
 
@@ -268,6 +271,40 @@ protected:
      */
     void drawPostMachiningIndicator( const BOARD_ITEM* aItem, const VECTOR2D& aCenter, PCB_LAYER_ID aLayer );
 
+    /**
+     * Placement of the number and net name labels of a pad.  It only depends on the pad and
+     * on the label display options, so redraws which only change colours or visibility (such
+     * as net highlighting) reuse it.
+     */
+    struct PAD_LABEL_LAYOUT
+    {
+        VECTOR2I  m_padPos;         ///< Pad position when the layout was computed
+        EDA_ANGLE m_padAngle;       ///< Pad orientation when the layout was computed
+        BOX2I     m_padBBox;        ///< Pad bounding box when the layout was computed
+        PAD_SHAPE m_padShape;       ///< Pad shape on the layer when the layout was computed
+        VECTOR2I  m_padSize;        ///< Pad size on the layer when the layout was computed
+        VECTOR2I  m_padOffset;      ///< Pad offset on the layer when the layout was computed
+        int       m_displayMode;    ///< Label display options when the layout was computed
+
+        wxString  m_netname;
+        wxString  m_padNumber;
+        VECTOR2D  m_center;         ///< Center of the labels
+        bool      m_vertical;       ///< Labels are rotated by 90 degrees to fit in the pad
+        VECTOR2D  m_netnameSize;
+        int       m_netnameOffset;
+        VECTOR2D  m_padNumberSize;
+        int       m_padNumberOffset;
+    };
+
+    /**
+     * Return the label layout of \a aPad on \a aLayer, from the cache when the board was not
+     * modified and the pad not moved, resized or reshaped since it was computed.
+     */
+    const PAD_LABEL_LAYOUT& getPadLabelLayout( const PAD* aPad, PCB_LAYER_ID aLayer );
+
+    void computePadLabelLayout( const PAD* aPad, PCB_LAYER_ID aLayer, int aDisplayMode,
+                                PAD_LABEL_LAYOUT& aLayout );
+
 protected:
     PCB_RENDER_SETTINGS m_pcbSettings;
     FRAME_T             m_frameType;
@@ -275,6 +312,12 @@ protected:
     int                 m_maxError;
     int                 m_holePlatingThickness;
     int                 m_lockedShadowMargin;
+
+    ///< Pad label layouts, valid as long as the board modification counter doesn't change
+    std::map<std::pair<const PAD*, int>, PAD_LABEL_LAYOUT> m_padLabelCache;
+    const BOARD*                                           m_padLabelCacheBoard;
+    int                                                    m_padLabelCacheTimeStamp;
+    PAD_LABEL_LAYOUT                                       m_uncachedPadLabel;
 };
 } // namespace KIGFX
 
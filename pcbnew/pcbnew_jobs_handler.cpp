@@ -47,6 +47,8 @@
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
 #include <jobs/job_pcb_upgrade.h>
+#include <jobs/job_pcb_autoplace.h>
+#include <autorouter/ar_autoplacer.h>
 #include <eda_units.h>
 #include <lset.h>
 #include <cli/exit_codes.h>
@@ -149,6 +151,11 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
               {
                   return true;
               } );
+    Register( "autoplace", std::bind( &PCBNEW_JOBS_HANDLER::JobAutoplace, this, std::placeholders::_1 ),
+              []( JOB* job, wxWindow* aParent ) -> bool
+              {
+                  return true;
+              } );
     Register( "svg", std::bind( &PCBNEW_JOBS_HANDLER::JobExportSvg, this, std::placeholders::_1 ),
               [aKiway]( JOB* job, wxWindow* aParent ) -> bool
               {
@@ -2743,3 +2750,80 @@ void PCBNEW_JOBS_HANDLER::loadOverrideDrawingSheet( BOARD* aBrd, const wxString&
     // failed loading custom path, revert back to default
     loadSheet( aBrd->GetProject()->GetProjectFile().m_BoardDrawingSheetFile );
 }
+
+
+int PCBNEW_JOBS_HANDLER::JobAutoplace( JOB* aJob )
+{
+    JOB_PCB_AUTOPLACE* job = dynamic_cast<JOB_PCB_AUTOPLACE*>( aJob );
+
+    if( job == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    BOARD* brd = getBoard( job->m_filename );
+
+    if( !brd )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+    BOX2I bbox = brd->GetBoardEdgesBoundingBox();
+
+    if( bbox.GetWidth() == 0 || bbox.GetHeight() == 0 )
+    {
+        m_reporter->Report( wxString::Format( _( "Board edges must be defined on the %s layer.\n" ),
+                                              LayerName( Edge_Cuts ) ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    SHAPE_POLY_SET boardShape;
+    brd->GetBoardPolygonOutlines( boardShape, true );
+
+    std::vector<FOOTPRINT*> footprints;
+
+    for( FOOTPRINT* footprint : brd->Footprints() )
+    {
+        if( footprint->IsLocked() )
+            continue;
+
+        if( job->m_offboardOnly && boardShape.Contains( footprint->GetPosition() ) )
+            continue;
+
+        footprints.push_back( footprint );
+    }
+
+    // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
+    TOOL_MANAGER* toolManager = getToolManager( brd );
+    BOARD_COMMIT  commit( toolManager );
+    AR_AUTOPLACER autoplacer( brd );
+
+    if( job->m_refinementPasses >= 0 )
+        autoplacer.SetRefinementPasses( job->m_refinementPasses );
+
+    m_reporter->Report( wxString::Format( _( "Placing %d footprints...\n" ),
+                                          (int) footprints.size() ),
+                        RPT_SEVERITY_ACTION );
+
+    if( autoplacer.AutoplaceFootprints( footprints, &commit, false ) != AR_COMPLETED )
+    {
+        commit.Revert();
+        m_reporter->Report( _( "Autoplacement failed.\n" ), RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    commit.Push( _( "Autoplace Footprints" ) );
+
+    wxString outPath = job->GetConfiguredOutputPath();
+
+    if( outPath.IsEmpty() )
+        outPath = job->m_filename;
+
+    if( !SaveBoard( outPath, brd, true ) )
+    {
+        m_reporter->Report( _( "Failed to save board.\n" ), RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Saved board to %s\n" ), outPath ),
+                        RPT_SEVERITY_ACTION );
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
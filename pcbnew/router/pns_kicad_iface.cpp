@@ -1175,6 +1175,9 @@ PNS_KICAD_IFACE_BASE::PNS_KICAD_IFACE_BASE()
     m_world = nullptr;
     m_debugDecorator = nullptr;
     m_startLayer = -1;
+    m_trackBoardChanges = false;
+    m_syncedWorld = nullptr;
+    m_syncedCopperLayerCount = 0;
 }
 
 
@@ -1814,37 +1817,97 @@ bool PNS_KICAD_IFACE::IsItemVisible( const PNS::ITEM* aItem ) const
 }
 
 
-void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
+void PNS_KICAD_IFACE_BASE::syncDrawing( PNS::NODE* aWorld, BOARD_ITEM* aItem )
 {
-    if( !m_board )
+    switch( aItem->Type() )
     {
-        wxLogTrace( wxT( "PNS" ), wxT( "No board attached, aborting sync." ) );
-        return;
+    case PCB_SHAPE_T:
+    case PCB_TEXTBOX_T:
+        syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( aItem ) );
+        break;
+
+    case PCB_TEXT_T:
+        syncTextItem( aWorld, static_cast<PCB_TEXT*>( aItem ), aItem->GetLayer() );
+        break;
+
+    case PCB_TABLE_T:
+        syncTextItem( aWorld, static_cast<PCB_TABLE*>( aItem ), aItem->GetLayer() );
+        break;
+
+    case PCB_BARCODE_T:
+        syncBarcode( aWorld, static_cast<PCB_BARCODE*>( aItem ) );
+        break;
+
+    case PCB_DIM_ALIGNED_T:         // ignore only if not on a copper layer
+    case PCB_DIM_CENTER_T:
+    case PCB_DIM_RADIAL_T:
+    case PCB_DIM_ORTHOGONAL_T:
+    case PCB_DIM_LEADER_T:
+        if( aItem->IsOnCopperLayer() )
+            UNIMPLEMENTED_FOR( wxString::Format( wxT( "%s on copper layer" ), aItem->GetClass() ) );
+        break;
+
+    case PCB_REFERENCE_IMAGE_T:     // ignore
+    case PCB_TARGET_T:
+        break;
+
+    default:
+        UNIMPLEMENTED_FOR( aItem->GetClass() );
+        break;
     }
+}
 
-    int worstClearance = m_board->GetMaxClearanceValue();
 
-    m_world = aWorld;
+void PNS_KICAD_IFACE_BASE::syncFootprint( PNS::NODE* aWorld, FOOTPRINT* aFootprint,
+                                          SHAPE_POLY_SET* aBoardOutline )
+{
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        std::vector<std::unique_ptr<PNS::SOLID>> solids = syncPad( pad );
 
-    for( BOARD_ITEM* gitem : m_board->Drawings() )
+        for( std::unique_ptr<PNS::SOLID>& solid : solids )
+            aWorld->Add( std::move( solid ) );
+
+        if( pad->GetProperty() == PAD_PROP::CASTELLATED )
+        {
+            std::unique_ptr<SHAPE> hole;
+            hole.reset( pad->GetEffectiveHoleShape()->Clone() );
+            aWorld->AddEdgeExclusion( std::move( hole ) );
+
+            // Edge exclusions can't be removed, so the world can't be updated incrementally
+            // once this footprint changes
+            m_castellatedFootprints.insert( aFootprint );
+        }
+    }
+
+    syncTextItem( aWorld, &aFootprint->Reference(), aFootprint->Reference().GetLayer() );
+    syncTextItem( aWorld, &aFootprint->Value(), aFootprint->Value().GetLayer() );
+
+    for( ZONE* zone : aFootprint->Zones() )
+        syncZone( aWorld, zone, aBoardOutline );
+
+    for( PCB_FIELD* field : aFootprint->GetFields() )
+        syncTextItem( aWorld, static_cast<PCB_TEXT*>( field ), field->GetLayer() );
+
+    for( BOARD_ITEM* item : aFootprint->GraphicalItems() )
     {
-        switch( gitem->Type() )
+        switch( item->Type() )
         {
         case PCB_SHAPE_T:
         case PCB_TEXTBOX_T:
-            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( gitem ) );
+            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
             break;
 
         case PCB_TEXT_T:
-            syncTextItem( aWorld, static_cast<PCB_TEXT*>( gitem ), gitem->GetLayer() );
+            syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
             break;
 
         case PCB_TABLE_T:
-            syncTextItem( aWorld, static_cast<PCB_TABLE*>( gitem ), gitem->GetLayer() );
+            syncTextItem( aWorld, static_cast<PCB_TABLE*>( item ), item->GetLayer() );
             break;
 
         case PCB_BARCODE_T:
-            syncBarcode( aWorld, static_cast<PCB_BARCODE*>( gitem ) );
+            syncBarcode( aWorld, static_cast<PCB_BARCODE*>( item ) );
             break;
 
         case PCB_DIM_ALIGNED_T:         // ignore only if not on a copper layer
@@ -1852,19 +1915,81 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
         case PCB_DIM_RADIAL_T:
         case PCB_DIM_ORTHOGONAL_T:
         case PCB_DIM_LEADER_T:
-            if( gitem->IsOnCopperLayer() )
-                UNIMPLEMENTED_FOR( wxString::Format( wxT( "%s on copper layer" ), gitem->GetClass() ) );
-            break;
+        case PCB_REFERENCE_IMAGE_T:
+            if( item->IsOnCopperLayer() )
+                UNIMPLEMENTED_FOR( wxString::Format( wxT( "%s on copper layer" ), item->GetClass() ) );
 
-        case PCB_REFERENCE_IMAGE_T:     // ignore
-        case PCB_TARGET_T:
             break;
 
         default:
-            UNIMPLEMENTED_FOR( gitem->GetClass() );
+            UNIMPLEMENTED_FOR( item->GetClass() );
             break;
         }
     }
+}
+
+
+void PNS_KICAD_IFACE_BASE::syncTrackOrVia( PNS::NODE* aWorld, PCB_TRACK* aTrack )
+{
+    KICAD_T type = aTrack->Type();
+
+    if( type == PCB_TRACE_T )
+    {
+        if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( aTrack ) )
+            aWorld->Add( std::move( segment ), true );
+    }
+    else if( type == PCB_ARC_T )
+    {
+        if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( aTrack ) ) )
+            aWorld->Add( std::move( arc ), true );
+    }
+    else if( type == PCB_VIA_T )
+    {
+        if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( aTrack ) ) )
+            aWorld->Add( std::move( via ) );
+    }
+}
+
+
+void PNS_KICAD_IFACE_BASE::initRuleResolver( PNS::NODE* aWorld )
+{
+    int worstClearance = m_board->GetMaxClearanceValue();
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            std::optional<int> clearanceOverride = pad->GetClearanceOverrides( nullptr );
+
+            if( clearanceOverride.has_value() )
+                worstClearance = std::max( worstClearance, clearanceOverride.value() );
+        }
+    }
+
+    // The rule resolver caches clearances and hulls, which may be stale after the board
+    // changed, so a new one is created for each sync
+    delete m_ruleResolver;
+    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
+
+    aWorld->SetRuleResolver( m_ruleResolver );
+    aWorld->SetMaxClearance( worstClearance + m_ruleResolver->ClearanceEpsilon() );
+}
+
+
+void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
+{
+    if( !m_board )
+    {
+        wxLogTrace( wxT( "PNS" ), wxT( "No board attached, aborting sync." ) );
+        return;
+    }
+
+    m_world = aWorld;
+    m_dirtyItems.clear();
+    m_castellatedFootprints.clear();
+
+    for( BOARD_ITEM* gitem : m_board->Drawings() )
+        syncDrawing( aWorld, gitem );
 
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
@@ -1878,103 +2003,199 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
     }
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        for( PAD* pad : footprint->Pads() )
-        {
-            std::vector<std::unique_ptr<PNS::SOLID>> solids = syncPad( pad );
+        syncFootprint( aWorld, footprint, boardOutline );
 
-            for( std::unique_ptr<PNS::SOLID>& solid : solids )
-                aWorld->Add( std::move( solid ) );
+    for( PCB_TRACK* t : m_board->Tracks() )
+        syncTrackOrVia( aWorld, t );
 
-            std::optional<int> clearanceOverride = pad->GetClearanceOverrides( nullptr );
+    initRuleResolver( aWorld );
+
+    m_syncedWorld = m_trackBoardChanges ? aWorld : nullptr;
+    m_syncedCopperLayerCount = m_board->GetCopperLayerCount();
+}
 
-            if( clearanceOverride.has_value() )
-                worstClearance = std::max( worstClearance, clearanceOverride.value() );
 
-            if( pad->GetProperty() == PAD_PROP::CASTELLATED )
+bool PNS_KICAD_IFACE_BASE::UpdateWorld( PNS::NODE* aWorld )
+{
+    if( !m_board || !m_trackBoardChanges || aWorld != m_syncedWorld
+            || m_board->GetCopperLayerCount() != m_syncedCopperLayerCount )
+    {
+        return false;
+    }
+
+    // Map each item currently on the board, and each of their children, to the top level
+    // item from which it is synced.  Items which are not in the map are no longer on the
+    // board and may have been deleted, so they are never dereferenced.
+    std::unordered_map<const BOARD_ITEM*, BOARD_ITEM*> owners;
+    size_t                                             topLevelCount = 0;
+
+    auto addOwner =
+            [&]( BOARD_ITEM* aItem )
             {
-                std::unique_ptr<SHAPE> hole;
-                hole.reset( pad->GetEffectiveHoleShape()->Clone() );
-                aWorld->AddEdgeExclusion( std::move( hole ) );
-            }
-        }
+                owners[aItem] = aItem;
+                topLevelCount++;
+
+                aItem->RunOnChildren(
+                        [&]( BOARD_ITEM* aChild )
+                        {
+                            owners[aChild] = aItem;
+                        },
+                        RECURSE_MODE::RECURSE );
+            };
 
-        syncTextItem( aWorld, &footprint->Reference(), footprint->Reference().GetLayer() );
-        syncTextItem( aWorld, &footprint->Value(), footprint->Value().GetLayer() );
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        addOwner( item );
 
-        for( ZONE* zone : footprint->Zones() )
-            syncZone( aWorld, zone, boardOutline );
+    for( ZONE* zone : m_board->Zones() )
+        addOwner( zone );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+        addOwner( footprint );
 
-        for( PCB_FIELD* field : footprint->GetFields() )
-            syncTextItem( aWorld, static_cast<PCB_TEXT*>( field ), field->GetLayer() );
+    for( PCB_TRACK* track : m_board->Tracks() )
+        addOwner( track );
 
-        for( BOARD_ITEM* item : footprint->GraphicalItems() )
+    std::unordered_set<const BOARD_ITEM*> stale;
+
+    for( BOARD_ITEM* item : m_dirtyItems )
+    {
+        if( m_castellatedFootprints.count( item ) )
+            return false;
+
+        auto it = owners.find( item );
+
+        if( it != owners.end() )
         {
-            switch( item->Type() )
-            {
-            case PCB_SHAPE_T:
-            case PCB_TEXTBOX_T:
-                syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
-                break;
-
-            case PCB_TEXT_T:
-                syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
-                break;
-
-            case PCB_TABLE_T:
-                syncTextItem( aWorld, static_cast<PCB_TABLE*>( item ), item->GetLayer() );
-                break;
-
-            case PCB_BARCODE_T:
-                syncBarcode( aWorld, static_cast<PCB_BARCODE*>( item ) );
-                break;
-
-            case PCB_DIM_ALIGNED_T:         // ignore only if not on a copper layer
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-            case PCB_REFERENCE_IMAGE_T:
-                if( item->IsOnCopperLayer() )
-                    UNIMPLEMENTED_FOR( wxString::Format( wxT( "%s on copper layer" ), item->GetClass() ) );
-
-                break;
-
-            default:
-                UNIMPLEMENTED_FOR( item->GetClass() );
-                break;
-            }
+            if( m_castellatedFootprints.count( it->second ) )
+                return false;
+
+            stale.insert( it->second );
         }
     }
 
-    for( PCB_TRACK* t : m_board->Tracks() )
+    // Past this point, syncing the whole board again is about as fast
+    if( stale.size() > topLevelCount / 4 )
+        return false;
+
+    m_world = aWorld;
+
+    // Remove the items synced from stale or deleted board items, as well as the virtual vias
+    // which are recomputed once the world is updated.
+    aWorld->RemoveItems(
+            [&]( const PNS::ITEM* aItem )
+            {
+                if( !aItem->Parent() )
+                    return aItem->IsVirtual();
+
+                auto it = owners.find( aItem->Parent() );
+
+                return it == owners.end() || stale.count( it->second ) > 0;
+            } );
+
+    // Same order as SyncWorld()
+    for( BOARD_ITEM* item : m_board->Drawings() )
     {
-        KICAD_T type = t->Type();
+        if( stale.count( item ) )
+            syncDrawing( aWorld, item );
+    }
 
-        if( type == PCB_TRACE_T )
-        {
-            if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( t ) )
-                aWorld->Add( std::move( segment ), true );
-        }
-        else if( type == PCB_ARC_T )
-        {
-            if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( t ) ) )
-                aWorld->Add( std::move( arc ), true );
-        }
-        else if( type == PCB_VIA_T )
-        {
-            if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( t ) ) )
-                aWorld->Add( std::move( via ) );
-        }
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( stale.count( zone ) )
+            syncZone( aWorld, zone, nullptr );
     }
 
-    // NB: if this were ever to become a long-lived object we would need to dirty its
-    // clearance cache here....
-    delete m_ruleResolver;
-    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( stale.count( footprint ) )
+            syncFootprint( aWorld, footprint, nullptr );
+    }
 
-    aWorld->SetRuleResolver( m_ruleResolver );
-    aWorld->SetMaxClearance( worstClearance + m_ruleResolver->ClearanceEpsilon() );
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( stale.count( track ) )
+            syncTrackOrVia( aWorld, track );
+    }
+
+    initRuleResolver( aWorld );
+
+    wxLogTrace( wxT( "PNS" ), wxT( "Updated %d board items in the router world." ),
+                (int) stale.size() );
+
+    m_dirtyItems.clear();
+    return true;
+}
+
+
+void PNS_KICAD_IFACE_BASE::SetTrackBoardChanges( bool aTrack )
+{
+    m_trackBoardChanges = aTrack;
+    m_syncedWorld = nullptr;
+    m_dirtyItems.clear();
+}
+
+
+void PNS_KICAD_IFACE_BASE::markDirty( const std::vector<BOARD_ITEM*>& aItems )
+{
+    if( m_syncedWorld )
+        m_dirtyItems.insert( aItems.begin(), aItems.end() );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    markDirty( { aBoardItem } );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    markDirty( aBoardItems );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    markDirty( { aBoardItem } );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsRemoved( BOARD& aBoard,
+                                                std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    markDirty( aBoardItems );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    markDirty( { aBoardItem } );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsChanged( BOARD& aBoard,
+                                                std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    markDirty( aBoardItems );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardCompositeUpdate( BOARD& aBoard,
+                                                   std::vector<BOARD_ITEM*>& aAddedItems,
+                                                   std::vector<BOARD_ITEM*>& aRemovedItems,
+                                                   std::vector<BOARD_ITEM*>& aChangedItems )
+{
+    markDirty( aAddedItems );
+    markDirty( aRemovedItems );
+    markDirty( aChangedItems );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    // Net classes may affect the whole board; build the world again on the next sync
+    m_syncedWorld = nullptr;
+    m_dirtyItems.clear();
 }
 
 
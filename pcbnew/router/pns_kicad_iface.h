@@ -26,6 +26,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include <board.h>
+
 #include "pns_router.h"
 
 class PNS_PCBNEW_RULE_RESOLVER;
@@ -54,7 +56,7 @@ namespace KIGFX
     class VIEW;
 }
 
-class PNS_KICAD_IFACE_BASE : public PNS::ROUTER_IFACE
+class PNS_KICAD_IFACE_BASE : public PNS::ROUTER_IFACE, public BOARD_LISTENER
 {
 public:
     PNS_KICAD_IFACE_BASE();
@@ -63,6 +65,26 @@ public:
     void EraseView() override {};
     void SetBoard( BOARD* aBoard );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
+
+    /**
+     * Record the board changes reported to this interface as a #BOARD_LISTENER, so the world
+     * built by SyncWorld() can later be brought up to date by UpdateWorld().  The caller is
+     * responsible for adding the interface to the listeners of the board.
+     */
+    void SetTrackBoardChanges( bool aTrack );
+
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                 std::vector<BOARD_ITEM*>& aRemovedItems,
+                                 std::vector<BOARD_ITEM*>& aChangedItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
+
     bool IsAnyLayerVisible( const PNS_LAYER_RANGE& aLayer ) const override { return true; };
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, int aLayer ) const override;
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, const PNS_LAYER_RANGE& aLayer ) const override;
@@ -128,6 +150,11 @@ protected:
     bool syncGraphicalItem( PNS::NODE* aWorld, PCB_SHAPE* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE* aZone, SHAPE_POLY_SET* aBoardOutline );
     bool syncBarcode( PNS::NODE* aWorld, PCB_BARCODE* aBarcode );
+    void syncDrawing( PNS::NODE* aWorld, BOARD_ITEM* aItem );
+    void syncFootprint( PNS::NODE* aWorld, FOOTPRINT* aFootprint, SHAPE_POLY_SET* aBoardOutline );
+    void syncTrackOrVia( PNS::NODE* aWorld, PCB_TRACK* aTrack );
+    void initRuleResolver( PNS::NODE* aWorld );
+    void markDirty( const std::vector<BOARD_ITEM*>& aItems );
     bool inheritTrackWidth( PNS::ITEM* aItem, int* aInheritedWidth );
     std::vector<LENGTH_DELAY_CALCULATION_ITEM> getLengthDelayCalculationItems( const PNS::ITEM_SET& aLine,
                                                                                const NETCLASS*      aNetClass ) const;
@@ -136,6 +163,13 @@ protected:
     PNS::NODE* m_world;
     BOARD*     m_board;
     int        m_startLayer; // The starting layer, in PNS layer coordinates
+
+    bool       m_trackBoardChanges;
+    PNS::NODE* m_syncedWorld;               ///< World which UpdateWorld() can update, if any
+    int        m_syncedCopperLayerCount;
+
+    std::unordered_set<BOARD_ITEM*>       m_dirtyItems;   ///< Changed since the last sync
+    std::unordered_set<const BOARD_ITEM*> m_castellatedFootprints;
 };
 
 class PNS_KICAD_IFACE : public PNS_KICAD_IFACE_BASE
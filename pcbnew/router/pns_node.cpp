@@ -1786,6 +1786,28 @@ std::vector<ITEM*> NODE::FindItemsByParent( const BOARD_ITEM* aParent )
 }
 
 
+int NODE::RemoveItems( const std::function<bool( const ITEM* aItem )>& aFilter )
+{
+    if( !isRoot() )
+        return 0;
+
+    std::vector<ITEM*> toRemove;
+
+    for( ITEM* item : *m_index )
+    {
+        if( !item->OfKind( ITEM::HOLE_T ) && aFilter( item ) )
+            toRemove.push_back( item );
+    }
+
+    for( ITEM* item : toRemove )
+        Remove( item );
+
+    releaseGarbage();
+
+    return (int) toRemove.size();
+}
+
+
 VIA* NODE::FindViaByHandle ( const VIA_HANDLE& handle ) const
 {
     const JOINT* jt = FindJoint( handle.pos, handle.layers.Start(), handle.net );
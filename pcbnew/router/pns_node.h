@@ -23,6 +23,7 @@
 #ifndef __PNS_NODE_H
 #define __PNS_NODE_H
 
+#include <functional>
 #include <vector>
 #include <list>
 #include <set>
@@ -486,6 +487,14 @@ public:
 
     std::vector<ITEM*> FindItemsByParent( const BOARD_ITEM* aParent );
 
+    /**
+     * Remove from the root node all the items for which \a aFilter returns true, in a single
+     * pass over the index.  Holes are removed together with their solid or via.
+     *
+     * @return the number of removed items.
+     */
+    int RemoveItems( const std::function<bool( const ITEM* aItem )>& aFilter );
+
     bool HasChildren() const
     {
         return !m_children.empty();
@@ -26,6 +26,7 @@
 #include <gal/graphics_abstraction_layer.h>
 
 #include <advanced_config.h>
+#include <core/trace_events.h>
 #include <settings/settings_manager.h>
 
 #include <pcb_painter.h>
@@ -84,6 +85,12 @@ ROUTER* ROUTER::GetInstance()
 }
 
 
+void ROUTER::MakeInstance()
+{
+    theRouter = this;
+}
+
+
 ROUTER::~ROUTER()
 {
     ClearWorld();
@@ -94,6 +101,20 @@ ROUTER::~ROUTER()
 
 void ROUTER::SyncWorld()
 {
+    // Updating the existing world with the board changes is much faster than building it
+    // again on large boards.
+    if( m_world )
+    {
+        m_placer.reset();
+        m_world->KillChildren();
+
+        if( m_iface->UpdateWorld( m_world.get() ) )
+        {
+            m_world->FixupVirtualVias();
+            return;
+        }
+    }
+
     ClearWorld();
 
     m_world = std::make_unique<NODE>( );
@@ -425,6 +446,8 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, ITEM* aStartItem,
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    TRACE_ZONE traceZone( "Router start", "router" );
+
     GetRuleResolver()->ClearCaches();
 
     if( !isStartingPointRoutable( aP, aStartItem, aLayer ) )
@@ -485,6 +508,8 @@ bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 
 bool ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    TRACE_ZONE traceZone( "Router move", "router" );
+
     if( m_logger )
         m_logger->Log( LOGGER::EVT_MOVE, aP, endItem );
 
@@ -895,6 +920,8 @@ void ROUTER::CommitRouting( NODE* aNode )
 
 bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish, bool aForceCommit )
 {
+    TRACE_ZONE traceZone( "Router fix", "router" );
+
     bool rv = false;
 
     if( m_logger )
@@ -90,6 +90,15 @@ enum DRAG_MODE
     virtual ~ROUTER_IFACE() {};
 
     virtual void SyncWorld( NODE* aNode ) = 0;
+
+    /**
+     * Bring \a aNode, previously filled by SyncWorld(), up to date with the board changes made
+     * since.
+     *
+     * @return false if the world cannot be updated incrementally and must be synced again.
+     */
+    virtual bool UpdateWorld( NODE* aNode ) { return false; }
+
     virtual void AddItem( ITEM* aItem ) = 0;
     virtual void UpdateItem( ITEM* aItem ) = 0;
     virtual void RemoveItem( ITEM* aItem ) = 0;
@@ -155,6 +164,12 @@ public:
 
     static ROUTER* GetInstance();
 
+    /**
+     * Make this router the one returned by GetInstance(), for a router which is kept alive
+     * while other routers may have been created since.
+     */
+    void MakeInstance();
+
     void ClearWorld();
     void SyncWorld();
 
@@ -52,6 +52,7 @@ TOOL_BASE::TOOL_BASE( const std::string& aToolName ) :
     m_gridHelper = nullptr;
     m_iface = nullptr;
     m_router = nullptr;
+    m_listenerBoard = nullptr;
     m_cancelled = false;
 
     m_startItem = nullptr;
@@ -66,34 +67,69 @@ TOOL_BASE::TOOL_BASE( const std::string& aToolName ) :
 TOOL_BASE::~TOOL_BASE()
 {
     delete m_gridHelper;
+
+    // The model is already cleared and the board possibly deleted by now.
+    deleteRouter( nullptr );
+}
+
+
+void TOOL_BASE::deleteRouter( BOARD* aCurrentBoard )
+{
+    // A board which has been replaced removed its listeners when it was deleted.
+    if( m_iface && m_listenerBoard && m_listenerBoard == aCurrentBoard )
+        m_listenerBoard->RemoveListener( m_iface );
+
+    m_listenerBoard = nullptr;
+
     delete m_router;
     delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
+
+    m_router = nullptr;
+    m_iface = nullptr;
 }
 
 
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
     delete m_gridHelper;
-    delete m_router;
-    delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
 
-    if( aReason == RESET_REASON::SHUTDOWN )
+    if( aReason == RUN && m_router && m_iface && m_iface->GetBoard() == board() )
     {
-        m_gridHelper = nullptr;
-        m_router = nullptr;
-        m_iface = nullptr;
-        return;
+        // The router world is kept between runs of the tool and only updated with the board
+        // changes made since, which is much faster than building it again on large boards.
+        m_router->MakeInstance();
+        m_router->SyncWorld();
     }
+    else
+    {
+        deleteRouter( board() );
+
+        if( aReason == SHUTDOWN )
+        {
+            m_gridHelper = nullptr;
+            return;
+        }
 
-    m_iface = new PNS_KICAD_IFACE;
-    m_iface->SetBoard( board() );
-    m_iface->SetView( getView() );
-    m_iface->SetHostTool( this );
+        m_iface = new PNS_KICAD_IFACE;
+        m_iface->SetBoard( board() );
+        m_iface->SetView( getView() );
+        m_iface->SetHostTool( this );
 
-    m_router = new ROUTER;
-    m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
-    m_router->SyncWorld();
+        if( board() )
+        {
+            board()->AddListener( m_iface );
+            m_iface->SetTrackBoardChanges( true );
+            m_listenerBoard = board();
+        }
+
+        m_router = new ROUTER;
+        m_router->SetInterface( m_iface );
+        m_router->ClearWorld();
+
+        // The world is built when the tool is run
+        if( aReason == RUN )
+            m_router->SyncWorld();
+    }
 
     m_router->UpdateSizes( m_savedSizes );
 
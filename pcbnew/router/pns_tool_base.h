@@ -54,6 +54,14 @@ public:
     PNS_KICAD_IFACE* GetInterface() const;
 
 protected:
+    /**
+     * Delete the router and its interface.
+     *
+     * @param aCurrentBoard is the board currently edited, or nullptr when it can't be queried
+     *                      any more (e.g. from the destructor).
+     */
+    void deleteRouter( BOARD* aCurrentBoard );
+
     bool checkSnap( ITEM* aItem );
 
     const VECTOR2I snapToItem( ITEM* aSnapToItem, const VECTOR2I& aP);
@@ -78,6 +86,7 @@ protected:
     PCB_GRID_HELPER* m_gridHelper;
     PNS_KICAD_IFACE* m_iface;
     ROUTER*          m_router;
+    BOARD*           m_listenerBoard;  // The board m_iface is registered with as a listener
 
     bool             m_cancelled;
 
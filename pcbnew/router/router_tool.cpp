@@ -642,7 +642,10 @@ bool ROUTER_TOOL::Init()
 
 void ROUTER_TOOL::Reset( RESET_REASON aReason )
 {
-    if( aReason == RUN )
+    // The router world is kept between runs; drop it when the board or the view it refers
+    // to is replaced, or when the tool is shut down while the board still exists.
+    if( aReason == RUN || aReason == MODEL_RELOAD || aReason == GAL_SWITCH
+            || aReason == SHUTDOWN )
         TOOL_BASE::Reset( aReason );
 }
 
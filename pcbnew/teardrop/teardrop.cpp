@@ -40,6 +40,7 @@
 #include <bezier_curves.h>
 
 #include <wx/log.h>
+#include <unordered_set>
 
 // The first priority level of a teardrop area (arbitrary value)
 #define MAGIC_TEARDROP_ZONE_ID 30000
@@ -176,6 +177,9 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
 {
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
+    // Bulk edits can dirty thousands of pads and vias; don't search them linearly
+    std::unordered_set<BOARD_ITEM*> dirtyItems( dirtyPadsAndVias->begin(), dirtyPadsAndVias->end() );
+
     auto isStale =
             [&]( ZONE* zone )
             {
@@ -186,19 +190,19 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
 
                 for( PAD* pad : connectedPads )
                 {
-                    if( alg::contains( *dirtyPadsAndVias, pad ) )
+                    if( dirtyItems.contains( pad ) )
                         return true;
                 }
 
                 for( PCB_VIA* via : connectedVias )
                 {
-                    if( alg::contains( *dirtyPadsAndVias, via ) )
+                    if( dirtyItems.contains( via ) )
                         return true;
                 }
 
                 for( PCB_TRACK* track : connectivity->GetConnectedTracks( zone ) )
                 {
-                    if( alg::contains( *dirtyTracks, track ) )
+                    if( dirtyTracks->contains( track ) )
                         return true;
                 }
 
@@ -241,6 +245,10 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
     }
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::unordered_set<BOARD_ITEM*>    dirtyItems;
+
+    if( dirtyPadsAndVias )
+        dirtyItems.insert( dirtyPadsAndVias->begin(), dirtyPadsAndVias->end() );
 
     for( PCB_TRACK* track : m_board->Tracks() )
     {
@@ -256,7 +264,7 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
 
         for( PAD* pad : connectedPads )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, pad ) )
+            if( !forceUpdate && !dirtyItems.contains( pad ) )
                 continue;
 
             TEARDROP_PARAMETERS& tdParams = pad->GetTeardropParams();
@@ -306,7 +314,7 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
 
         for( PCB_VIA* via : connectedVias )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, via ) )
+            if( !forceUpdate && !dirtyItems.contains( via ) )
                 continue;
 
             TEARDROP_PARAMETERS tdParams = via->GetTeardropParams();
@@ -451,7 +459,7 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
         {
             PCB_TRACK* track = (*sublist)[ii];
             int        track_len = (int) track->GetLength();
-            bool       track_needs_update = aForceFullUpdate || alg::contains( *aTracks, track );
+            bool       track_needs_update = aForceFullUpdate || aTracks->contains( track );
             min_width = track->GetWidth();
 
             // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
@@ -488,7 +496,7 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
                 if( !match_points )
                     continue;
 
-                if( !track_needs_update && alg::contains( *aTracks, candidate ) )
+                if( !track_needs_update && aTracks->contains( candidate ) )
                     continue;
 
                 // Pads/vias have priority for teardrops; ensure there isn't one at our position
@@ -28,6 +28,9 @@
 #include <algorithm>
 #include <limits>
 #include <kiplatform/ui.h>
+#include <advanced_config.h>
+#include <core/profile.h>
+#include <core/trace_events.h>
 #include <board.h>
 #include <board_commit.h>
 #include <gal/graphics_abstraction_layer.h>
@@ -970,6 +973,17 @@ bool EDIT_TOOL::doMoveSelection( const TOOL_EVENT& aEvent, BOARD_COMMIT* aCommit
     AXIS_LOCK axisLock = AXIS_LOCK::NONE;
     long      lastArrowKeyAction = 0;
 
+    // Moving every item of a large selection on each mouse motion (which also throws away their
+    // cached shapes) makes dragging sluggish.  For such selections only the drawing of the
+    // selection is offset while dragging; the items catch up a few times per second (so the
+    // ratsnest, courtyard checks and 3D view follow), before any other event, and when dropped.
+    const bool deferMoves = !moveIndividually && sel_items.size() > 1
+                            && ADVANCED_CFG::GetCfg().m_MoveDeferredItemThreshold > 0
+                            && (int) sel_items.size() >= ADVANCED_CFG::GetCfg().m_MoveDeferredItemThreshold;
+    const double deferredMoveIntervalMs = 200;
+    PROF_TIMER   deferredMoveTimer;
+    VECTOR2I     pendingMovement;
+
     // Used to test courtyard overlaps
     std::unique_ptr<DRC_INTERACTIVE_COURTYARD_CLEARANCE> drc_on_move = nullptr;
 
@@ -1011,6 +1025,81 @@ bool EDIT_TOOL::doMoveSelection( const TOOL_EVENT& aEvent, BOARD_COMMIT* aCommit
                 }
             };
 
+    auto applyPendingMovement =
+            [&]( bool aUpdateFeedback )
+            {
+                if( pendingMovement == VECTOR2I( 0, 0 ) )
+                    return;
+
+                TRACE_ZONE traceZone( "Apply deferred move", "edit" );
+                VECTOR2I   delta = pendingMovement;
+                bool       redraw3D = false;
+
+                pendingMovement = VECTOR2I( 0, 0 );
+                selection.SetDrawOffset( pendingMovement );
+
+                for( BOARD_ITEM* item : sel_items )
+                {
+                    // Don't double move child items.
+                    if( !item->GetParent() || !item->GetParent()->IsSelected() )
+                        item->Move( delta );
+
+                    if( item->Type() == PCB_FOOTPRINT_T )
+                        redraw3D = true;
+                }
+
+                if( !aUpdateFeedback )
+                    return;
+
+                if( redraw3D && allowRedraw3D )
+                    editFrame->Update3DView( false, true );
+
+                if( showCourtyardConflicts && drc_on_move->m_FpInMove.size() )
+                {
+                    drc_on_move->Run();
+                    drc_on_move->UpdateConflicts( m_toolMgr->GetView(), true );
+                }
+
+                if( enableLocalRatsnest )
+                    m_toolMgr->PostAction( PCB_ACTIONS::updateLocalRatsnest, delta );
+
+                m_toolMgr->PostEvent( EVENTS::SelectedItemsMoved );
+                deferredMoveTimer.Start();
+            };
+
+    // Only the events handled below which depend on the item positions need the deferred
+    // movement applied first.  Posted messages (including our own SelectedItemsMoved) and the
+    // local ratsnest updates must not, or every motion would move the items anyway.
+    auto needsPendingMovement =
+            [&]( const TOOL_EVENT* aEvt )
+            {
+                if( aEvt->Category() == TC_MESSAGE
+                        || aEvt->IsAction( &ACTIONS::refreshPreview )
+                        || aEvt->IsAction( &PCB_ACTIONS::updateLocalRatsnest ) )
+                {
+                    return false;
+                }
+
+                return aEvt->IsClick( BUT_RIGHT )
+                       || aEvt->IsAction( &PCB_ACTIONS::rotateCw )
+                       || aEvt->IsAction( &PCB_ACTIONS::rotateCcw )
+                       || aEvt->IsAction( &PCB_ACTIONS::flip )
+                       || aEvt->IsAction( &PCB_ACTIONS::mirrorH )
+                       || aEvt->IsAction( &PCB_ACTIONS::mirrorV )
+                       || aEvt->IsAction( &ACTIONS::increment );
+            };
+
+    // These end the move; the items catch up without feedback once the loop is left.
+    auto endsMove =
+            [&]( const TOOL_EVENT* aEvt )
+            {
+                return aEvt->IsCancelInteractive() || aEvt->IsActivate()
+                       || aEvt->IsAction( &ACTIONS::undo )
+                       || aEvt->IsAction( &ACTIONS::doDelete )
+                       || aEvt->IsMouseUp( BUT_LEFT ) || aEvt->IsClick( BUT_LEFT )
+                       || aEvt->IsDblClick( BUT_LEFT );
+            };
+
     configureAngleSnap( angleSnapMode );
     displayConstraintsMessage( angleSnapMode );
 
@@ -1029,6 +1118,10 @@ bool EDIT_TOOL::doMoveSelection( const TOOL_EVENT& aEvent, BOARD_COMMIT* aCommit
 
         if( evt->IsMotion() || evt->IsDrag( BUT_LEFT ) )
             eatFirstMouseUp = false;
+        else if( endsMove( evt ) )
+            applyPendingMovement( false );
+        else if( needsPendingMovement( evt ) )
+            applyPendingMovement( true );
 
         if(   evt->IsAction( &PCB_ACTIONS::move )
            || evt->IsMotion()
@@ -1132,6 +1225,19 @@ bool EDIT_TOOL::doMoveSelection( const TOOL_EVENT& aEvent, BOARD_COMMIT* aCommit
                 prevPos = m_cursor;
                 bboxMovement += movement;
 
+                if( deferMoves )
+                {
+                    pendingMovement += movement;
+                    selection.SetDrawOffset( pendingMovement );
+
+                    if( deferredMoveTimer.msecs() >= deferredMoveIntervalMs )
+                        applyPendingMovement( true );
+                    else
+                        m_toolMgr->PostEvent( EVENTS::SelectedItemsMoved );
+
+                    continue;
+                }
+
                 // Drag items to the current cursor position
                 for( BOARD_ITEM* item : sel_items )
                 {
@@ -1436,6 +1542,9 @@ bool EDIT_TOOL::doMoveSelection( const TOOL_EVENT& aEvent, BOARD_COMMIT* aCommit
 
     } while( ( evt = Wait() ) ); // Assignment (instead of equality test) is intentional
 
+    // The drop doesn't need the preview feedback, the local ratsnest is about to be hidden
+    applyPendingMovement( false );
+
     // Clear temporary COURTYARD_CONFLICT flag and ensure the conflict shadow is cleared
     if( showCourtyardConflicts )
         drc_on_move->ClearConflicts( m_toolMgr->GetView() );
@@ -164,32 +164,77 @@ int GENERATOR_TOOL::ShowGeneratorsManager( const TOOL_EVENT& aEvent )
 
 int GENERATOR_TOOL::RegenerateAllOfType( const TOOL_EVENT& aEvent )
 {
-    wxString     generatorType = aEvent.Parameter<wxString>();
+    regenerate( aEvent.Parameter<wxString>(), false );
+    return 0;
+}
+
+
+int GENERATOR_TOOL::RegenerateOutdated( const TOOL_EVENT& aEvent )
+{
+    regenerate( aEvent.Parameter<wxString>(), true );
+    return 0;
+}
+
+
+void GENERATOR_TOOL::RecordRegenerationHashes()
+{
+    GENERATOR_ITEM_INDEX itemIndex( board() );
+
+    for( PCB_GENERATOR* generator : board()->Generators() )
+        generator->SetRegeneratedHash( generator->GetRegenerationHash( board(), itemIndex ) );
+}
+
+
+void GENERATOR_TOOL::regenerate( const wxString& aGeneratorType, bool aOnlyOutdated )
+{
     BOARD_COMMIT commit( this );
     wxString     commitMsg;
     int          commitFlags = 0;
 
-    if( generatorType == wxS( "*" ) )
+    GENERATORS           generators;
+    GENERATOR_ITEM_INDEX itemIndex( board() );
+
+    if( aGeneratorType == wxS( "*" ) && !aOnlyOutdated )
         commitMsg = _( "Regenerate All" );
 
     for( PCB_GENERATOR* generator : board()->Generators() )
     {
-        if( generatorType == wxS( "*" ) || generator->GetGeneratorType() == generatorType )
-        {
-            if( commitMsg.IsEmpty() )
-                commitMsg.Printf( _( "Update %s" ), generator->GetPluralName() );
+        if( aGeneratorType == wxS( "*" ) || generator->GetGeneratorType() == aGeneratorType )
+            generators.push_back( generator );
+    }
 
-            generator->EditStart( this, board(), &commit );
-            generator->Update( this, board(), &commit );
-            generator->EditFinish( this, board(), &commit );
+    for( PCB_GENERATOR* generator : generators )
+    {
+        if( aOnlyOutdated )
+        {
+            // Only touch the generators known to be affected: the ones which can't tell are
+            // left to the explicit actions.
+            size_t hash = generator->GetRegenerationHash( board(), itemIndex );
 
-            commit.Push( commitMsg, commitFlags );
-            commitFlags |= APPEND_UNDO;
+            if( !hash || hash == generator->GetRegeneratedHash() )
+                continue;
         }
+
+        if( commitMsg.IsEmpty() )
+            commitMsg.Printf( _( "Update %s" ), generator->GetPluralName() );
+
+        generator->EditStart( this, board(), &commit );
+        generator->Update( this, board(), &commit );
+        generator->EditFinish( this, board(), &commit );
+
+        commit.Push( commitMsg, commitFlags );
+        commitFlags |= APPEND_UNDO;
+
+        itemIndex.Invalidate();
     }
 
+    // Recorded once all of them are done: regenerating one generator can change the inputs of
+    // another one (e.g. two patterns on the same net), and the result of this pass is what a
+    // later pass should compare against.
+    for( PCB_GENERATOR* generator : generators )
+        generator->SetRegeneratedHash( generator->GetRegenerationHash( board(), itemIndex ) );
+
     frame()->RefreshCanvas();
-    return 0;
 }
 
 
@@ -301,6 +346,7 @@ void GENERATOR_TOOL::setTransitions()
 
     Go( &GENERATOR_TOOL::RegenerateAllOfType,   PCB_ACTIONS::regenerateAllTuning.MakeEvent() );
     Go( &GENERATOR_TOOL::RegenerateAllOfType,   PCB_ACTIONS::regenerateAll.MakeEvent() );
+    Go( &GENERATOR_TOOL::RegenerateOutdated,    PCB_ACTIONS::regenerateOutdated.MakeEvent() );
     Go( &GENERATOR_TOOL::RegenerateSelected,    PCB_ACTIONS::regenerateSelected.MakeEvent() );
 
     Go( &GENERATOR_TOOL::GenEditAction,         PCB_ACTIONS::genStartEdit.MakeEvent() );
@@ -60,10 +60,24 @@ public:
     int RegenerateItem( const TOOL_EVENT& aEvent );
     int GenEditAction( const TOOL_EVENT& aEvent );
 
+    /**
+     * Record the current regeneration hash of every generator, e.g. once a board is loaded, so
+     * that RegenerateOutdated() can tell which ones a later change affects.
+     */
+    void RecordRegenerationHashes();
+
 private:
     ///< Set up handlers for various events.
     void setTransitions() override;
 
+    /**
+     * Regenerate the generators of \a aGeneratorType ("*" for all of them).
+     *
+     * @param aOnlyOutdated skip the generators whose regeneration hash shows that nothing they
+     *                      depend on changed since they were last regenerated.
+     */
+    void regenerate( const wxString& aGeneratorType, bool aOnlyOutdated );
+
     DIALOG_GENERATORS* m_mgrDialog;
 
 private:
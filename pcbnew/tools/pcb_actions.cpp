@@ -2715,6 +2715,15 @@ TOOL_ACTION PCB_ACTIONS::regenerateAll( TOOL_ACTION_ARGS()
         .Icon( BITMAPS::refresh )
         .Parameter( wxString( wxS( "*" ) ) ) );
 
+TOOL_ACTION PCB_ACTIONS::regenerateOutdated( TOOL_ACTION_ARGS()
+        .Name( "pcbnew.Generator.regenerateOutdated" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Rebuild Outdated Generators" ) )
+        .Tooltip( _( "Rebuilds geometry of the generators affected by changes to the board or "
+                     "the design rules" ) )
+        .Icon( BITMAPS::refresh )
+        .Parameter( wxString( wxS( "*" ) ) ) );
+
 TOOL_ACTION PCB_ACTIONS::regenerateSelected( TOOL_ACTION_ARGS()
         .Name( "pcbnew.Generator.regenerateSelected" )
         .Scope( AS_GLOBAL )
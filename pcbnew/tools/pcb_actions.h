@@ -287,6 +287,7 @@ public:
     /// Generator tool
     static TOOL_ACTION regenerateAllTuning;
     static TOOL_ACTION regenerateAll;
+    static TOOL_ACTION regenerateOutdated;
     static TOOL_ACTION regenerateSelected;
     static TOOL_ACTION regenerateItem;
     static TOOL_ACTION genStartEdit;
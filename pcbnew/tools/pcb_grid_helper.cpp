@@ -50,6 +50,7 @@
 #include <geometry/shape_segment.h>
 #include <geometry/shape_simple.h>
 #include <geometry/shape_utils.h>
+#include <hash.h>
 #include <macros.h>
 #include <math/util.h> // for KiROUND
 #include <gal/painter.h>
@@ -145,6 +146,67 @@ std::optional<int64_t> FindSquareDistanceToItem( const BOARD_ITEM& item, const V
     return nearestPt.SquaredDistance( aPos );
 }
 
+
+/**
+ * Get the bounding box of an intersectable, slightly inflated to absorb the rounding of the
+ * intersection points.
+ *
+ * @return std::nullopt for unbounded geometries (lines and half-lines).
+ */
+std::optional<BOX2I> GetIntersectableBBox( const INTERSECTABLE_GEOM& aGeom )
+{
+    std::optional<BOX2I> bbox = std::visit(
+            []( const auto& geom ) -> std::optional<BOX2I>
+            {
+                using GeomType = std::decay_t<decltype( geom )>;
+
+                if constexpr( std::is_same_v<GeomType, SEG> )
+                    return BOX2I::ByCorners( geom.A, geom.B );
+                else if constexpr( std::is_same_v<GeomType, CIRCLE> )
+                    return BOX2I::ByCenter( geom.Center, VECTOR2I( geom.Radius, geom.Radius ) * 2 );
+                else if constexpr( std::is_same_v<GeomType, SHAPE_ARC> )
+                    return geom.BBox();
+                else if constexpr( std::is_same_v<GeomType, BOX2I> )
+                    return geom;
+                else
+                    return std::nullopt;
+            },
+            aGeom );
+
+    if( bbox )
+    {
+        bbox->Normalize();
+        bbox->Inflate( 1 );
+    }
+
+    return bbox;
+}
+
+
+/**
+ * The anchors of most items only depend on the item itself and on the view settings, so they
+ * can be reused between snap queries.  Footprints and zones (and polygons) also get anchors
+ * for the pads under the cursor or the nearest point of their outline, and groups delegate
+ * to their members.
+ */
+bool AnchorsAreCacheable( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_FOOTPRINT_T:
+    case PCB_ZONE_T:
+    case PCB_GROUP_T:
+        return false;
+
+    case PCB_SHAPE_T:
+    case PCB_TEXTBOX_T:
+        return static_cast<const PCB_SHAPE*>( aItem )->GetShape() != SHAPE_T::POLY;
+
+    default:
+        return true;
+    }
+}
+
 } // namespace
 
 PCB_GRID_HELPER::PCB_GRID_HELPER() :
@@ -562,19 +624,20 @@ VECTOR2I PCB_GRID_HELPER::BestSnapAnchor( const VECTOR2I& aOrigin, const LSET& a
     const BOX2I visibilityHorizon = BOX2ISafe( VECTOR2D( aOrigin ) - snapRange / 2.0,
                                                VECTOR2D( snapRange, snapRange ) );
 
+    const int hysteresisWorld = KiROUND( m_toolMgr->GetView()->ToWorld( ADVANCED_CFG::GetCfg().m_SnapHysteresis ) );
+    const int snapIn = std::max( 0, snapRange - hysteresisWorld );
+    const int snapOut = snapRange + hysteresisWorld;
+
     clearAnchors();
 
+    // Intersections further away than snapOut can never be snapped to, so don't compute them
     const std::vector<BOARD_ITEM*> visibleItems = queryVisible( visibilityHorizon, aSkip );
-    computeAnchors( visibleItems, aOrigin, false, nullptr, &aLayers, false );
+    computeAnchors( visibleItems, aOrigin, false, nullptr, &aLayers, false, snapOut );
 
     ANCHOR*  nearest = nearestAnchor( aOrigin, SNAPPABLE );
     VECTOR2I nearestGrid = Align( aOrigin, aGrid );
     const VECTOR2D gridSize = GetGridSize( aGrid );
 
-    const int hysteresisWorld = KiROUND( m_toolMgr->GetView()->ToWorld( ADVANCED_CFG::GetCfg().m_SnapHysteresis ) );
-    const int snapIn = std::max( 0, snapRange - hysteresisWorld );
-    const int snapOut = snapRange + hysteresisWorld;
-
     wxLogTrace( traceSnap, "  snapRange=%d, snapIn=%d, snapOut=%d, hysteresis=%d",
                 snapRange, snapIn, snapOut, hysteresisWorld );
     wxLogTrace( traceSnap, "  visibleItems count=%zu, anchors count=%zu",
@@ -1063,7 +1126,8 @@ struct PCB_INTERSECTABLE
 void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
                                       const VECTOR2I& aRefPos, bool aFrom,
                                       const PCB_SELECTION_FILTER_OPTIONS* aSelectionFilter,
-                                      const LSET* aMatchLayers, bool aForDrag )
+                                      const LSET* aMatchLayers, bool aForDrag,
+                                      int aIntersectionRange )
 {
     std::vector<PCB_INTERSECTABLE> intersectables;
 
@@ -1084,6 +1148,12 @@ void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
                 return true;
             };
 
+    const bool useAnchorCache = !aFrom && !aSelectionFilter;
+
+    // The context is the same for all the items, so the cache is only checked against it once
+    if( useAnchorCache )
+        setAnchorCacheContext( anchorContextHash() );
+
     const auto processItem =
             [&]( BOARD_ITEM& item )
             {
@@ -1092,7 +1162,10 @@ void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
                     return;
 
                 // First, add all the key points of the item itself
-                computeAnchors( &item, aRefPos, aFrom, aSelectionFilter );
+                if( useAnchorCache )
+                    computeCachedAnchors( &item, aRefPos );
+                else
+                    computeAnchors( &item, aRefPos, aFrom, aSelectionFilter );
 
                 // If we are computing intersections, construct the relevant intersectables
                 // Points on elements also use the intersectables.
@@ -1158,10 +1231,36 @@ void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
 
     if( computeIntersections )
     {
+        // When the range is limited, the bounding boxes of the bounded geometries reject most
+        // of the pairs before running the (much more expensive) exact intersection tests.
+        const bool        limitRange = aIntersectionRange > 0;
+        const double      rangeSize = 2.0 * aIntersectionRange;
+        const BOX2I       rangeBox = BOX2ISafe( VECTOR2D( aRefPos ) - aIntersectionRange,
+                                                VECTOR2D( rangeSize, rangeSize ) );
+        const SEG::ecoord rangeSq = SEG::Square( aIntersectionRange );
+
+        std::vector<std::optional<BOX2I>> bboxes;
+        std::vector<bool>                 inRange;
+
+        if( limitRange )
+        {
+            bboxes.reserve( intersectables.size() );
+            inRange.reserve( intersectables.size() );
+
+            for( const PCB_INTERSECTABLE& intersectable : intersectables )
+            {
+                bboxes.push_back( GetIntersectableBBox( intersectable.Geometry ) );
+                inRange.push_back( !bboxes.back() || bboxes.back()->Intersects( rangeBox ) );
+            }
+        }
+
         for( std::size_t ii = 0; ii < intersectables.size(); ++ii )
         {
             const PCB_INTERSECTABLE& intersectableA = intersectables[ii];
 
+            if( limitRange && !inRange[ii] )
+                continue;
+
             for( std::size_t jj = ii + 1; jj < intersectables.size(); ++jj )
             {
                 const PCB_INTERSECTABLE& intersectableB = intersectables[jj];
@@ -1171,6 +1270,15 @@ void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
                 if( intersectableA.Item == intersectableB.Item )
                     continue;
 
+                if( limitRange )
+                {
+                    if( !inRange[jj] )
+                        continue;
+
+                    if( bboxes[ii] && bboxes[jj] && !bboxes[ii]->Intersects( *bboxes[jj] ) )
+                        continue;
+                }
+
                 std::vector<VECTOR2I>      intersections;
                 const INTERSECTION_VISITOR visitor{ intersectableA.Geometry, intersections };
 
@@ -1179,6 +1287,9 @@ void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
                 // For each intersection, add an intersection snap anchor
                 for( const VECTOR2I& intersection : intersections )
                 {
+                    if( limitRange && ( intersection - aRefPos ).SquaredEuclideanNorm() > rangeSq )
+                        continue;
+
                     std::vector<EDA_ITEM*> items = {
                         intersectableA.Item,
                         intersectableB.Item,
@@ -1212,6 +1323,83 @@ void PCB_GRID_HELPER::computeAnchors( const std::vector<BOARD_ITEM*>& aItems,
 }
 
 
+size_t PCB_GRID_HELPER::anchorContextHash() const
+{
+    KIGFX::VIEW*     view = m_toolMgr->GetView();
+    RENDER_SETTINGS* settings = view->GetPainter()->GetSettings();
+    size_t           hash = hash_val( view->GetScale(), m_maskTypes, settings->GetHighContrast(),
+                                      (int) settings->GetPrimaryHighContrastLayer(),
+                                      (int) m_magneticSettings->pads,
+                                      (int) m_magneticSettings->tracks,
+                                      m_magneticSettings->graphics,
+                                      m_magneticSettings->allLayers );
+
+    for( int layer : settings->GetHighContrastLayers() )
+        hash_combine( hash, layer );
+
+    if( BOARD* board = static_cast<BOARD*>( m_toolMgr->GetModel() ) )
+    {
+        hash_combine( hash, static_cast<const BASE_SET&>( board->GetVisibleLayers() ),
+                      static_cast<const GAL_BASE_SET&>( board->GetVisibleElements() ) );
+    }
+
+    return hash;
+}
+
+
+void PCB_GRID_HELPER::setAnchorCacheContext( size_t aContext )
+{
+    if( aContext != m_anchorCacheContext )
+    {
+        m_itemAnchorCache.clear();
+        m_anchorCacheContext = aContext;
+    }
+}
+
+
+bool PCB_GRID_HELPER::insertCachedAnchors( const BOARD_ITEM* aItem, const ANCHOR_CACHE_KEY& aKey )
+{
+    auto it = m_itemAnchorCache.find( aItem );
+
+    if( it == m_itemAnchorCache.end() || !( it->second.m_key == aKey ) )
+        return false;
+
+    m_anchors.insert( m_anchors.end(), it->second.m_anchors.begin(), it->second.m_anchors.end() );
+    return true;
+}
+
+
+void PCB_GRID_HELPER::cacheAnchors( const BOARD_ITEM* aItem, const ANCHOR_CACHE_KEY& aKey,
+                                    size_t aFirst )
+{
+    CACHED_ANCHORS& entry = m_itemAnchorCache[aItem];
+    entry.m_key = aKey;
+    entry.m_anchors.assign( m_anchors.begin() + aFirst, m_anchors.end() );
+}
+
+
+void PCB_GRID_HELPER::computeCachedAnchors( BOARD_ITEM* aItem, const VECTOR2I& aRefPos )
+{
+    if( !AnchorsAreCacheable( aItem ) )
+    {
+        computeAnchors( aItem, aRefPos, false, nullptr );
+        return;
+    }
+
+    const ANCHOR_CACHE_KEY key = { aItem->GetBoundingBox(),
+                                   m_toolMgr->GetView()->IsVisible( aItem ),
+                                   aItem->IsMoving() };
+
+    if( insertCachedAnchors( aItem, key ) )
+        return;
+
+    const size_t first = m_anchors.size();
+
+    computeAnchors( aItem, aRefPos, false, nullptr );
+    cacheAnchors( aItem, key, first );
+}
+
+
 // Padstacks report a set of "unique" layers, which may each represent one or more
 // "real" layers. This function takes a unique layer and checks if it applies to the
 // given "real" layer.
@@ -26,6 +26,7 @@
 #ifndef PCB_GRID_HELPER_H
 #define PCB_GRID_HELPER_H
 
+#include <unordered_map>
 #include <vector>
 
 #include <pcb_item_containers.h>
@@ -92,12 +93,31 @@ public:
                 }
             }
         }
+
+        m_itemAnchorCache.clear();
     }
 
     virtual void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override
     {
         // This is a bulk-remove.  Simply clearing the snap item will be the most performant.
         m_snapItem = std::nullopt;
+        m_itemAnchorCache.clear();
+    }
+
+    virtual void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override
+    {
+        m_itemAnchorCache.clear();
+    }
+
+    virtual void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override
+    {
+        m_itemAnchorCache.clear();
+    }
+
+    void FullReset() override
+    {
+        GRID_HELPER::FullReset();
+        m_itemAnchorCache.clear();
     }
 
     /**
@@ -145,10 +165,13 @@ private:
      * computeAnchors inserts the local anchor points in to the grid helper for the specified
      * container of board items, including points implied by intersections or other relationships
      * between the items.
+     *
+     * @param aIntersectionRange if positive, only the intersections closer than this distance
+     *                           to \a aRefPos are computed.
      */
     void computeAnchors( const std::vector<BOARD_ITEM*>& aItems, const VECTOR2I& aRefPos,
                          bool aFrom, const PCB_SELECTION_FILTER_OPTIONS* aSelectionFilter,
-                         const LSET* aLayers, bool aForDrag );
+                         const LSET* aLayers, bool aForDrag, int aIntersectionRange = -1 );
 
     /**
      * computeAnchors inserts the local anchor points in to the grid helper for the specified
@@ -161,10 +184,68 @@ private:
     void computeAnchors( BOARD_ITEM* aItem, const VECTOR2I& aRefPos, bool aFrom,
                          const PCB_SELECTION_FILTER_OPTIONS* aSelectionFilter );
 
+    /**
+     * Insert the snap anchors of a single item, reusing the anchors computed by a previous
+     * query when neither the item nor the snapping context changed since.  The context must
+     * have been set with setAnchorCacheContext().
+     */
+    void computeCachedAnchors( BOARD_ITEM* aItem, const VECTOR2I& aRefPos );
+
+    /**
+     * @return a hash of the view and magnetic settings which the anchors of an item depend on.
+     */
+    size_t anchorContextHash() const;
+
+protected:
+    /**
+     * State of an item which its anchors depend on.  Items edited interactively are only
+     * committed at the end of the edit, so cached anchors are checked against it.
+     */
+    struct ANCHOR_CACHE_KEY
+    {
+        BOX2I m_bbox;
+        bool  m_visible;
+        bool  m_moving;     ///< Moving items are snapped to even when hidden
+
+        bool operator==( const ANCHOR_CACHE_KEY& aOther ) const
+        {
+            return m_bbox == aOther.m_bbox && m_visible == aOther.m_visible
+                   && m_moving == aOther.m_moving;
+        }
+    };
+
+    /**
+     * Flush the cached anchors if \a aContext, from anchorContextHash(), differs from the
+     * context they were computed in.
+     */
+    void setAnchorCacheContext( size_t aContext );
+
+    /**
+     * Append the anchors cached for \a aItem to m_anchors if they were computed for \a aKey.
+     *
+     * @return false if there are no such anchors.
+     */
+    bool insertCachedAnchors( const BOARD_ITEM* aItem, const ANCHOR_CACHE_KEY& aKey );
+
+    /**
+     * Cache the anchors of \a aItem, which are the ones from \a aFirst to the end of m_anchors.
+     */
+    void cacheAnchors( const BOARD_ITEM* aItem, const ANCHOR_CACHE_KEY& aKey, size_t aFirst );
+
 private:
+    struct CACHED_ANCHORS
+    {
+        ANCHOR_CACHE_KEY    m_key;       ///< Item state when the anchors were computed
+        std::vector<ANCHOR> m_anchors;
+    };
+
     MAGNETIC_SETTINGS*         m_magneticSettings;
 
     std::vector<NEARABLE_GEOM> m_pointOnLineCandidates;
+
+    ///< Per-item snap anchors, flushed by board commits and snapping context changes
+    std::unordered_map<const BOARD_ITEM*, CACHED_ANCHORS> m_itemAnchorCache;
+    size_t                                                 m_anchorCacheContext = 0;
 };
 
 #endif
@@ -26,6 +26,7 @@
 #include <advanced_config.h>
 #include <bitmaps.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/poly_set_hit_tester.h>
 #include <geometry/shape_null.h>
 #include <pcb_edit_frame.h>
 #include <pcb_screen.h>
@@ -462,6 +463,8 @@ bool ZONE::UnFill()
         pair.second->RemoveAllContours();
     }
 
+    fillChanged();
+
     m_isFilled = false;
     m_fillFlags.reset();
 
@@ -823,6 +826,40 @@ bool ZONE::HitTestFilledArea( PCB_LAYER_ID aLayer, const VECTOR2I& aRefPos, int
 }
 
 
+bool ZONE::HitTestFilledAreaCached( PCB_LAYER_ID aLayer, const VECTOR2I& aRefPos,
+                                    int aAccuracy ) const
+{
+    const BOARD* board = GetBoard();
+
+    if( !board || GetIsRuleArea() || !m_FilledPolysList.count( aLayer ) )
+        return HitTestFilledArea( aLayer, aRefPos, aAccuracy );
+
+    const std::shared_ptr<SHAPE_POLY_SET>& fill = m_FilledPolysList.at( aLayer );
+    const PTR_LAYER_CACHE_KEY              key = { const_cast<ZONE*>( this ), aLayer };
+    std::shared_ptr<POLY_SET_HIT_TESTER>   tester;
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
+
+        auto it = board->m_ZoneFillHitTestCache.find( key );
+
+        if( it != board->m_ZoneFillHitTestCache.end() )
+            tester = it->second;
+    }
+
+    // Fills moved or refilled without a commit (e.g. while dragging) don't match anymore
+    if( !tester || !tester->IsValidFor( fill.get(), GetFillRevision() ) )
+    {
+        tester = std::make_shared<POLY_SET_HIT_TESTER>( fill, GetFillRevision() );
+
+        std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
+        board->m_ZoneFillHitTestCache[ key ] = tester;
+    }
+
+    return tester->Contains( aRefPos, aAccuracy );
+}
+
+
 bool ZONE::HitTestCutout( const VECTOR2I& aRefPos, int* aOutlineIdx, int* aHoleIdx ) const
 {
     // Iterate over each outline polygon in the zone and then iterate over
@@ -988,6 +1025,8 @@ void ZONE::Move( const VECTOR2I& offset )
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Move( offset );
 
+    fillChanged();
+
     /*
      * move boundingbox cache
      *
@@ -1040,6 +1079,8 @@ void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
     /* rotate filled areas: */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Rotate( aAngle, aCentre );
+
+    fillChanged();
 }
 
 
@@ -1083,6 +1124,8 @@ void ZONE::Mirror( const VECTOR2I& aMirrorRef, FLIP_DIRECTION aFlipDirection )
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Mirror( aMirrorRef, aFlipDirection );
+
+    fillChanged();
 }
 
 
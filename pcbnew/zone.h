@@ -26,6 +26,7 @@
 #define ZONE_H
 
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <map>
@@ -356,6 +357,13 @@ public:
      */
     bool HitTestFilledArea( PCB_LAYER_ID aLayer, const VECTOR2I& aRefPos, int aAccuracy = 0 ) const;
 
+    /**
+     * Same as HitTestFilledArea(), but uses hit-test structures cached by the parent board
+     * until its next modification.  Meant for repeated interactive queries such as selection.
+     */
+    bool HitTestFilledAreaCached( PCB_LAYER_ID aLayer, const VECTOR2I& aRefPos,
+                                  int aAccuracy = 0 ) const;
+
     /**
      * Test if the given point is contained within a cutout of the zone.
      *
@@ -599,12 +607,29 @@ public:
         return m_FilledPolysList.at( aLayer );
     }
 
+    /**
+     * @return the filled polygons on \a aLayer, which the caller may edit in place.  Bumps the
+     *         fill revision, so callers which only read the fill should use the const version.
+     */
     SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer )
+    {
+        wxASSERT( m_FilledPolysList.count( aLayer ) );
+        fillChanged();
+        return m_FilledPolysList.at( aLayer ).get();
+    }
+
+    const SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer ) const
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
         return m_FilledPolysList.at( aLayer ).get();
     }
 
+    /**
+     * @return a counter bumped each time the fills may have been edited in place, to tell
+     *         whether structures derived from them are still valid.
+     */
+    unsigned GetFillRevision() const { return m_fillRevision.load( std::memory_order_relaxed ); }
+
     /**
      * Create a list of triangles that "fill" the solid areas used for instance to draw
      * these solid areas on OpenGL.
@@ -796,6 +821,8 @@ public:
 protected:
     virtual void swapData( BOARD_ITEM* aImage ) override;
 
+    void fillChanged() { m_fillRevision.fetch_add( 1, std::memory_order_relaxed ); }
+
 protected:
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
@@ -897,6 +924,9 @@ protected:
     /// A hash value used in zone filling calculations to see if the filled areas are up to date
     std::map<PCB_LAYER_ID, HASH_128>       m_filledPolysHash;
 
+    /// See GetFillRevision().  Atomic as the fills may be edited from DRC threads.
+    std::atomic<unsigned>                  m_fillRevision{ 0 };
+
     ZONE_BORDER_DISPLAY_STYLE m_borderStyle;       // border display style, see enum above
     int                       m_borderHatchPitch;  // for DIAGONAL_EDGE, distance between 2 lines
     std::vector<SEG>          m_borderHatchLines;  // hatch lines
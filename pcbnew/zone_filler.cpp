@@ -24,6 +24,7 @@
  */
 
 #include <future>
+#include <optional>
 #include <hash.h>
 #include <set>
 #include <unordered_set>
@@ -31,6 +32,7 @@
 #include <advanced_config.h>
 #include <board.h>
 #include <core/profile.h>
+#include <core/trace_events.h>
 
 /**
  * Trace mask for zone filler timing information.
@@ -57,6 +59,7 @@ static const wxChar traceZoneFiller[] = wxT( "KICAD_ZONE_FILLER" );
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/vertex_set.h>
+#include <geometry/rtree.h>
 #include <kidialog.h>
 #include <thread_pool.h>
 #include <math/util.h>      // for KiROUND
@@ -300,6 +303,162 @@ struct TRACK_KNOCKOUT_KEY_HASH
     }
 };
 
+
+
+/**
+ * Scanline classification of the cells of a hatch grid against a polygon set.
+ *
+ * For each grid row the polygon edges crossing the row band are collected once.  A cell
+ * touched by none of them is either fully inside or fully outside the polygons, which is
+ * decided by the crossing parity along the row center.  Only the remaining boundary cells
+ * need an actual boolean clipping.
+ */
+class HATCH_SCANLINE
+{
+public:
+    enum CELL
+    {
+        OUTSIDE,
+        INSIDE,
+        BOUNDARY
+    };
+
+    /**
+     * @param aPolys is the polygon set, in the grid coordinate frame.
+     * @param aTop is the top of the cells of the first row.
+     * @param aPitch is the distance between two rows.
+     * @param aCellSize is the size of a (square) cell.
+     * @param aRowCount is the number of rows.
+     * @param aMargin is added around each cell to absorb rounding errors.
+     */
+    HATCH_SCANLINE( const SHAPE_POLY_SET& aPolys, int aTop, int aPitch, int aCellSize,
+                    int aRowCount, int aMargin ) :
+            m_top( aTop ),
+            m_pitch( aPitch ),
+            m_cellSize( aCellSize ),
+            m_margin( aMargin ),
+            m_boundaries( std::max( aRowCount, 0 ) ),
+            m_crossings( std::max( aRowCount, 0 ) )
+    {
+        for( auto it = aPolys.CIterateSegmentsWithHoles(); it; it++ )
+            addEdge( *it );
+
+        for( std::vector<std::pair<int, int>>& spans : m_boundaries )
+        {
+            std::sort( spans.begin(), spans.end() );
+
+            // Merge overlapping spans so that they can be binary-searched
+            std::vector<std::pair<int, int>> merged;
+
+            for( const std::pair<int, int>& span : spans )
+            {
+                if( !merged.empty() && span.first <= merged.back().second )
+                    merged.back().second = std::max( merged.back().second, span.second );
+                else
+                    merged.push_back( span );
+            }
+
+            spans = std::move( merged );
+        }
+
+        for( std::vector<int>& crossings : m_crossings )
+            std::sort( crossings.begin(), crossings.end() );
+    }
+
+    /**
+     * @return the state of the cell of row \a aRow whose left side is at \a aLeft.
+     */
+    CELL Classify( int aRow, int aLeft ) const
+    {
+        if( aRow < 0 || aRow >= (int) m_boundaries.size() )
+            return OUTSIDE;
+
+        const std::vector<std::pair<int, int>>& spans = m_boundaries[aRow];
+        const int left = aLeft - m_margin;
+        const int right = aLeft + m_cellSize + m_margin;
+
+        // First span ending at or after the left side of the cell
+        auto span = std::lower_bound( spans.begin(), spans.end(), left,
+                                      []( const std::pair<int, int>& aSpan, int aX )
+                                      {
+                                          return aSpan.second < aX;
+                                      } );
+
+        if( span != spans.end() && span->first <= right )
+            return BOUNDARY;
+
+        const std::vector<int>& crossings = m_crossings[aRow];
+        const int               center = aLeft + m_cellSize / 2;
+        size_t count = std::lower_bound( crossings.begin(), crossings.end(), center )
+                       - crossings.begin();
+
+        return ( count % 2 ) ? INSIDE : OUTSIDE;
+    }
+
+private:
+    static int xAt( const SEG& aSeg, int64_t aY )
+    {
+        return aSeg.A.x + (int) rescale( (int64_t) aSeg.B.x - aSeg.A.x, aY - aSeg.A.y,
+                                         (int64_t) aSeg.B.y - aSeg.A.y );
+    }
+
+    void addEdge( const SEG& aSeg )
+    {
+        const int64_t ymin = std::min( aSeg.A.y, aSeg.B.y );
+        const int64_t ymax = std::max( aSeg.A.y, aSeg.B.y );
+        const int     rowCount = (int) m_boundaries.size();
+
+        // Rows whose (inflated) band overlaps the edge
+        int64_t first = ( ymin - m_margin - m_cellSize - m_top ) / m_pitch - 1;
+        int64_t last = ( ymax + m_margin - m_top ) / m_pitch + 1;
+
+        first = std::max<int64_t>( first, 0 );
+        last = std::min<int64_t>( last, rowCount - 1 );
+
+        for( int64_t row = first; row <= last; row++ )
+        {
+            const int64_t bandTop = m_top + row * m_pitch - m_margin;
+            const int64_t bandBottom = m_top + row * m_pitch + m_cellSize + m_margin;
+
+            if( ymax < bandTop || ymin > bandBottom )
+                continue;
+
+            // x extent of the part of the edge inside the band
+            int x0, x1;
+
+            if( ymin == ymax )
+            {
+                x0 = std::min( aSeg.A.x, aSeg.B.x );
+                x1 = std::max( aSeg.A.x, aSeg.B.x );
+            }
+            else
+            {
+                x0 = xAt( aSeg, std::max( ymin, bandTop ) );
+                x1 = xAt( aSeg, std::min( ymax, bandBottom ) );
+
+                if( x0 > x1 )
+                    std::swap( x0, x1 );
+            }
+
+            m_boundaries[row].emplace_back( x0, x1 );
+
+            // Half-open test so that a vertex on the scanline is only counted once
+            const int64_t centerY = m_top + row * m_pitch + m_cellSize / 2;
+
+            if( ymin <= centerY && centerY < ymax )
+                m_crossings[row].push_back( xAt( aSeg, centerY ) );
+        }
+    }
+
+    int m_top;
+    int m_pitch;
+    int m_cellSize;
+    int m_margin;
+
+    std::vector<std::vector<std::pair<int, int>>> m_boundaries;   ///< Merged edge spans per row
+    std::vector<std::vector<int>>                 m_crossings;    ///< Center line crossings per row
+};
+
 } // anonymous namespace
 
 
@@ -341,6 +500,9 @@ void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
  */
 bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aParent )
 {
+    TRACE_ZONE traceZone( "Fill zones", "zones" );
+    TRACE_EVENTS::Instance().AddCounter( "Zones to fill", static_cast<int64_t>( aZones.size() ) );
+
     std::lock_guard<KISPINLOCK> lock( m_board->GetConnectivity()->GetLock() );
 
     std::vector<std::pair<ZONE*, PCB_LAYER_ID>>               toFill;
@@ -2696,6 +2858,19 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     testAreas.BuildBBoxCaches();
     int interval = 0;
 
+    // Index the spokes so that each spoke end is only tested against the spokes around it
+    // rather than against every spoke of the zone layer.
+    RTree<const SHAPE_LINE_CHAIN*, int, 2, double> spokeIndex;
+
+    for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
+    {
+        BOX2I     bbox = spoke.BBox();
+        const int mmin[2] = { bbox.GetLeft(), bbox.GetTop() };
+        const int mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        spokeIndex.Insert( mmin, mmax, &spoke );
+    }
+
     SHAPE_POLY_SET debugSpokes;
 
     for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
@@ -2720,21 +2895,34 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
             interval = 0;
         }
 
-        // Hit-test against other spokes
-        for( const SHAPE_LINE_CHAIN& other : thermalSpokes )
+        // Hit-test against other spokes.  The accuracy passed to PointInside() is 1, so only
+        // the spokes whose box is within 1 IU of the test point can match.
+        const int mmin[2] = { testPt.x - 1, testPt.y - 1 };
+        const int mmax[2] = { testPt.x + 1, testPt.y + 1 };
+        bool      connected = false;
+
+        spokeIndex.Search( mmin, mmax,
+                [&]( const SHAPE_LINE_CHAIN* other ) -> bool
+                {
+                    // Hit test in both directions to avoid interactions with round-off errors.
+                    // (See https://gitlab.com/kicad/code/kicad/-/issues/13316.)
+                    if( other != &spoke
+                        && other->PointInside( testPt, 1, USE_BBOX_CACHES )
+                        && spoke.PointInside( other->CPoint( 3 ), 1, USE_BBOX_CACHES ) )
+                    {
+                        connected = true;
+                        return false;
+                    }
+
+                    return true;
+                } );
+
+        if( connected )
         {
-            // Hit test in both directions to avoid interactions with round-off errors.
-            // (See https://gitlab.com/kicad/code/kicad/-/issues/13316.)
-            if( &other != &spoke
-                && other.PointInside( testPt, 1, USE_BBOX_CACHES )
-                && spoke.PointInside( other.CPoint( 3 ), 1, USE_BBOX_CACHES ) )
-            {
-                if( m_debugZoneFiller )
-                    debugSpokes.AddOutline( spoke );
+            if( m_debugZoneFiller )
+                debugSpokes.AddOutline( spoke );
 
-                aFillPolys.AddOutline( spoke );
-                break;
-            }
+            aFillPolys.AddOutline( spoke );
         }
     }
 
@@ -3052,6 +3240,50 @@ void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
     // The boundary may be off by MaxError
     int epsilon = bds.m_MaxError;
 
+    // The unrotated spoke box of a pad only depends on its shape on this layer.  Boards with
+    // many thermally-connected pads typically use a handful of padstacks, so compute each one
+    // once rather than copying every pad to measure it.
+    using PAD_SHAPE_KEY = std::tuple<PAD_SHAPE, VECTOR2I, VECTOR2I, int, double, int>;
+
+    std::map<PAD_SHAPE_KEY, BOX2I> padSpokeBoxes;
+
+    auto padSpokeBox =
+            [&]( const PAD* aPad ) -> BOX2I
+            {
+                auto measure =
+                        [&]() -> BOX2I
+                        {
+                            // Since the bounding-box needs to be correclty rotated we use a dummy
+                            // pad to keep from dirtying the real pad's cached shapes.
+                            PAD dummy_pad( *aPad );
+                            dummy_pad.SetOrientation( ANGLE_0 );
+
+                            // Spokes are from center of pad shape, not from hole. So the dummy pad
+                            // has no shape offset and is at position 0,0
+                            dummy_pad.SetPosition( VECTOR2I( 0, 0 ) );
+                            dummy_pad.SetOffset( aLayer, VECTOR2I( 0, 0 ) );
+
+                            return dummy_pad.GetBoundingBox( aLayer );
+                        };
+
+                // Custom shapes also depend on their primitives
+                if( aPad->GetShape( aLayer ) == PAD_SHAPE::CUSTOM )
+                    return measure();
+
+                PAD_SHAPE_KEY key( aPad->GetShape( aLayer ), aPad->GetSize( aLayer ),
+                                   aPad->GetDelta( aLayer ),
+                                   aPad->GetRoundRectCornerRadius( aLayer ),
+                                   aPad->GetChamferRectRatio( aLayer ),
+                                   aPad->GetChamferPositions( aLayer ) );
+
+                auto it = padSpokeBoxes.find( key );
+
+                if( it == padSpokeBoxes.end() )
+                    it = padSpokeBoxes.emplace( key, measure() ).first;
+
+                return it->second;
+            };
+
     for( BOARD_ITEM* item : aSpokedPadsList )
     {
         // We currently only connect to pads, not pad holes
@@ -3346,19 +3578,9 @@ void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
             VECTOR2I  position;
             EDA_ANGLE orientation;
 
-            // Since the bounding-box needs to be correclty rotated we use a dummy pad to keep
-            // from dirtying the real pad's cached shapes.
             if( pad )
             {
-                PAD dummy_pad( *pad );
-                dummy_pad.SetOrientation( ANGLE_0 );
-
-                // Spokes are from center of pad shape, not from hole. So the dummy pad has no shape
-                // offset and is at position 0,0
-                dummy_pad.SetPosition( VECTOR2I( 0, 0 ) );
-                dummy_pad.SetOffset( aLayer, VECTOR2I( 0, 0 ) );
-
-                spokesBox = dummy_pad.GetBoundingBox( aLayer );
+                spokesBox = padSpokeBox( pad );
                 position = pad->ShapePos( aLayer );
                 orientation = pad->GetOrientation();
             }
@@ -3623,9 +3845,6 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
         }
     }
 
-    // Build holes
-    SHAPE_POLY_SET holes;
-
     auto& defaultOffsets = m_board->GetDesignSettings().m_ZoneLayerProperties;
     auto& localOffsets = aZone->LayerProperties();
 
@@ -3637,11 +3856,80 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
     int x_offset = bbox.GetX() - ( bbox.GetX() ) % gridsize - gridsize;
     int y_offset = bbox.GetY() - ( bbox.GetY() ) % gridsize - gridsize;
 
+    int deflated_thickness = aZone->GetHatchThickness() - aZone->GetMinThickness();
+
+    // Don't let thickness drop below maxError * 2 or it might not get reinflated.
+    deflated_thickness = std::max( deflated_thickness, maxError * 2 );
+
+    // The fill has already been deflated to ensure GetMinThickness() so we just have to
+    // account for anything beyond that.
+    SHAPE_POLY_SET deflatedFilledPolys = aFillPolys.CloneDropTriangulation();
+    deflatedFilledPolys.ClearArcs();
+    deflatedFilledPolys.Deflate( deflated_thickness, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
+
+    SHAPE_POLY_SET deflatedOutline = aZone->Outline()->CloneDropTriangulation();
+    deflatedOutline.ClearArcs();
+    deflatedOutline.Deflate( aZone->GetMinThickness(), CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
+
+    // Classify the grid cells in the grid frame: holes entirely inside both clipping areas are
+    // kept as is, holes entirely outside of one of them are never generated, and only the holes
+    // crossing an edge go through the boolean clipping below.  On large planes this replaces
+    // booleans over millions of hole vertices by booleans over the outline ones.
+    VECTOR2I gridOffset( offset.x % gridsize, offset.y % gridsize );
+    RotatePoint( gridOffset, -aZone->GetHatchOrientation() );
+
+    int rowCount = ( bbox.GetBottom() - y_offset ) / gridsize + 1;
+    int cellTop = y_offset + gridOffset.y;
+
+    // Rotation round-off is a few IU; one micron is plenty
+    int margin = pcbIUScale.mmToIU( 0.001 );
+
+    std::optional<HATCH_SCANLINE> fillScanline;
+    std::optional<HATCH_SCANLINE> outlineScanline;
+
+    if( ADVANCED_CFG::GetCfg().m_ZoneFillHatchScanline )
+    {
+        SHAPE_POLY_SET gridFilledPolys = deflatedFilledPolys.CloneDropTriangulation();
+        SHAPE_POLY_SET gridOutline = deflatedOutline.CloneDropTriangulation();
+
+        if( !aZone->GetHatchOrientation().IsZero() )
+        {
+            gridFilledPolys.Rotate( - aZone->GetHatchOrientation() );
+            gridOutline.Rotate( - aZone->GetHatchOrientation() );
+        }
+
+        fillScanline.emplace( gridFilledPolys, cellTop, gridsize, hole_size, rowCount, margin );
+        outlineScanline.emplace( gridOutline, cellTop, gridsize, hole_size, rowCount, margin );
+    }
+
+    // Without the scanline every hole is clipped
+    auto classify =
+            [&]( const std::optional<HATCH_SCANLINE>& aScanline, int aRow, int aLeft )
+            {
+                return aScanline ? aScanline->Classify( aRow, aLeft ) : HATCH_SCANLINE::BOUNDARY;
+            };
+
+    // Build holes
+    SHAPE_POLY_SET holes;          // crossing the clipping areas
+    SHAPE_POLY_SET innerHoles;     // entirely inside the clipping areas
 
-    for( int xx = x_offset; xx <= bbox.GetRight(); xx += gridsize )
+    for( int row = 0; row < rowCount; row++ )
     {
-        for( int yy = y_offset; yy <= bbox.GetBottom(); yy += gridsize )
+        int yy = y_offset + row * gridsize;
+
+        for( int xx = x_offset; xx <= bbox.GetRight(); xx += gridsize )
         {
+            HATCH_SCANLINE::CELL fillState = classify( fillScanline, row, xx + gridOffset.x );
+
+            if( fillState == HATCH_SCANLINE::OUTSIDE )
+                continue;
+
+            HATCH_SCANLINE::CELL outlineState = classify( outlineScanline, row,
+                                                          xx + gridOffset.x );
+
+            if( outlineState == HATCH_SCANLINE::OUTSIDE )
+                continue;
+
             // Generate hole
             SHAPE_LINE_CHAIN hole( hole_base );
             hole.Move( VECTOR2I( xx, yy ) );
@@ -3653,33 +3941,27 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
 
             hole.Move( VECTOR2I( offset.x % gridsize, offset.y % gridsize ) );
 
-            holes.AddOutline( hole );
+            if( fillState == HATCH_SCANLINE::INSIDE && outlineState == HATCH_SCANLINE::INSIDE )
+                innerHoles.AddOutline( hole );
+            else
+                holes.AddOutline( hole );
         }
     }
 
     holes.ClearArcs();
+    innerHoles.ClearArcs();
 
     DUMP_POLYS_TO_COPPER_LAYER( holes, In10_Cu, wxT( "hatch-holes" ) );
 
-    int deflated_thickness = aZone->GetHatchThickness() - aZone->GetMinThickness();
-
-    // Don't let thickness drop below maxError * 2 or it might not get reinflated.
-    deflated_thickness = std::max( deflated_thickness, maxError * 2 );
-
-    // The fill has already been deflated to ensure GetMinThickness() so we just have to
-    // account for anything beyond that.
-    SHAPE_POLY_SET deflatedFilledPolys = aFillPolys.CloneDropTriangulation();
-    deflatedFilledPolys.ClearArcs();
-    deflatedFilledPolys.Deflate( deflated_thickness, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
     holes.BooleanIntersection( deflatedFilledPolys );
     DUMP_POLYS_TO_COPPER_LAYER( holes, In11_Cu, wxT( "fill-clipped-hatch-holes" ) );
 
-    SHAPE_POLY_SET deflatedOutline = aZone->Outline()->CloneDropTriangulation();
-    deflatedOutline.ClearArcs();
-    deflatedOutline.Deflate( aZone->GetMinThickness(), CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
     holes.BooleanIntersection( deflatedOutline );
     DUMP_POLYS_TO_COPPER_LAYER( holes, In12_Cu, wxT( "outline-clipped-hatch-holes" ) );
 
+    for( int ii = 0; ii < innerHoles.OutlineCount(); ii++ )
+        holes.AddOutline( innerHoles.Outline( ii ) );
+
     // Now filter truncated holes to avoid small holes in pattern
     // It happens for holes near the zone outline
     for( int ii = 0; ii < holes.OutlineCount(); )
@@ -3696,21 +3978,46 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
     // to the hatch webbing even when the hatch gap is larger than the thermal ring.
     if( aThermalRings.OutlineCount() > 0 )
     {
-        BOX2I thermalBBox = aThermalRings.BBox();
+        // Index the rings so that each hole is only tested against the rings around it
+        std::vector<SHAPE_POLY_SET>                  rings;
+        RTree<const SHAPE_POLY_SET*, int, 2, double> ringIndex;
+
+        rings.reserve( aThermalRings.OutlineCount() );
+
+        for( int ii = 0; ii < aThermalRings.OutlineCount(); ii++ )
+            rings.emplace_back( aThermalRings.CPolygon( ii ) );
+
+        for( const SHAPE_POLY_SET& ring : rings )
+        {
+            BOX2I     ringBBox = ring.BBox();
+            const int mmin[2] = { ringBBox.GetLeft(), ringBBox.GetTop() };
+            const int mmax[2] = { ringBBox.GetRight(), ringBBox.GetBottom() };
+
+            ringIndex.Insert( mmin, mmax, &ring );
+        }
 
         for( int ii = holes.OutlineCount() - 1; ii >= 0; ii-- )
         {
             const SHAPE_LINE_CHAIN& hole = holes.Outline( ii );
+            BOX2I                   holeBBox = hole.BBox();
+            const int               mmin[2] = { holeBBox.GetLeft(), holeBBox.GetTop() };
+            const int               mmax[2] = { holeBBox.GetRight(), holeBBox.GetBottom() };
+            SHAPE_POLY_SET          holeAsPoly;
+            bool                    touching = false;
+
+            ringIndex.Search( mmin, mmax,
+                    [&]( const SHAPE_POLY_SET* aRing ) -> bool
+                    {
+                        // Full collision check using Collide() which is faster than
+                        // BooleanIntersection()
+                        if( holeAsPoly.OutlineCount() == 0 )
+                            holeAsPoly.AddOutline( hole );
 
-            // Quick rejection: skip if bounding boxes don't overlap
-            if( !thermalBBox.Intersects( hole.BBox() ) )
-                continue;
-
-            // Full collision check using Collide() which is faster than BooleanIntersection()
-            SHAPE_POLY_SET holeAsPoly;
-            holeAsPoly.AddOutline( hole );
+                        touching = aRing->Collide( &holeAsPoly );
+                        return !touching;
+                    } );
 
-            if( aThermalRings.Collide( &holeAsPoly ) )
+            if( touching )
                 holes.DeletePolygon( ii );
         }
     }
@@ -22,6 +22,8 @@
 * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
 */
 
+#include <algorithm>
+
 #include <fmt/core.h>
 #include <boost/test/unit_test.hpp>
 
@@ -75,4 +77,43 @@ BOOST_AUTO_TEST_CASE( Connect )
     BOOST_CHECK_EQUAL( std::any_cast<std::string>( result.at( "Cost" ) ), "1.95" );
 }
 
+BOOST_AUTO_TEST_CASE( SelectFromCachedTable )
+{
+    std::string cs = fmt::format( "Driver={{SQLite3}};Database={}/database.sqlite",
+                                  QA_DATABASE_FILE_LOCATION );
+
+    DATABASE_CONNECTION dc( cs, 2 );
+    dc.CacheTableInfo( "Resistors", { "Part ID", "MPN" } );
+    BOOST_CHECK( dc.IsConnected() );
+
+    // Reading the whole table fills the cache used by the single row lookups
+    std::vector<DATABASE_CONNECTION::ROW> results;
+    BOOST_CHECK( dc.SelectAll( "Resistors", "Part ID", results ) );
+    BOOST_CHECK( !results.empty() );
+
+    auto found = std::find_if( results.begin(), results.end(),
+                               []( const DATABASE_CONNECTION::ROW& aRow )
+                               {
+                                   return std::any_cast<std::string>( aRow.at( "Part ID" ) ) == "RES-001";
+                               } );
+
+    BOOST_REQUIRE( found != results.end() );
+
+    // Rows handed out by the cache are copies, so modifying one doesn't affect later lookups
+    ( *found )["MPN"] = std::string( "modified" );
+
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        DATABASE_CONNECTION::ROW result;
+
+        BOOST_CHECK( dc.SelectOne( "Resistors", std::make_pair( "Part ID", "RES-001" ), result ) );
+        BOOST_CHECK_EQUAL( std::any_cast<std::string>( result.at( "MPN" ) ), "RC0603FR-0710KL" );
+
+        result["MPN"] = std::string( "modified" );
+    }
+
+    DATABASE_CONNECTION::ROW missing;
+    BOOST_CHECK( !dc.SelectOne( "Resistors", std::make_pair( "Part ID", "RES-NOT-THERE" ), missing ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
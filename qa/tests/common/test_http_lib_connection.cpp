@@ -0,0 +1,293 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <http_lib/http_lib_connection.h>
+
+#include <fmt/core.h>
+#include <wx/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Minimal HTTP library server on the loopback interface, serving categories "1" to "n" with
+ * two parts each.  Category "missing" answers with a 404.  Each category request is delayed,
+ * so concurrent requests overlap and can be counted.
+ */
+class HTTP_LIB_TEST_SERVER
+{
+public:
+    HTTP_LIB_TEST_SERVER( int aCategoryCount, int aLatencyMs ) :
+            m_categoryCount( aCategoryCount ),
+            m_latencyMs( aLatencyMs ),
+            m_port( 0 ),
+            m_stop( false ),
+            m_inFlight( 0 ),
+            m_peakInFlight( 0 ),
+            m_categoryRequests( 0 )
+    {
+        wxIPV4address addr;
+        addr.LocalHost();
+        addr.Service( 0 );
+
+        // Blocking sockets can be used from the worker threads below
+        m_server = std::make_unique<wxSocketServer>( addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR );
+
+        wxIPV4address local;
+        m_server->GetLocal( local );
+        m_port = local.Service();
+
+        m_thread = std::thread( [this]() { acceptLoop(); } );
+    }
+
+    ~HTTP_LIB_TEST_SERVER()
+    {
+        m_stop = true;
+        m_thread.join();
+
+        for( std::thread& client : m_clients )
+            client.join();
+    }
+
+    bool IsOk() const { return m_server->IsOk() && m_port != 0; }
+
+    std::string RootUrl() const { return fmt::format( "http://127.0.0.1:{}/v1/", m_port ); }
+
+    int PeakInFlight() const { return m_peakInFlight; }
+    int CategoryRequests() const { return m_categoryRequests; }
+
+private:
+    void acceptLoop()
+    {
+        while( !m_stop )
+        {
+            if( !m_server->WaitForAccept( 0, 50 ) )
+                continue;
+
+            std::shared_ptr<wxSocketBase> client( m_server->Accept( false ) );
+
+            if( client )
+                m_clients.emplace_back( [this, client]() { handleClient( client.get() ); } );
+        }
+    }
+
+    void handleClient( wxSocketBase* aClient )
+    {
+        aClient->SetFlags( wxSOCKET_BLOCK );
+        aClient->SetTimeout( 5 );
+
+        std::string request;
+        char        buffer[512];
+
+        while( request.find( "\r\n\r\n" ) == std::string::npos && request.size() < 4096 )
+        {
+            aClient->Read( buffer, sizeof( buffer ) );
+
+            if( aClient->LastCount() == 0 )
+                break;
+
+            request.append( buffer, aClient->LastCount() );
+        }
+
+        // "GET <path> HTTP/1.1"
+        size_t      start = request.find( ' ' ) + 1;
+        std::string path = request.substr( start, request.find( ' ', start ) - start );
+
+        int         status = 200;
+        std::string body = respond( path, status );
+        std::string response = fmt::format( "HTTP/1.1 {} {}\r\n"
+                                            "Content-Type: application/json\r\n"
+                                            "Content-Length: {}\r\n"
+                                            "Connection: close\r\n\r\n{}",
+                                            status, status == 200 ? "OK" : "Not Found",
+                                            body.size(), body );
+
+        aClient->Write( response.data(), response.size() );
+        aClient->Close();
+    }
+
+    std::string respond( const std::string& aPath, int& aStatus )
+    {
+        if( aPath == "/v1/" )
+            return R"({"categories":"","parts":""})";
+
+        if( aPath == "/v1/categories.json" )
+        {
+            std::string categories;
+
+            for( int ii = 1; ii <= m_categoryCount; ii++ )
+            {
+                categories += fmt::format( R"({}{{"id":"{}","name":"Category {}"}})",
+                                           ii > 1 ? "," : "", ii, ii );
+            }
+
+            return "[" + categories + "]";
+        }
+
+        const std::string prefix = "/v1/parts/category/";
+
+        if( aPath.rfind( prefix, 0 ) == 0 )
+        {
+            std::string id = aPath.substr( prefix.size(), aPath.find( ".json" ) - prefix.size() );
+
+            int inFlight = ++m_inFlight;
+            int peak = m_peakInFlight;
+
+            while( inFlight > peak && !m_peakInFlight.compare_exchange_weak( peak, inFlight ) )
+                ;
+
+            m_categoryRequests++;
+            std::this_thread::sleep_for( std::chrono::milliseconds( m_latencyMs ) );
+            m_inFlight--;
+
+            if( id != "missing" )
+            {
+                return fmt::format( R"([{{"id":"{0}-1","name":"Part {0}-1"}},)"
+                                    R"({{"id":"{0}-2","name":"Part {0}-2"}}])",
+                                    id );
+            }
+        }
+
+        aStatus = 404;
+        return "Not found";
+    }
+
+    int                             m_categoryCount;
+    int                             m_latencyMs;
+    unsigned short                  m_port;
+    std::unique_ptr<wxSocketServer> m_server;
+    std::thread                     m_thread;
+    std::vector<std::thread>        m_clients;      ///< Only touched by m_thread until joined.
+    std::atomic<bool>               m_stop;
+    std::atomic<int>                m_inFlight;
+    std::atomic<int>                m_peakInFlight;
+    std::atomic<int>                m_categoryRequests;
+};
+
+
+struct HTTP_LIB_CONNECTION_FIXTURE
+{
+    HTTP_LIB_CONNECTION_FIXTURE()
+    {
+        // Must be called from the main thread before sockets are used from other threads
+        wxSocketBase::Initialize();
+    }
+
+    ~HTTP_LIB_CONNECTION_FIXTURE() { wxSocketBase::Shutdown(); }
+
+    static HTTP_LIB_SOURCE makeSource( const HTTP_LIB_TEST_SERVER& aServer )
+    {
+        HTTP_LIB_SOURCE source;
+        source.type = HTTP_LIB_SOURCE_TYPE::REST_API;
+        source.root_url = aServer.RootUrl();
+        source.api_version = "v1";
+        source.token = "test";
+        source.timeout_parts = 0;
+        source.timeout_categories = 0;
+        return source;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( HttpLibConnection, HTTP_LIB_CONNECTION_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( SelectAllCategoriesConcurrently )
+{
+    const int            categoryCount = 8;
+    HTTP_LIB_TEST_SERVER server( categoryCount, 100 );
+
+    BOOST_REQUIRE( server.IsOk() );
+
+    HTTP_LIB_CONNECTION conn( makeSource( server ), true );
+
+    BOOST_REQUIRE_MESSAGE( conn.IsValidEndpoint(), conn.GetLastError() );
+    BOOST_REQUIRE_EQUAL( conn.getCategories().size(), categoryCount );
+
+    std::map<std::string, std::vector<HTTP_LIB_PART>> parts;
+
+    BOOST_CHECK( conn.SelectAll( conn.getCategories(), parts ) );
+    BOOST_CHECK_EQUAL( conn.GetLastError(), "" );
+    BOOST_CHECK_EQUAL( server.CategoryRequests(), categoryCount );
+
+    // Each category is returned under its own id, with its own parts
+    BOOST_REQUIRE_EQUAL( parts.size(), categoryCount );
+
+    for( const HTTP_LIB_CATEGORY& category : conn.getCategories() )
+    {
+        BOOST_TEST_CONTEXT( "Category " << category.id )
+        {
+            BOOST_REQUIRE_EQUAL( parts[category.id].size(), 2 );
+            BOOST_CHECK_EQUAL( parts[category.id][0].id, category.id + "-1" );
+            BOOST_CHECK_EQUAL( parts[category.id][1].id, category.id + "-2" );
+        }
+    }
+
+    // The requests overlap, but never on more than the connection limit
+    BOOST_CHECK_LE( server.PeakInFlight(), 4 );
+
+    if( std::thread::hardware_concurrency() > 1 )
+        BOOST_CHECK_GT( server.PeakInFlight(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( SelectAllKeepsFetchedCategoriesOnError )
+{
+    HTTP_LIB_TEST_SERVER server( 3, 10 );
+
+    BOOST_REQUIRE( server.IsOk() );
+
+    HTTP_LIB_CONNECTION conn( makeSource( server ), true );
+
+    BOOST_REQUIRE_MESSAGE( conn.IsValidEndpoint(), conn.GetLastError() );
+
+    std::vector<HTTP_LIB_CATEGORY> categories = conn.getCategories();
+    HTTP_LIB_CATEGORY              missing;
+
+    missing.id = "missing";
+    missing.name = "Missing";
+    categories.insert( categories.begin() + 1, missing );
+
+    std::map<std::string, std::vector<HTTP_LIB_PART>> parts;
+
+    BOOST_CHECK( !conn.SelectAll( categories, parts ) );
+    BOOST_CHECK( !conn.GetLastError().empty() );
+
+    BOOST_CHECK_EQUAL( parts.count( "missing" ), 0 );
+    BOOST_CHECK_EQUAL( parts.size(), 3 );
+
+    // The single category overload goes through the same path
+    std::vector<HTTP_LIB_PART> single;
+
+    BOOST_CHECK( conn.SelectAll( categories[0], single ) );
+    BOOST_CHECK_EQUAL( single.size(), 2 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
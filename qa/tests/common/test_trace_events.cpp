@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <core/trace_events.h>
+
+#include <nlohmann/json.hpp>
+
+#include <set>
+#include <sstream>
+#include <thread>
+
+
+BOOST_AUTO_TEST_SUITE( TraceEvents )
+
+
+BOOST_AUTO_TEST_CASE( DisabledByDefault )
+{
+    TRACE_EVENTS& events = TRACE_EVENTS::Instance();
+
+    BOOST_REQUIRE( !TRACE_EVENTS::IsEnabled() );
+
+    size_t count = events.EventCount();
+
+    {
+        TRACE_ZONE zone( "Not recorded" );
+    }
+
+    events.AddCounter( "Not recorded", 1 );
+
+    BOOST_CHECK_EQUAL( events.EventCount(), count );
+}
+
+
+BOOST_AUTO_TEST_CASE( ChromeTraceJson )
+{
+    TRACE_EVENTS& events = TRACE_EVENTS::Instance();
+
+    events.Start();
+
+    {
+        TRACE_ZONE zone( "Outer \"quoted\"", "test" );
+
+        std::thread worker(
+                []()
+                {
+                    TRACE_ZONE workerZone( std::string( "Worker" ), "test" );
+                } );
+
+        worker.join();
+
+        events.AddCounter( "Items", 42 );
+    }
+
+    BOOST_CHECK( events.Finish() );
+    BOOST_CHECK( !TRACE_EVENTS::IsEnabled() );
+    BOOST_CHECK_EQUAL( events.EventCount(), 3 );
+
+    std::stringstream stream;
+    events.Write( stream );
+
+    nlohmann::json json = nlohmann::json::parse( stream.str() );
+
+    BOOST_REQUIRE( json.contains( "traceEvents" ) );
+    BOOST_REQUIRE_EQUAL( json["traceEvents"].size(), 3 );
+
+    std::set<int> threadIds;
+
+    for( const nlohmann::json& event : json["traceEvents"] )
+    {
+        threadIds.insert( event["tid"].get<int>() );
+        BOOST_CHECK_GE( event["ts"].get<int64_t>(), 0 );
+
+        if( event["ph"] == "C" )
+        {
+            BOOST_CHECK_EQUAL( event["name"].get<std::string>(), "Items" );
+            BOOST_CHECK_EQUAL( event["args"]["Items"].get<int64_t>(), 42 );
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL( event["ph"].get<std::string>(), "X" );
+            BOOST_CHECK_EQUAL( event["cat"].get<std::string>(), "test" );
+            BOOST_CHECK_GE( event["dur"].get<int64_t>(), 0 );
+        }
+    }
+
+    // The worker zone is on its own thread
+    BOOST_CHECK_EQUAL( threadIds.size(), 2 );
+
+    // Restarting drops the previous events
+    events.Start();
+    BOOST_CHECK_EQUAL( events.EventCount(), 0 );
+    BOOST_CHECK( events.Finish() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
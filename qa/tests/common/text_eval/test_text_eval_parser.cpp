@@ -566,6 +566,42 @@ BOOST_AUTO_TEST_CASE( ComplexExpressions )
     }
 }
 
+/**
+ * Test that parsed expressions shared between evaluations don't leak state between them
+ */
+BOOST_AUTO_TEST_CASE( ReusedExpressions )
+{
+    EXPRESSION_EVALUATOR evaluator;
+
+    // Variables are looked up each time, not when the expression is first parsed
+    evaluator.SetVariable( "x", 10.0 );
+    BOOST_CHECK_EQUAL( evaluator.Evaluate( "@{${x} * 2}" ), "20" );
+
+    evaluator.SetVariable( "x", 4.0 );
+    BOOST_CHECK_EQUAL( evaluator.Evaluate( "@{${x} * 2}" ), "8" );
+
+    // Numbers with units are converted to the default units of each evaluator
+    EXPRESSION_EVALUATOR evaluator_mm( EDA_UNITS::MM );
+    EXPRESSION_EVALUATOR evaluator_inch( EDA_UNITS::INCH );
+
+    BOOST_CHECK_EQUAL( evaluator_mm.Evaluate( "@{2in}" ), "50.8" );
+    BOOST_CHECK_EQUAL( evaluator_inch.Evaluate( "@{2in}" ), "2" );
+    BOOST_CHECK_EQUAL( evaluator_mm.Evaluate( "@{2in}" ), "50.8" );
+
+    // Errors are reported on every evaluation of a bad expression
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        evaluator.Evaluate( "@{2 + * 3}" );
+        BOOST_CHECK( evaluator.HasErrors() );
+
+        BOOST_CHECK_EQUAL( evaluator.Evaluate( "@{1 / 0}" ), "@{1 / 0}" );
+        BOOST_CHECK( evaluator.HasErrors() );
+
+        BOOST_CHECK_EQUAL( evaluator.Evaluate( "@{2 + 3}" ), "5" );
+        BOOST_CHECK( !evaluator.HasErrors() );
+    }
+}
+
 /**
  * Test performance with large expressions
  */
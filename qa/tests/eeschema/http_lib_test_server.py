@@ -33,6 +33,10 @@ Run the server using:
 
 The server will start on http://0.0.0.0:8000
 
+To test the behavior with large or slow libraries, empty categories can be added and a delay
+can be applied to every category request:
+    python http_lib_test_server.py --extra-categories 50 --latency 200
+
 Mock Data
 ---------
 The current implementation includes mock data for testing. 
@@ -54,6 +58,9 @@ For development and testing purposes only. Not intended for production use.
 
 from typing import List, Optional, Dict
 
+import argparse
+import asyncio
+
 import uvicorn
 from fastapi import FastAPI, HTTPException
 from pydantic import BaseModel
@@ -132,6 +139,8 @@ detailed_parts = {
     )
 }
 
+latency_ms = 0
+
 @app.get("/v1/")
 async def get_endpoints():
     return {
@@ -147,6 +156,9 @@ async def get_categories():
 @app.get("/v1/parts/category/{category_id}.json", response_model=List[PartsChooser])
 async def get_parts_by_category(category_id: str):
 
+    if latency_ms > 0:
+        await asyncio.sleep(latency_ms / 1000)
+
     if category_id not in parts_by_category:
         raise HTTPException(status_code=404, detail=f"Category {category_id} not found")
 
@@ -161,6 +173,20 @@ async def get_part_details(part_id: str):
     return detailed_parts[part_id]
 
 if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="KiCad HTTP library test server")
+    parser.add_argument("--extra-categories", type=int, default=0,
+                        help="number of empty categories to add")
+    parser.add_argument("--latency", type=int, default=0,
+                        help="delay in milliseconds applied to each category request")
+    args = parser.parse_args()
+
+    latency_ms = args.latency
+
+    for i in range(args.extra_categories):
+        category_id = str(len(categories) + 1)
+        categories.append(Category(id=category_id, name=f"Category {category_id}"))
+        parts_by_category[category_id] = []
+
     uvicorn.run(app, host="0.0.0.0", port=8000)
 
 
@@ -455,4 +455,40 @@ BOOST_AUTO_TEST_CASE( NameAndNumberOnOppositeSides )
 }
 
 
+/**
+ * Pin text extents are shared between all copies of a symbol.  Check that copies get the same
+ * layout and that a renamed pin is not given the extents of its old name.
+ */
+BOOST_AUTO_TEST_CASE( SharedExtentsFollowPinText )
+{
+    std::unique_ptr<LIB_SYMBOL> symbol = createAdjacentPinsSymbol();
+    std::unique_ptr<LIB_SYMBOL> copy = std::make_unique<LIB_SYMBOL>( *symbol );
+
+    std::vector<SCH_PIN*> pins = symbol->GetPins();
+    std::vector<SCH_PIN*> copyPins = copy->GetPins();
+
+    BOOST_REQUIRE_EQUAL( pins.size(), copyPins.size() );
+
+    for( size_t ii = 0; ii < pins.size(); ii++ )
+    {
+        PIN_LAYOUT_CACHE cache( *pins[ii] );
+        PIN_LAYOUT_CACHE copyCache( *copyPins[ii] );
+
+        BOOST_CHECK( cache.GetPinBoundingBox( true, true, false )
+                     == copyCache.GetPinBoundingBox( true, true, false ) );
+    }
+
+    PIN_LAYOUT_CACHE cache( *pins[0] );
+    OPT_BOX2I        nameBox = cache.GetPinNameBBox();
+
+    copyPins[0]->SetName( copyPins[0]->GetName() + wxT( "_WITH_A_LONGER_NAME" ) );
+
+    PIN_LAYOUT_CACHE copyCache( *copyPins[0] );
+    OPT_BOX2I        copyNameBox = copyCache.GetPinNameBBox();
+
+    BOOST_REQUIRE( nameBox && copyNameBox );
+    BOOST_CHECK_GT( copyNameBox->GetWidth(), nameBox->GetWidth() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -293,4 +293,75 @@ BOOST_AUTO_TEST_CASE( SingleElementTree )
         delete item;
 }
 
+// Items added in bulk must be found exactly as if they had been inserted one by one, and must
+// still be found after moving them and rebuilding the tree
+BOOST_AUTO_TEST_CASE( BulkInsert )
+{
+    std::vector<SCH_ITEM*> items;
+
+    for( int i = 0; i < 1000; i++ )
+    {
+        VECTOR2I pos( schIUScale.MilsToIU( 100 ) * ( i % 40 ), schIUScale.MilsToIU( 100 ) * ( i / 40 ) );
+
+        if( i % 2 )
+            items.push_back( new SCH_JUNCTION( pos ) );
+        else
+            items.push_back( new SCH_NO_CONNECT( pos ) );
+    }
+
+    m_tree.insert( items );
+
+    BOOST_CHECK_EQUAL( m_tree.size(), items.size() );
+
+    auto checkQueries =
+            [&]()
+            {
+                for( int type : { SCH_JUNCTION_T, SCH_NO_CONNECT_T } )
+                {
+                    int count = 0;
+
+                    for( SCH_ITEM* item : m_tree.OfType( KICAD_T( type ) ) )
+                    {
+                        BOOST_CHECK_EQUAL( item->Type(), type );
+                        count++;
+                    }
+
+                    BOOST_CHECK_EQUAL( count, 500 );
+                }
+
+                for( SCH_ITEM* item : items )
+                {
+                    bool found = false;
+
+                    for( SCH_ITEM* candidate : m_tree.Overlapping( item->Type(), item->GetPosition() ) )
+                        found |= ( candidate == item );
+
+                    BOOST_CHECK( found );
+                }
+            };
+
+    checkQueries();
+
+    // Fewer items than the tree already holds are inserted one at a time
+    std::vector<SCH_ITEM*> extra = { new SCH_JUNCTION( VECTOR2I( -1000, -1000 ) ) };
+    m_tree.insert( extra );
+
+    BOOST_CHECK_EQUAL( m_tree.size(), items.size() + 1 );
+    BOOST_CHECK( m_tree.contains( extra[0], true ) );
+
+    m_tree.remove( extra[0] );
+    delete extra[0];
+
+    for( SCH_ITEM* item : items )
+        item->Move( VECTOR2I( schIUScale.MilsToIU( 10000 ), 0 ) );
+
+    m_tree.rebuild();
+
+    BOOST_CHECK_EQUAL( m_tree.size(), items.size() );
+    checkQueries();
+
+    for( SCH_ITEM* item : m_tree )
+        delete item;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
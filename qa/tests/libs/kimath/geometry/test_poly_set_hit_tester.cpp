@@ -0,0 +1,110 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/poly_set_hit_tester.h>
+
+
+namespace
+{
+
+SHAPE_LINE_CHAIN makeRect( int aLeft, int aTop, int aRight, int aBottom )
+{
+    SHAPE_LINE_CHAIN chain( { VECTOR2I( aLeft, aTop ), VECTOR2I( aRight, aTop ),
+                              VECTOR2I( aRight, aBottom ), VECTOR2I( aLeft, aBottom ) } );
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+/**
+ * Two outlines: a square with a grid of square holes, and a triangle next to it.
+ */
+std::shared_ptr<SHAPE_POLY_SET> makePolySet()
+{
+    auto polySet = std::make_shared<SHAPE_POLY_SET>();
+
+    polySet->AddOutline( makeRect( 0, 0, 1000, 1000 ) );
+
+    for( int x = 100; x < 900; x += 200 )
+    {
+        for( int y = 100; y < 900; y += 200 )
+            polySet->AddHole( makeRect( x, y, x + 100, y + 100 ) );
+    }
+
+    SHAPE_LINE_CHAIN triangle( { VECTOR2I( 1200, 0 ), VECTOR2I( 1800, 0 ),
+                                 VECTOR2I( 1500, 900 ) } );
+    triangle.SetClosed( true );
+    polySet->AddOutline( triangle );
+
+    return polySet;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( PolySetHitTester )
+
+
+BOOST_AUTO_TEST_CASE( MatchesContains )
+{
+    std::shared_ptr<SHAPE_POLY_SET> polySet = makePolySet();
+    POLY_SET_HIT_TESTER             tester( polySet, 0 );
+
+    for( int accuracy : { 0, 20 } )
+    {
+        for( int x = -50; x <= 1850; x += 25 )
+        {
+            for( int y = -50; y <= 1050; y += 25 )
+            {
+                const VECTOR2I pt( x, y );
+
+                BOOST_TEST_CONTEXT( "Point " << x << ", " << y << " accuracy " << accuracy )
+                {
+                    BOOST_CHECK_EQUAL( tester.Contains( pt, accuracy ),
+                                       polySet->Contains( pt, -1, accuracy ) );
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( Validity )
+{
+    std::shared_ptr<SHAPE_POLY_SET> polySet = makePolySet();
+    POLY_SET_HIT_TESTER             tester( polySet, 3 );
+
+    BOOST_CHECK( tester.IsValidFor( polySet.get(), 3 ) );
+
+    SHAPE_POLY_SET copy = *polySet;
+    BOOST_CHECK( !tester.IsValidFor( &copy, 3 ) );
+
+    // The owner bumps the revision when editing the polygon set in place
+    polySet->Move( VECTOR2I( 10, 0 ) );
+    BOOST_CHECK( !tester.IsValidFor( polySet.get(), 4 ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_rtree.h>
+
+
+namespace
+{
+
+PCB_TRACK* addTrack( BOARD& aBoard, const VECTOR2I& aStart, const VECTOR2I& aEnd )
+{
+    PCB_TRACK* track = new PCB_TRACK( &aBoard );
+
+    track->SetStart( aStart );
+    track->SetEnd( aEnd );
+    track->SetWidth( pcbIUScale.mmToIU( 0.2 ) );
+    track->SetLayer( F_Cu );
+    aBoard.Add( track );
+
+    return track;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( DRCRTree )
+
+
+BOOST_AUTO_TEST_CASE( RemoveAndReinsert )
+{
+    BOARD     board;
+    DRC_RTREE tree( true );
+
+    const int  mm = pcbIUScale.mmToIU( 1 );
+    PCB_TRACK* a = addTrack( board, VECTOR2I( 0, 0 ), VECTOR2I( 10 * mm, 0 ) );
+    PCB_TRACK* b = addTrack( board, VECTOR2I( 0, 5 * mm ), VECTOR2I( 10 * mm, 5 * mm ) );
+
+    for( PCB_TRACK* track : { a, b } )
+    {
+        tree.Insert( track, F_Cu, mm );
+        tree.Insert( track, B_Cu, mm );
+    }
+
+    const LSET layers{ F_Cu, B_Cu };
+
+    BOOST_CHECK( tree.IsIndexed( a, layers ) );
+    BOOST_CHECK( !tree.IsIndexed( a, LSET{ F_Cu } ) );
+    BOOST_CHECK_EQUAL( tree.size(), 4 );
+
+    // Moving an item leaves its old entries in place until it is reinserted
+    a->Move( VECTOR2I( 0, 20 * mm ) );
+    BOOST_CHECK( !tree.IsIndexed( a, layers ) );
+    BOOST_CHECK( tree.GetObjectsAt( VECTOR2I( 5 * mm, 0 ), F_Cu ).count( a ) );
+
+    tree.Remove( a );
+    BOOST_CHECK_EQUAL( tree.size(), 2 );
+    BOOST_CHECK( tree.GetObjectsAt( VECTOR2I( 5 * mm, 0 ), F_Cu ).empty() );
+    BOOST_CHECK( tree.GetObjectsAt( VECTOR2I( 5 * mm, 0 ), B_Cu ).empty() );
+
+    tree.Insert( a, F_Cu, mm );
+    BOOST_CHECK( tree.IsIndexed( a, LSET{ F_Cu } ) );
+    BOOST_CHECK( tree.GetObjectsAt( VECTOR2I( 5 * mm, 20 * mm ), F_Cu ).count( a ) );
+    BOOST_CHECK( tree.GetObjectsAt( VECTOR2I( 5 * mm, 20 * mm ), B_Cu ).empty() );
+
+    // Removing an item which was deleted only uses its address
+    board.Remove( b );
+    delete b;
+
+    std::vector<const BOARD_ITEM*> indexed;
+    tree.ForEachIndexedItem(
+            [&]( const BOARD_ITEM* aItem )
+            {
+                indexed.push_back( aItem );
+            } );
+
+    BOOST_CHECK_EQUAL( indexed.size(), 2 );
+
+    for( const BOARD_ITEM* item : indexed )
+    {
+        if( item != a )
+            tree.Remove( item );
+    }
+
+    BOOST_CHECK_EQUAL( tree.size(), 1 );
+    BOOST_CHECK( tree.GetObjectsAt( VECTOR2I( 5 * mm, 5 * mm ), F_Cu ).empty() );
+
+    // Removing an item twice is harmless
+    tree.Remove( a );
+    tree.Remove( a );
+    BOOST_CHECK( tree.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( KeptTreeFollowsViaFlashing )
+{
+    BOARD     board;
+    const int mm = pcbIUScale.mmToIU( 1 );
+
+    board.SetCopperLayerCount( 4 );
+    board.SetEnabledLayers( board.GetEnabledLayers() | LSET::AllCuMask( 4 ) );
+
+    NETINFO_ITEM* netA = new NETINFO_ITEM( &board, wxS( "A" ) );
+    NETINFO_ITEM* netB = new NETINFO_ITEM( &board, wxS( "B" ) );
+    board.Add( netA );
+    board.Add( netB );
+
+    // Only flashed on the layers it is connected on
+    PCB_VIA* via = new PCB_VIA( &board );
+    via->SetPosition( VECTOR2I( 10 * mm, 10 * mm ) );
+    via->SetLayerPair( F_Cu, B_Cu );
+    via->SetWidth( PADSTACK::ALL_LAYERS, mm );
+    via->SetDrill( mm * 3 / 10 );
+    via->Padstack().SetUnconnectedLayerMode( UNCONNECTED_LAYER_MODE::REMOVE_ALL );
+    via->SetNetCode( netA->GetNetCode() );
+    board.Add( via );
+
+    // Clears the hole, but is 0.15 mm from the annular ring
+    const int  x = pcbIUScale.mmToIU( 10.75 );
+    PCB_TRACK* other = addTrack( board, VECTOR2I( x, 8 * mm ), VECTOR2I( x, 12 * mm ) );
+    other->SetLayer( In1_Cu );
+    other->SetNetCode( netB->GetNetCode() );
+
+    BOARD_DESIGN_SETTINGS& bds = board.GetDesignSettings();
+    auto                   drcEngine = std::make_shared<DRC_ENGINE>( &board, &bds );
+
+    drcEngine->InitEngine( wxFileName() );
+    bds.m_DRCEngine = drcEngine;
+
+    auto viaClearanceViolations =
+            [&]()
+            {
+                int count = 0;
+
+                drcEngine->SetViolationHandler(
+                        [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                             int aLayer, const std::function<void( PCB_MARKER* )>& aPathGenerator )
+                        {
+                            if( aItem->GetErrorCode() == DRCE_CLEARANCE
+                                    && ( aItem->GetMainItemID() == via->m_Uuid
+                                         || aItem->GetAuxItemID() == via->m_Uuid ) )
+                            {
+                                count++;
+                            }
+                        } );
+
+                board.BuildConnectivity();
+                drcEngine->RunTests( EDA_UNITS::MM, true, false );
+                drcEngine->ClearViolationHandler();
+
+                return count;
+            };
+
+    BOOST_CHECK_EQUAL( viaClearanceViolations(), 0 );
+
+    // Routing onto In1_Cu flashes the via there without changing its bounding box.  The second
+    // run reuses the copper item tree, which must not keep the hole-only shape.
+    PCB_TRACK* route = addTrack( board, VECTOR2I( 8 * mm, 10 * mm ), VECTOR2I( 10 * mm, 10 * mm ) );
+    route->SetLayer( In1_Cu );
+    route->SetNetCode( netA->GetNetCode() );
+
+    BOOST_CHECK_GE( viaClearanceViolations(), 1 );
+
+    // And unrouting removes the annular ring again
+    board.Remove( route );
+    delete route;
+
+    BOOST_CHECK_EQUAL( viaClearanceViolations(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,265 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <autorouter/ar_occupancy.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include <autorouter/ar_autoplacer.h>
+#include <board_commit.h>
+#include <netinfo.h>
+#include <pad.h>
+#include <pcb_shape.h>
+#include <tool/tool_manager.h>
+
+
+/**
+ * Exposes the candidate evaluation of the autoplacer.
+ */
+class AUTOPLACER_TEST_HELPER : public AR_AUTOPLACER
+{
+public:
+    AUTOPLACER_TEST_HELPER( BOARD* aBoard ) :
+            AR_AUTOPLACER( aBoard )
+    {
+    }
+
+    using AR_AUTOPLACER::FP_SNAPSHOT;
+    using AR_AUTOPLACER::genPlacementRoutingMatrix;
+    using AR_AUTOPLACER::snapshotFootprint;
+    using AR_AUTOPLACER::buildNetAnchorTrees;
+    using AR_AUTOPLACER::computePlacementRatsnestCost;
+    using AR_AUTOPLACER::addPadAnchors;
+};
+
+
+struct AUTOPLACER_FIXTURE
+{
+    AUTOPLACER_FIXTURE() :
+            m_board( std::make_unique<BOARD>() )
+    {
+    }
+
+    static int mm( double aMillimetres ) { return pcbIUScale.mmToIU( aMillimetres ); }
+
+    int AddNet( const wxString& aName )
+    {
+        NETINFO_ITEM* net = new NETINFO_ITEM( m_board.get(), aName );
+        m_board->Add( net );
+        return net->GetNetCode();
+    }
+
+    void AddOutline( int aWidth, int aHeight )
+    {
+        PCB_SHAPE* edge = new PCB_SHAPE( m_board.get(), SHAPE_T::RECTANGLE );
+
+        edge->SetStart( VECTOR2I( 0, 0 ) );
+        edge->SetEnd( VECTOR2I( aWidth, aHeight ) );
+        edge->SetLayer( Edge_Cuts );
+        m_board->Add( edge );
+    }
+
+    /**
+     * Add a footprint at \a aPos holding a 2 x 1 mm SMD pad at its position on each of
+     * \a aNetCodes, spaced by 3 mm along X.
+     */
+    FOOTPRINT* AddFootprint( const wxString& aRef, const VECTOR2I& aPos,
+                             const std::vector<int>& aNetCodes )
+    {
+        FOOTPRINT* fp = new FOOTPRINT( m_board.get() );
+        fp->SetPosition( aPos );
+        fp->SetReference( aRef );
+
+        for( size_t ii = 0; ii < aNetCodes.size(); ii++ )
+        {
+            PAD* pad = new PAD( fp );
+            pad->SetNumber( wxString::Format( "%d", (int) ii + 1 ) );
+            pad->SetAttribute( PAD_ATTRIB::SMD );
+            pad->SetLayerSet( PAD::SMDMask() );
+            pad->SetShape( PADSTACK::ALL_LAYERS, PAD_SHAPE::RECTANGLE );
+            pad->SetSize( PADSTACK::ALL_LAYERS, VECTOR2I( mm( 2 ), mm( 1 ) ) );
+            pad->SetPosition( aPos + VECTOR2I( (int) ii * mm( 3 ), 0 ) );
+            pad->SetNetCode( aNetCodes[ii] );
+            fp->Add( pad );
+        }
+
+        m_board->Add( fp );
+        return fp;
+    }
+
+    AR_RESULT Autoplace( std::vector<FOOTPRINT*> aFootprints, int aRefinementPasses )
+    {
+        TOOL_MANAGER mgr;
+        mgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+        KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+        mgr.RegisterTool( dummyTool );
+
+        BOARD_COMMIT  commit( dummyTool );
+        AR_AUTOPLACER autoplacer( m_board.get() );
+
+        autoplacer.SetRefinementPasses( aRefinementPasses );
+        return autoplacer.AutoplaceFootprints( aFootprints, &commit );
+    }
+
+    static BOX2I padBox( FOOTPRINT* aFootprint ) { return aFootprint->GetBoundingBox( false ); }
+
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( Autoplacer, AUTOPLACER_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( RatsnestCost )
+{
+    int sig = AddNet( "SIG" );
+    int pwr = AddNet( "PWR" );
+
+    AddOutline( mm( 50 ), mm( 50 ) );
+
+    AddFootprint( "J1", VECTOR2I( mm( 10 ), mm( 10 ) ), { sig } );
+    AddFootprint( "J2", VECTOR2I( mm( 40 ), mm( 40 ) ), { sig } );
+
+    // Nothing else is on PWR, so the second pad never has a ratsnest
+    FOOTPRINT* r1 = AddFootprint( "R1", VECTOR2I( mm( 25 ), mm( 25 ) ), { sig, pwr } );
+
+    AUTOPLACER_TEST_HELPER autoplacer( m_board.get() );
+
+    BOOST_REQUIRE_EQUAL( autoplacer.genPlacementRoutingMatrix(), 1 );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+        autoplacer.addPadAnchors( footprint );
+
+    AUTOPLACER_TEST_HELPER::FP_SNAPSHOT snapshot = autoplacer.snapshotFootprint( r1 );
+
+    BOOST_REQUIRE_EQUAL( snapshot.m_pads.size(), 2 );
+    BOOST_CHECK( snapshot.m_pads[0].m_offset == VECTOR2I( 0, 0 ) );
+    BOOST_CHECK( snapshot.m_pads[1].m_offset == VECTOR2I( mm( 3 ), 0 ) );
+    BOOST_CHECK_EQUAL( snapshot.m_side, AR_SIDE_TOP );
+    BOOST_CHECK( !snapshot.m_testOtherSide );
+    BOOST_CHECK_EQUAL( snapshot.m_keepOutMargin, mm( 1 ) * 2 / 16 );
+    BOOST_CHECK( snapshot.m_relBBox.Contains( VECTOR2I( 0, 0 ) ) );
+
+    autoplacer.buildNetAnchorTrees( r1 );
+
+    auto costAt =
+            [&]( int aX, int aY )
+            {
+                return autoplacer.computePlacementRatsnestCost( snapshot.m_pads,
+                                                                VECTOR2I( mm( aX ), mm( aY ) ) );
+            };
+
+    // Horizontal ratsnests cost their length
+    BOOST_CHECK_CLOSE( costAt( 20, 10 ), mm( 10 ), 1e-9 );
+
+    // Diagonal ones are penalised on their shorter side, towards the nearest pad of the net
+    BOOST_CHECK_CLOSE( costAt( 14, 13 ), std::hypot( mm( 4 ), 2.0 * mm( 3 ) ), 1e-9 );
+    BOOST_CHECK_CLOSE( costAt( 38, 41 ), std::hypot( mm( 2 ), 2.0 * mm( 1 ) ), 1e-9 );
+
+    // R1's own pad at its current position is not a candidate
+    BOOST_CHECK_GT( costAt( 25, 25 ), mm( 15 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( PlacesNextToNetPartner )
+{
+    int sig = AddNet( "SIG" );
+
+    AddOutline( mm( 40 ), mm( 30 ) );
+
+    FOOTPRINT* j1 = AddFootprint( "J1", VECTOR2I( mm( 30 ), mm( 15 ) ), { sig } );
+    FOOTPRINT* r1 = AddFootprint( "R1", VECTOR2I( mm( 100 ), mm( 100 ) ), { sig } );
+
+    BOOST_REQUIRE_EQUAL( Autoplace( { r1 }, 0 ), AR_COMPLETED );
+
+    const BOX2I boardBox( VECTOR2I( 0, 0 ), VECTOR2I( mm( 40 ), mm( 30 ) ) );
+
+    BOOST_CHECK( boardBox.Contains( padBox( r1 ) ) );
+    BOOST_CHECK( !padBox( r1 ).Intersects( padBox( j1 ) ) );
+
+    // The pads are as close as the clearances allow, not merely somewhere on the board
+    VECTOR2I ratsnest = r1->Pads()[0]->GetPosition() - j1->Pads()[0]->GetPosition();
+
+    BOOST_CHECK_LT( ratsnest.EuclideanNorm(), mm( 5 ) );
+
+    // The fixed footprint did not move
+    BOOST_CHECK( j1->GetPosition() == VECTOR2I( mm( 30 ), mm( 15 ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( RefinedPlacementIsLegalAndReproducible )
+{
+    auto place =
+            []( int aPasses )
+            {
+                AUTOPLACER_FIXTURE fixture;
+                int                a = fixture.AddNet( "A" );
+                int                b = fixture.AddNet( "B" );
+                int                c = fixture.AddNet( "C" );
+
+                fixture.AddOutline( mm( 40 ), mm( 30 ) );
+                fixture.AddFootprint( "J1", VECTOR2I( mm( 5 ), mm( 15 ) ), { a } );
+
+                std::vector<FOOTPRINT*> footprints = {
+                    fixture.AddFootprint( "R1", VECTOR2I( mm( 100 ), mm( 100 ) ), { a, b } ),
+                    fixture.AddFootprint( "R2", VECTOR2I( mm( 100 ), mm( 100 ) ), { b, c } ),
+                    fixture.AddFootprint( "R3", VECTOR2I( mm( 100 ), mm( 100 ) ), { c, a } )
+                };
+
+                BOOST_REQUIRE_EQUAL( fixture.Autoplace( footprints, aPasses ), AR_COMPLETED );
+
+                const BOX2I        boardBox( VECTOR2I( 0, 0 ), VECTOR2I( mm( 40 ), mm( 30 ) ) );
+                std::vector<BOX2I> boxes;
+
+                for( FOOTPRINT* footprint : fixture.m_board->Footprints() )
+                {
+                    BOOST_CHECK_MESSAGE( boardBox.Contains( padBox( footprint ) ),
+                                         footprint->GetReference() << " is off the board" );
+                    boxes.push_back( padBox( footprint ) );
+                }
+
+                for( size_t ii = 0; ii < boxes.size(); ii++ )
+                {
+                    for( size_t jj = ii + 1; jj < boxes.size(); jj++ )
+                        BOOST_CHECK( !boxes[ii].Intersects( boxes[jj] ) );
+                }
+
+                std::vector<VECTOR2I> positions;
+
+                for( FOOTPRINT* footprint : footprints )
+                    positions.push_back( footprint->GetPosition() );
+
+                return positions;
+            };
+
+    std::vector<VECTOR2I> first = place( 20 );
+    std::vector<VECTOR2I> second = place( 20 );
+
+    BOOST_REQUIRE_EQUAL( first.size(), second.size() );
+
+    for( size_t ii = 0; ii < first.size(); ii++ )
+        BOOST_CHECK( first[ii] == second[ii] );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <autorouter/ar_occupancy.h>
+
+
+namespace
+{
+
+SHAPE_POLY_SET makeRect( int aLeft, int aTop, int aRight, int aBottom )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( aLeft, aTop );
+    poly.Append( aRight, aTop );
+    poly.Append( aRight, aBottom );
+    poly.Append( aLeft, aBottom );
+
+    return poly;
+}
+
+
+BOX2I makeBox( int aLeft, int aTop, int aRight, int aBottom )
+{
+    return BOX2I( VECTOR2I( aLeft, aTop ), VECTOR2I( aRight - aLeft, aBottom - aTop ) );
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( AutoplacerOccupancy )
+
+
+BOOST_AUTO_TEST_CASE( InsideBoard )
+{
+    AR_OCCUPANCY_MAP map;
+    SHAPE_POLY_SET   board = makeRect( 0, 0, 1000, 1000 );
+
+    // A square hole in the middle of the board
+    board.AddHole( makeRect( 400, 400, 600, 600 ).Outline( 0 ) );
+    map.SetBoardShape( board );
+
+    BOOST_CHECK( map.IsInsideBoard( makeBox( 10, 10, 100, 100 ) ) );
+    BOOST_CHECK( !map.IsInsideBoard( makeBox( -10, 10, 100, 100 ) ) );
+    BOOST_CHECK( !map.IsInsideBoard( makeBox( 900, 900, 1100, 950 ) ) );
+
+    // Crossing the hole edge, inside the hole and surrounding the hole
+    BOOST_CHECK( !map.IsInsideBoard( makeBox( 350, 350, 450, 450 ) ) );
+    BOOST_CHECK( !map.IsInsideBoard( makeBox( 450, 450, 550, 550 ) ) );
+    BOOST_CHECK( !map.IsInsideBoard( makeBox( 300, 300, 700, 700 ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( ObstaclesPerSide )
+{
+    AR_OCCUPANCY_MAP map;
+    map.SetBoardShape( makeRect( 0, 0, 1000, 1000 ) );
+
+    int handle = map.AddObstacle( makeBox( 100, 100, 200, 200 ), 1 << AR_SIDE_TOP );
+
+    BOOST_CHECK( !map.IsFree( makeBox( 150, 150, 250, 250 ), AR_SIDE_TOP ) );
+    BOOST_CHECK( map.IsFree( makeBox( 150, 150, 250, 250 ), AR_SIDE_BOTTOM ) );
+    BOOST_CHECK( map.IsFree( makeBox( 300, 300, 400, 400 ), AR_SIDE_TOP ) );
+
+    // The obstacle can be ignored, e.g. when moving the footprint which created it
+    BOOST_CHECK( map.IsFree( makeBox( 150, 150, 250, 250 ), AR_SIDE_TOP, handle ) );
+
+    map.RemoveObstacle( handle );
+    BOOST_CHECK( map.IsFree( makeBox( 150, 150, 250, 250 ), AR_SIDE_TOP ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( KeepOutCost )
+{
+    AR_OCCUPANCY_MAP map;
+    map.SetBoardShape( makeRect( 0, 0, 1000, 1000 ) );
+
+    map.AddObstacle( makeBox( 100, 100, 200, 200 ), 1 << AR_SIDE_TOP, 50, 10 );
+
+    // Far from the halo
+    BOOST_CHECK_EQUAL( map.KeepOutCost( makeBox( 500, 500, 600, 600 ), AR_SIDE_TOP, 10 ), 0.0 );
+
+    // Overlapping 20x50 units of the halo, i.e. 10 cells of 10x10
+    double cost = map.KeepOutCost( makeBox( 230, 100, 270, 150 ), AR_SIDE_TOP, 10 );
+    BOOST_CHECK_CLOSE( cost, 100.0, 1e-6 );
+
+    // Other side is unaffected
+    BOOST_CHECK_EQUAL( map.KeepOutCost( makeBox( 230, 100, 270, 150 ), AR_SIDE_BOTTOM, 10 ), 0.0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
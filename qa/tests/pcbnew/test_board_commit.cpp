@@ -73,5 +73,91 @@ BOOST_AUTO_TEST_CASE( ReturnsBoardFromManager )
     BOOST_CHECK_EQUAL( commit.GetBoard(), &board );
 }
 
+BOOST_AUTO_TEST_CASE( BoardOutlineFollowsChanges )
+{
+    BOARD      board;
+    const int  mm = pcbIUScale.mmToIU( 1 );
+    PCB_SHAPE* edge = new PCB_SHAPE( &board, SHAPE_T::RECTANGLE );
+
+    edge->SetStart( VECTOR2I( 0, 0 ) );
+    edge->SetEnd( VECTOR2I( 10 * mm, 10 * mm ) );
+    edge->SetLayer( Edge_Cuts );
+    board.Add( edge );
+
+    SHAPE_POLY_SET outline;
+    BOOST_CHECK( board.GetBoardPolygonOutlines( outline, false ) );
+    BOOST_CHECK_EQUAL( outline.BBox().GetWidth(), 10 * mm );
+
+    // Edits are only picked up once the board is notified, as a commit does
+    edge->SetEnd( VECTOR2I( 20 * mm, 10 * mm ) );
+    BOOST_CHECK( board.GetBoardPolygonOutlines( outline, false ) );
+    BOOST_CHECK_EQUAL( outline.BBox().GetWidth(), 10 * mm );
+
+    board.OnItemChanged( edge );
+    BOOST_CHECK( board.GetBoardPolygonOutlines( outline, false ) );
+    BOOST_CHECK_EQUAL( outline.BBox().GetWidth(), 20 * mm );
+
+    // Other items don't change a real outline, but they do change an inferred one
+    PCB_SHAPE* silk = new PCB_SHAPE( &board, SHAPE_T::SEGMENT );
+
+    silk->SetStart( VECTOR2I( 0, 0 ) );
+    silk->SetEnd( VECTOR2I( 50 * mm, 0 ) );
+    silk->SetLayer( F_SilkS );
+    board.Add( silk );
+
+    BOOST_CHECK( board.GetBoardPolygonOutlines( outline, false ) );
+    BOOST_CHECK_EQUAL( outline.BBox().GetWidth(), 20 * mm );
+
+    board.Remove( edge );
+    delete edge;
+
+    BOOST_CHECK( !board.GetBoardPolygonOutlines( outline, true ) );
+    BOOST_CHECK_GE( outline.BBox().GetWidth(), 50 * mm );
+
+    silk->SetEnd( VECTOR2I( 80 * mm, 0 ) );
+    board.OnItemChanged( silk );
+
+    BOOST_CHECK( !board.GetBoardPolygonOutlines( outline, true ) );
+    BOOST_CHECK_GE( outline.BBox().GetWidth(), 80 * mm );
+}
+
+BOOST_AUTO_TEST_CASE( BoardOutlineSurvivesRevertedAddition )
+{
+    BOARD      board;
+    const int  mm = pcbIUScale.mmToIU( 1 );
+    PCB_SHAPE* edge = new PCB_SHAPE( &board, SHAPE_T::RECTANGLE );
+
+    edge->SetStart( VECTOR2I( 0, 0 ) );
+    edge->SetEnd( VECTOR2I( 10 * mm, 10 * mm ) );
+    edge->SetLayer( Edge_Cuts );
+    board.Add( edge );
+
+    // A pasted outline, cached along with the existing one
+    PCB_SHAPE* pasted = new PCB_SHAPE( &board, SHAPE_T::RECTANGLE );
+
+    pasted->SetStart( VECTOR2I( 20 * mm, 0 ) );
+    pasted->SetEnd( VECTOR2I( 30 * mm, 10 * mm ) );
+    pasted->SetLayer( Edge_Cuts );
+    board.Add( pasted );
+
+    SHAPE_POLY_SET outline;
+    BOOST_CHECK( board.GetBoardPolygonOutlines( outline, false ) );
+    BOOST_CHECK_EQUAL( outline.BBox().GetWidth(), 30 * mm );
+
+    // BOARD_COMMIT::Revert() deletes an item staged for addition before reporting it as
+    // removed.  It needs a view and the selection tool, so this does the same steps directly.
+    board.Remove( pasted, REMOVE_MODE::BULK );
+    delete pasted;
+
+    std::vector<BOARD_ITEM*> added;
+    std::vector<BOARD_ITEM*> removed = { pasted };
+    std::vector<BOARD_ITEM*> changed;
+
+    board.OnItemsCompositeUpdate( added, removed, changed );
+
+    BOOST_CHECK( board.GetBoardPolygonOutlines( outline, false ) );
+    BOOST_CHECK_EQUAL( outline.BBox().GetWidth(), 10 * mm );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,220 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_board_netlist_updater.cpp
+ * Test the matching of board footprints to netlist symbols and the commit built by
+ * BOARD_NETLIST_UPDATER, on boards whose footprints are all in place already.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <tool/tool_manager.h>
+#include <netlist_reader/board_netlist_updater.h>
+#include <netlist_reader/pcb_netlist.h>
+
+
+namespace
+{
+
+/**
+ * Count the changes pushed to the board.
+ */
+class COMMIT_COUNTER : public BOARD_LISTENER
+{
+public:
+    void OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                 std::vector<BOARD_ITEM*>& aRemovedItems,
+                                 std::vector<BOARD_ITEM*>& aChangedItems ) override
+    {
+        m_changes += aAddedItems.size() + aRemovedItems.size() + aChangedItems.size();
+    }
+
+    size_t m_changes = 0;
+};
+
+
+struct NETLIST_UPDATER_FIXTURE
+{
+    NETLIST_UPDATER_FIXTURE() :
+            m_fpid( wxT( "TestLib" ), wxT( "SOIC-3" ) )
+    {
+        m_toolMgr.SetEnvironment( &m_board, nullptr, nullptr, nullptr, nullptr );
+    }
+
+    FOOTPRINT* addFootprint( const wxString& aReference, const KIID_PATH& aPath )
+    {
+        FOOTPRINT* footprint = new FOOTPRINT( &m_board );
+
+        footprint->SetFPID( m_fpid );
+        footprint->SetReference( aReference );
+        footprint->SetValue( wxT( "IC" ) );
+        footprint->SetPath( aPath );
+
+        for( const wxChar* number : { wxT( "1" ), wxT( "2" ), wxT( "3" ) } )
+        {
+            PAD* pad = new PAD( footprint );
+            pad->SetNumber( number );
+            footprint->Add( pad );
+        }
+
+        m_board.Add( footprint );
+        return footprint;
+    }
+
+    COMPONENT* addComponent( NETLIST& aNetlist, const wxString& aReference, const KIID& aUuid )
+    {
+        COMPONENT* component = new COMPONENT( m_fpid, aReference, wxT( "IC" ), KIID_PATH(),
+                                              { aUuid } );
+
+        aNetlist.AddComponent( component );
+        return component;
+    }
+
+    bool update( NETLIST& aNetlist, bool aLookupByTimestamp )
+    {
+        BOARD_NETLIST_UPDATER updater( &m_toolMgr, &m_board );
+
+        updater.SetLookupByTimestamp( aLookupByTimestamp );
+        updater.SetDeleteUnusedFootprints( false );
+
+        return updater.UpdateNetlist( aNetlist );
+    }
+
+    static KIID_PATH pathTo( const KIID& aUuid )
+    {
+        KIID_PATH path;
+        path.push_back( aUuid );
+        return path;
+    }
+
+    BOARD        m_board;
+    TOOL_MANAGER m_toolMgr;
+    LIB_ID       m_fpid;
+};
+
+} // namespace
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardNetlistUpdater, NETLIST_UPDATER_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( UnchangedFootprintsLeaveCommitEmpty )
+{
+    KIID uuid1, uuid2;
+
+    addFootprint( wxT( "U1" ), pathTo( uuid1 ) );
+    addFootprint( wxT( "U2" ), pathTo( uuid2 ) );
+
+    NETLIST netlist;
+
+    addComponent( netlist, wxT( "U1" ), uuid1 )->AddNet( wxT( "1" ), wxT( "A" ), wxEmptyString,
+                                                         wxEmptyString );
+    addComponent( netlist, wxT( "U2" ), uuid2 )->AddNet( wxT( "1" ), wxT( "A" ), wxEmptyString,
+                                                         wxEmptyString );
+
+    // Brings the board in line with the netlist (the nets, for a start)
+    BOOST_REQUIRE( update( netlist, true ) );
+
+    COMMIT_COUNTER counter;
+    m_board.AddListener( &counter );
+
+    BOOST_CHECK( update( netlist, true ) );
+    BOOST_CHECK( update( netlist, false ) );
+
+    m_board.RemoveListener( &counter );
+
+    BOOST_CHECK_EQUAL( counter.m_changes, 0u );
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesByUuid )
+{
+    KIID       uuid1, uuid2;
+    FOOTPRINT* fp1 = addFootprint( wxT( "U1" ), pathTo( uuid1 ) );
+    FOOTPRINT* fp2 = addFootprint( wxT( "U2" ), pathTo( uuid2 ) );
+
+    // The symbols were renumbered, swapping the references
+    NETLIST netlist;
+    addComponent( netlist, wxT( "U2" ), uuid1 );
+    addComponent( netlist, wxT( "U1" ), uuid2 );
+
+    BOOST_CHECK( update( netlist, true ) );
+
+    BOOST_REQUIRE_EQUAL( m_board.Footprints().size(), 2 );
+    BOOST_CHECK_EQUAL( fp1->GetReference(), wxString( "U2" ) );
+    BOOST_CHECK_EQUAL( fp2->GetReference(), wxString( "U1" ) );
+    BOOST_CHECK( fp1->GetPath() == pathTo( uuid1 ) );
+    BOOST_CHECK( fp2->GetPath() == pathTo( uuid2 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesByReference )
+{
+    KIID       oldUuid, newUuid, otherUuid;
+    FOOTPRINT* fp1 = addFootprint( wxT( "u1" ), pathTo( oldUuid ) );
+    FOOTPRINT* fp2 = addFootprint( wxT( "U2" ), pathTo( otherUuid ) );
+
+    // The symbol was replaced, keeping its reference (which is matched case-insensitively)
+    NETLIST netlist;
+    addComponent( netlist, wxT( "U1" ), newUuid );
+    addComponent( netlist, wxT( "U2" ), otherUuid );
+
+    BOOST_CHECK( update( netlist, false ) );
+
+    BOOST_REQUIRE_EQUAL( m_board.Footprints().size(), 2 );
+    BOOST_CHECK_EQUAL( fp1->GetReference(), wxString( "U1" ) );
+    BOOST_CHECK( fp1->GetPath() == pathTo( newUuid ) );
+    BOOST_CHECK( fp2->GetPath() == pathTo( otherUuid ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( StackedPinNets )
+{
+    KIID       uuid;
+    FOOTPRINT* footprint = addFootprint( wxT( "U1" ), pathTo( uuid ) );
+
+    NETLIST    netlist;
+    COMPONENT* component = addComponent( netlist, wxT( "U1" ), uuid );
+
+    component->AddNet( wxT( "[1-2]" ), wxT( "BUS" ), wxT( "passive" ), wxT( "passive" ) );
+    component->AddNet( wxT( "3" ), wxT( "OTHER" ), wxT( "passive" ), wxT( "passive" ) );
+
+    BOOST_CHECK( update( netlist, true ) );
+
+    auto netOf =
+            [&]( const wxString& aPadNumber )
+            {
+                return footprint->FindPadByNumber( aPadNumber )->GetNetname();
+            };
+
+    BOOST_CHECK_EQUAL( netOf( wxT( "1" ) ), wxString( "BUS" ) );
+    BOOST_CHECK_EQUAL( netOf( wxT( "2" ) ), wxString( "BUS" ) );
+    BOOST_CHECK_EQUAL( netOf( wxT( "3" ) ), wxString( "OTHER" ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
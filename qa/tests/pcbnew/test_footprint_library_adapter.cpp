@@ -0,0 +1,120 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_footprint_library_adapter.cpp
+ * Test the bulk footprint load used by the netlist update and the library parity DRC.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <fstream>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <footprint_library_adapter.h>
+#include <libraries/library_manager.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+
+
+BOOST_AUTO_TEST_SUITE( FootprintLibraryAdapter )
+
+
+BOOST_AUTO_TEST_CASE( LoadFootprintsOncePerId )
+{
+    // A project with a single library holding a single footprint
+    wxString tempDir = wxFileName::CreateTempFileName( wxS( "kicad_test_" ) );
+    wxRemoveFile( tempDir );
+    wxFileName::Mkdir( tempDir );
+
+    wxString libPath = wxFileName( tempDir, wxS( "TestLib.pretty" ) ).GetFullPath();
+    LIB_ID   presentId( wxS( "TestLib" ), wxS( "R" ) );
+    LIB_ID   missingId( wxS( "TestLib" ), wxS( "Missing" ) );
+
+    {
+        PCB_IO_KICAD_SEXPR plugin;
+        FOOTPRINT          footprint( nullptr );
+        PAD*               pad = new PAD( &footprint );
+
+        pad->SetNumber( wxS( "1" ) );
+        footprint.Add( pad );
+        footprint.SetFPID( presentId );
+
+        plugin.CreateLibrary( libPath );
+        plugin.FootprintSave( libPath, &footprint );
+    }
+
+    {
+        wxFileName    tableFile( tempDir, wxS( "fp-lib-table" ) );
+        wxString      uri = libPath;
+        std::ofstream table( tableFile.GetFullPath().ToStdString() );
+
+        uri.Replace( '\\', '/' );
+        table << "(fp_lib_table (version 7)\n"
+                 "  (lib (name \"TestLib\") (type \"KiCad\") (uri \"" << uri.ToStdString()
+              << "\") (options \"\") (descr \"\")))\n";
+    }
+
+    LIBRARY_MANAGER manager;
+    manager.LoadProjectTables( tempDir, { LIBRARY_TABLE_TYPE::FOOTPRINT } );
+
+    FOOTPRINT_LIBRARY_ADAPTER adapter( manager );
+    adapter.LoadOne( wxS( "TestLib" ) );
+
+    // Several instances of one footprint, plus one which isn't in the library
+    BOARD board;
+
+    for( int ii = 0; ii < 3; ++ii )
+    {
+        FOOTPRINT* footprint = new FOOTPRINT( &board );
+        footprint->SetFPID( presentId );
+        board.Add( footprint );
+    }
+
+    FOOTPRINT* orphan = new FOOTPRINT( &board );
+    orphan->SetFPID( missingId );
+    board.Add( orphan );
+
+    std::set<LIB_ID> fpids;
+
+    for( FOOTPRINT* footprint : board.Footprints() )
+        fpids.insert( footprint->GetFPID() );
+
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> loaded = adapter.LoadFootprints( fpids, true );
+
+    BOOST_CHECK_EQUAL( loaded.size(), 2 );
+
+    BOOST_REQUIRE( loaded.count( presentId ) );
+    BOOST_REQUIRE( loaded.at( presentId ) );
+    BOOST_CHECK( loaded.at( presentId )->GetFPID() == presentId );
+    BOOST_CHECK_EQUAL( loaded.at( presentId )->Pads().size(), 1 );
+
+    BOOST_REQUIRE( loaded.count( missingId ) );
+    BOOST_CHECK( !loaded.at( missingId ) );
+
+    wxFileName::Rmdir( tempDir, wxPATH_RMDIR_RECURSIVE );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_generator_regeneration.cpp
+ * Test the regeneration hash which lets automatic regeneration skip the tuning patterns that
+ * nothing changed around.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <fstream>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <drc/drc_engine.h>
+#include <generators/pcb_tuning_pattern.h>
+
+
+namespace
+{
+
+/**
+ * A pattern as it is after being placed, without going through the router.
+ */
+class TEST_TUNING_PATTERN : public PCB_TUNING_PATTERN
+{
+public:
+    TEST_TUNING_PATTERN( BOARD* aBoard, const VECTOR2I& aStart, const VECTOR2I& aEnd ) :
+            PCB_TUNING_PATTERN( aBoard, F_Cu, LENGTH_TUNING_MODE::SINGLE )
+    {
+        SetPosition( aStart );
+        SetEnd( aEnd );
+        m_baseLine = SHAPE_LINE_CHAIN( { aStart, aEnd } );
+    }
+};
+
+
+PCB_TRACK* addTrack( BOARD& aBoard, NETINFO_ITEM* aNet, const VECTOR2I& aStart,
+                     const VECTOR2I& aEnd )
+{
+    PCB_TRACK* track = new PCB_TRACK( &aBoard );
+
+    track->SetStart( aStart );
+    track->SetEnd( aEnd );
+    track->SetWidth( pcbIUScale.mmToIU( 0.2 ) );
+    track->SetLayer( F_Cu );
+    track->SetNet( aNet );
+    aBoard.Add( track );
+
+    return track;
+}
+
+
+struct REGENERATION_FIXTURE
+{
+    REGENERATION_FIXTURE()
+    {
+        const int mm = pcbIUScale.mmToIU( 1 );
+
+        m_sig = new NETINFO_ITEM( &m_board, wxS( "SIG" ) );
+        m_other = new NETINFO_ITEM( &m_board, wxS( "OTHER" ) );
+        m_board.Add( m_sig );
+        m_board.Add( m_other );
+
+        addTrack( m_board, m_sig, VECTOR2I( 0, 10 * mm ), VECTOR2I( 30 * mm, 10 * mm ) );
+        m_neighbour = addTrack( m_board, m_other, VECTOR2I( 0, 11 * mm ),
+                                VECTOR2I( 30 * mm, 11 * mm ) );
+
+        // Far outside of anything the pattern could reach
+        m_farAway = addTrack( m_board, m_other, VECTOR2I( 0, 80 * mm ),
+                              VECTOR2I( 30 * mm, 80 * mm ) );
+
+        m_pattern = std::make_unique<TEST_TUNING_PATTERN>( &m_board, VECTOR2I( 5 * mm, 10 * mm ),
+                                                           VECTOR2I( 25 * mm, 10 * mm ) );
+
+        BOARD_DESIGN_SETTINGS& bds = m_board.GetDesignSettings();
+
+        m_drcEngine = std::make_shared<DRC_ENGINE>( &m_board, &bds );
+        m_drcEngine->InitEngine( wxFileName() );
+        bds.m_DRCEngine = m_drcEngine;
+    }
+
+    size_t hash()
+    {
+        GENERATOR_ITEM_INDEX itemIndex( &m_board );
+
+        return m_pattern->GetRegenerationHash( &m_board, itemIndex );
+    }
+
+    BOARD                                m_board;
+    NETINFO_ITEM*                        m_sig;
+    NETINFO_ITEM*                        m_other;
+    PCB_TRACK*                           m_neighbour;
+    PCB_TRACK*                           m_farAway;
+    std::unique_ptr<TEST_TUNING_PATTERN> m_pattern;
+    std::shared_ptr<DRC_ENGINE>          m_drcEngine;
+};
+
+} // namespace
+
+
+BOOST_FIXTURE_TEST_SUITE( GeneratorRegeneration, REGENERATION_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( UnchangedBoardKeepsHash )
+{
+    size_t before = hash();
+
+    BOOST_CHECK_NE( before, 0 );
+    BOOST_CHECK_EQUAL( hash(), before );
+
+    // Nothing the pattern could run into
+    m_farAway->Move( VECTOR2I( pcbIUScale.mmToIU( 1 ), 0 ) );
+
+    BOOST_CHECK_EQUAL( hash(), before );
+}
+
+
+BOOST_AUTO_TEST_CASE( MovedNeighbourChangesHash )
+{
+    size_t before = hash();
+
+    m_neighbour->Move( VECTOR2I( 0, pcbIUScale.mmToIU( 0.5 ) ) );
+
+    BOOST_CHECK_NE( hash(), before );
+}
+
+
+BOOST_AUTO_TEST_CASE( PairwiseClearanceChangesHash )
+{
+    size_t before = hash();
+
+    // Only applies between the tuned net and its neighbour, so it doesn't show in the rules
+    // evaluated for the tuned track alone.
+    wxFileName rulesFile( wxFileName::CreateTempFileName( wxT( "kicad_regeneration_rules" ) ) );
+
+    {
+        std::ofstream rules( rulesFile.GetFullPath().ToStdString() );
+
+        rules << "(version 1)\n"
+                 "(rule \"SIG to OTHER\"\n"
+                 "  (condition \"A.NetName == 'SIG' && B.NetName == 'OTHER'\")\n"
+                 "  (constraint clearance (min 0.6mm)))\n";
+    }
+
+    m_drcEngine->InitEngine( rulesFile );
+    wxRemoveFile( rulesFile.GetFullPath() );
+
+    size_t after = hash();
+
+    BOOST_CHECK_NE( after, before );
+
+    // And back again once the rule is gone
+    m_drcEngine->InitEngine( wxFileName() );
+
+    BOOST_CHECK_EQUAL( hash(), before );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
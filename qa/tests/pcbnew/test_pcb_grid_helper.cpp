@@ -61,6 +61,20 @@ public:
     PCB_GRID_HELPER helper;
 };
 
+// Exposes the snap anchor cache, which is otherwise only reachable with a view
+class ANCHOR_CACHE_TEST_HELPER : public PCB_GRID_HELPER
+{
+public:
+    using PCB_GRID_HELPER::ANCHOR_CACHE_KEY;
+    using PCB_GRID_HELPER::setAnchorCacheContext;
+    using PCB_GRID_HELPER::insertCachedAnchors;
+    using PCB_GRID_HELPER::cacheAnchors;
+
+    void AddAnchor( const VECTOR2I& aPos, EDA_ITEM* aItem ) { addAnchor( aPos, CORNER, aItem ); }
+    void ClearAnchors() { clearAnchors(); }
+    size_t AnchorCount() const { return m_anchors.size(); }
+};
+
 BOOST_AUTO_TEST_SUITE( PCBGridHelperTest )
 
 BOOST_AUTO_TEST_CASE( DefaultConstructor )
@@ -407,4 +421,61 @@ BOOST_FIXTURE_TEST_CASE( ZeroLengthSegment, PCBGridHelperTestFixture )
     BOOST_CHECK_EQUAL( result.y, 100 );
 }
 
+BOOST_AUTO_TEST_CASE( AnchorCacheInvalidation )
+{
+    ANCHOR_CACHE_TEST_HELPER helper;
+    MOCK_BOARD_ITEM          item( PCB_TRACE_T );
+    BOARD                    board;
+
+    using KEY = ANCHOR_CACHE_TEST_HELPER::ANCHOR_CACHE_KEY;
+
+    const KEY key = { BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 100, 100 ) ), true, false };
+
+    const auto cache =
+            [&]()
+            {
+                helper.ClearAnchors();
+                helper.AddAnchor( VECTOR2I( 0, 0 ), &item );
+                helper.AddAnchor( VECTOR2I( 100, 100 ), &item );
+                helper.cacheAnchors( &item, key, 0 );
+                helper.ClearAnchors();
+            };
+
+    helper.setAnchorCacheContext( 1 );
+    cache();
+
+    BOOST_CHECK( helper.insertCachedAnchors( &item, key ) );
+    BOOST_CHECK_EQUAL( helper.AnchorCount(), 2 );
+
+    // Items edited before a commit: moved, hidden or picked up for a move
+    KEY moved = key;
+    moved.m_bbox.Move( VECTOR2I( 10, 0 ) );
+    KEY hidden = key;
+    hidden.m_visible = false;
+    KEY moving = key;
+    moving.m_moving = true;
+
+    helper.ClearAnchors();
+    BOOST_CHECK( !helper.insertCachedAnchors( &item, moved ) );
+    BOOST_CHECK( !helper.insertCachedAnchors( &item, hidden ) );
+    BOOST_CHECK( !helper.insertCachedAnchors( &item, moving ) );
+    BOOST_CHECK_EQUAL( helper.AnchorCount(), 0 );
+
+    // The same context keeps the cache, another one flushes it
+    helper.setAnchorCacheContext( 1 );
+    BOOST_CHECK( helper.insertCachedAnchors( &item, key ) );
+
+    helper.setAnchorCacheContext( 2 );
+    BOOST_CHECK( !helper.insertCachedAnchors( &item, key ) );
+
+    // So do board changes
+    cache();
+    helper.OnBoardItemChanged( board, &item );
+    BOOST_CHECK( !helper.insertCachedAnchors( &item, key ) );
+
+    cache();
+    helper.FullReset();
+    BOOST_CHECK( !helper.insertCachedAnchors( &item, key ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
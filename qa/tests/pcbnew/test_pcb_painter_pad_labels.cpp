@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_pcb_painter_pad_labels.cpp
+ * Test suite for the pad label layout cache of PCB_PAINTER
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_painter.h>
+
+
+class TEST_PAD_LABEL_PAINTER : public KIGFX::PCB_PAINTER
+{
+public:
+    TEST_PAD_LABEL_PAINTER() :
+            PCB_PAINTER( nullptr, FRAME_PCB_EDITOR )
+    {
+    }
+
+    using PCB_PAINTER::PAD_LABEL_LAYOUT;
+
+    // A copy, as the cache entry is updated in place
+    PAD_LABEL_LAYOUT Layout( const PAD* aPad ) { return getPadLabelLayout( aPad, F_Cu ); }
+};
+
+
+class PAD_LABEL_FIXTURE
+{
+public:
+    PAD_LABEL_FIXTURE()
+    {
+        FOOTPRINT* footprint = new FOOTPRINT( &m_board );
+        m_board.Add( footprint );
+
+        m_pad = new PAD( footprint );
+        m_pad->SetNumber( wxT( "1" ) );
+        m_pad->SetAttribute( PAD_ATTRIB::SMD );
+        m_pad->SetLayerSet( PAD::SMDMask() );
+        m_pad->SetShape( F_Cu, PAD_SHAPE::RECTANGLE );
+        m_pad->SetSize( F_Cu, VECTOR2I( pcbIUScale.mmToIU( 1.0 ), pcbIUScale.mmToIU( 1.0 ) ) );
+        footprint->Add( m_pad );
+    }
+
+    BOARD                  m_board;
+    PAD*                   m_pad;
+    TEST_PAD_LABEL_PAINTER m_painter;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PcbPainterPadLabels, PAD_LABEL_FIXTURE )
+
+
+/**
+ * Pads resized or reshaped without a commit (e.g. by the point editor) keep the board time
+ * stamp, position and orientation, but must not reuse the label layout of their old shape.
+ */
+BOOST_AUTO_TEST_CASE( UncommittedPadEditsInvalidateLayout )
+{
+    const int initialStamp = m_board.GetTimeStamp();
+
+    TEST_PAD_LABEL_PAINTER::PAD_LABEL_LAYOUT small = m_painter.Layout( m_pad );
+    BOOST_REQUIRE( !small.m_padNumber.IsEmpty() );
+
+    // Unchanged pad: same layout
+    TEST_PAD_LABEL_PAINTER::PAD_LABEL_LAYOUT same = m_painter.Layout( m_pad );
+    BOOST_CHECK_EQUAL( same.m_padNumberSize, small.m_padNumberSize );
+
+    m_pad->SetSize( F_Cu, VECTOR2I( pcbIUScale.mmToIU( 3.0 ), pcbIUScale.mmToIU( 3.0 ) ) );
+    BOOST_REQUIRE_EQUAL( m_board.GetTimeStamp(), initialStamp );
+
+    TEST_PAD_LABEL_PAINTER::PAD_LABEL_LAYOUT large = m_painter.Layout( m_pad );
+    BOOST_CHECK_GT( large.m_padNumberSize.y, small.m_padNumberSize.y );
+
+    m_pad->SetOffset( F_Cu, VECTOR2I( pcbIUScale.mmToIU( 1.0 ), 0 ) );
+
+    TEST_PAD_LABEL_PAINTER::PAD_LABEL_LAYOUT offset = m_painter.Layout( m_pad );
+    BOOST_CHECK_NE( offset.m_center, large.m_center );
+
+    // A narrow pad gets vertical labels
+    m_pad->SetShape( F_Cu, PAD_SHAPE::OVAL );
+    m_pad->SetSize( F_Cu, VECTOR2I( pcbIUScale.mmToIU( 1.0 ), pcbIUScale.mmToIU( 3.0 ) ) );
+
+    TEST_PAD_LABEL_PAINTER::PAD_LABEL_LAYOUT oval = m_painter.Layout( m_pad );
+    BOOST_CHECK( oval.m_vertical );
+    BOOST_CHECK( !offset.m_vertical );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,7 @@
 #include <router/pns_node.h>
 #include <router/pns_router.h>
 #include <router/pns_item.h>
+#include <router/pns_segment.h>
 #include <router/pns_via.h>
 #include <router/pns_kicad_iface.h>
 
@@ -505,3 +506,66 @@ BOOST_AUTO_TEST_CASE( PCBViaBackdrillCloneRetainsData )
     checkVia( *viaClone );
 }
 
+
+
+BOOST_AUTO_TEST_CASE( PNSIncrementalWorldUpdate )
+{
+    BOARD                board;
+    PNS_KICAD_IFACE_BASE iface;
+    PNS::ROUTER          router;
+
+    iface.SetBoard( &board );
+    iface.SetTrackBoardChanges( true );
+    board.AddListener( &iface );
+    router.SetInterface( &iface );
+
+    auto addTrack =
+            [&]( int aY )
+            {
+                PCB_TRACK* track = new PCB_TRACK( &board );
+                track->SetStart( VECTOR2I( 0, aY ) );
+                track->SetEnd( VECTOR2I( 1000000, aY ) );
+                track->SetWidth( 200000 );
+                track->SetLayer( F_Cu );
+                board.Add( track );
+                return track;
+            };
+
+    std::vector<PCB_TRACK*> tracks;
+
+    for( int ii = 0; ii < 20; ii++ )
+        tracks.push_back( addTrack( ii * 1000000 ) );
+
+    router.SyncWorld();
+
+    PNS::NODE* world = router.GetWorld();
+
+    BOOST_REQUIRE( world );
+    BOOST_CHECK_EQUAL( world->FindItemsByParent( tracks[0] ).size(), 1 );
+
+    // A few changes are applied to the existing world rather than building a new one
+    PCB_TRACK* added = addTrack( 50000000 );
+    PCB_TRACK* removed = tracks[1];
+
+    board.Remove( removed );
+
+    tracks[0]->SetEnd( VECTOR2I( 2000000, 0 ) );
+    board.OnItemChanged( tracks[0] );
+
+    router.SyncWorld();
+
+    BOOST_CHECK( router.GetWorld() == world );
+    BOOST_CHECK_EQUAL( world->FindItemsByParent( removed ).size(), 0 );
+    BOOST_CHECK_EQUAL( world->FindItemsByParent( added ).size(), 1 );
+    BOOST_CHECK_EQUAL( world->FindItemsByParent( tracks[2] ).size(), 1 );
+
+    std::vector<PNS::ITEM*> changed = world->FindItemsByParent( tracks[0] );
+
+    BOOST_REQUIRE_EQUAL( changed.size(), 1 );
+    BOOST_REQUIRE( changed[0]->OfKind( PNS::ITEM::SEGMENT_T ) );
+    BOOST_CHECK_EQUAL( static_cast<PNS::SEGMENT*>( changed[0] )->Seg().B, VECTOR2I( 2000000, 0 ) );
+
+    router.ClearWorld();
+    board.RemoveListener( &iface );
+    delete removed;
+}
@@ -0,0 +1,139 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <spread_footprints.h>
+
+
+namespace
+{
+
+FOOTPRINT* addFootprint( BOARD& aBoard, const wxString& aRef, const KIID& aSheet, int aSize )
+{
+    FOOTPRINT* footprint = new FOOTPRINT( &aBoard );
+    PAD*       pad = new PAD( footprint );
+
+    pad->SetAttribute( PAD_ATTRIB::SMD );
+    pad->SetLayerSet( PAD::SMDMask() );
+    pad->SetSize( PADSTACK::ALL_LAYERS, VECTOR2I( aSize, aSize / 2 ) );
+    footprint->Add( pad );
+
+    KIID_PATH path;
+    path.push_back( aSheet );
+    path.push_back( KIID() );
+
+    footprint->SetReference( aRef );
+    footprint->SetPath( path );
+
+    // Everything is stacked at the origin, as after reading a netlist
+    footprint->SetPosition( VECTOR2I( 0, 0 ) );
+    aBoard.Add( footprint );
+
+    return footprint;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( SpreadFootprintsTests )
+
+
+BOOST_AUTO_TEST_CASE( NoOverlapAfterSpread )
+{
+    BOARD                   board;
+    std::vector<FOOTPRINT*> footprints;
+    KIID                    sheets[3];
+
+    for( int ii = 0; ii < 60; ii++ )
+    {
+        int size = pcbIUScale.mmToIU( 1 + ( ii % 4 ) );
+
+        footprints.push_back( addFootprint( board, wxString::Format( wxS( "R%d" ), ii + 1 ),
+                                            sheets[ii % 3], size ) );
+    }
+
+    const VECTOR2I target( pcbIUScale.mmToIU( 50 ), pcbIUScale.mmToIU( 20 ) );
+
+    SpreadFootprints( &footprints, target, true );
+
+    std::vector<BOX2I> boxes;
+
+    for( FOOTPRINT* footprint : footprints )
+    {
+        boxes.push_back( footprint->GetBoundingBox( false ) );
+
+        BOOST_CHECK_GE( boxes.back().GetLeft(), target.x );
+        BOOST_CHECK_GE( boxes.back().GetTop(), target.y );
+    }
+
+    for( size_t ii = 0; ii < boxes.size(); ii++ )
+    {
+        for( size_t jj = ii + 1; jj < boxes.size(); jj++ )
+        {
+            BOOST_CHECK_MESSAGE( !boxes[ii].Intersects( boxes[jj] ),
+                                 footprints[ii]->GetReference() << " overlaps "
+                                 << footprints[jj]->GetReference() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( SameSizeFootprintsKeepReferenceOrder )
+{
+    BOARD                   board;
+    std::vector<FOOTPRINT*> footprints;
+    KIID                    sheet;
+
+    // Inserted out of order; a block of same-size footprints is laid out by reference
+    for( int ref : { 3, 1, 10, 2 } )
+    {
+        footprints.push_back( addFootprint( board, wxString::Format( wxS( "C%d" ), ref ), sheet,
+                                            pcbIUScale.mmToIU( 2 ) ) );
+    }
+
+    SpreadFootprints( &footprints, VECTOR2I( 0, 0 ), true );
+
+    auto posOf =
+            [&]( const wxString& aRef )
+            {
+                for( FOOTPRINT* footprint : footprints )
+                {
+                    if( footprint->GetReference() == aRef )
+                        return footprint->GetPosition();
+                }
+
+                return VECTOR2I();
+            };
+
+    // Wide footprints are stacked vertically
+    BOOST_CHECK_LT( posOf( wxS( "C1" ) ).y, posOf( wxS( "C2" ) ).y );
+    BOOST_CHECK_LT( posOf( wxS( "C2" ) ).y, posOf( wxS( "C3" ) ).y );
+    BOOST_CHECK_LT( posOf( wxS( "C3" ) ).y, posOf( wxS( "C10" ) ).y );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -80,4 +80,51 @@ BOOST_AUTO_TEST_CASE( RescuedLayers )
     BOOST_TEST( zone.IsOnCopperLayer() == false );
 }
 
+
+/**
+ * The cached fill hit-testers must follow fills edited in place, which keep their address.
+ */
+BOOST_AUTO_TEST_CASE( CachedFillHitTestFollowsEdits )
+{
+    ZONE zone( &m_board );
+
+    zone.SetLayer( F_Cu );
+
+    SHAPE_POLY_SET fill;
+    fill.NewOutline();
+    fill.Append( VECTOR2I( 0, 0 ) );
+    fill.Append( VECTOR2I( 1000000, 0 ) );
+    fill.Append( VECTOR2I( 1000000, 1000000 ) );
+    fill.Append( VECTOR2I( 0, 1000000 ) );
+
+    zone.SetFilledPolysList( F_Cu, fill );
+
+    const VECTOR2I inside( 500000, 500000 );
+    const VECTOR2I moved( 5500000, 500000 );
+
+    BOOST_CHECK( zone.HitTestFilledAreaCached( F_Cu, inside ) );
+    BOOST_CHECK( !zone.HitTestFilledAreaCached( F_Cu, moved ) );
+
+    zone.Move( VECTOR2I( 5000000, 0 ) );
+
+    BOOST_CHECK( !zone.HitTestFilledAreaCached( F_Cu, inside ) );
+    BOOST_CHECK( zone.HitTestFilledAreaCached( F_Cu, moved ) );
+
+    // Reading the fill leaves the cached tester valid
+    const ZONE& constZone = zone;
+    unsigned    revision = zone.GetFillRevision();
+
+    BOOST_CHECK_EQUAL( constZone.GetFill( F_Cu )->OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( zone.GetFilledPolysList( F_Cu )->OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( zone.GetFillRevision(), revision );
+
+    // Same outline count and first point, only the last corner moves
+    zone.GetFill( F_Cu )->SetVertex( 3, VECTOR2I( 5000000, 100000 ) );
+
+    BOOST_CHECK( !zone.HitTestFilledAreaCached( F_Cu, VECTOR2I( 5100000, 900000 ) ) );
+    BOOST_CHECK_EQUAL( zone.HitTestFilledAreaCached( F_Cu, moved ),
+                       zone.HitTestFilledArea( F_Cu, moved ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -35,7 +35,10 @@
 #include <settings/settings_manager.h>
 #include <geometry/shape_poly_set.h>
 #include <advanced_config.h>
+#include <connectivity/connectivity_algo.h>
 #include <connectivity/connectivity_data.h>
+#include <connectivity/connectivity_items.h>
+#include <drc/drc_engine.h>
 
 
 struct ZONE_FILL_TEST_FIXTURE
@@ -622,3 +625,418 @@ BOOST_FIXTURE_TEST_CASE( HatchZoneThermalConnectivity, ZONE_FILL_TEST_FIXTURE )
                                            "even with large hatch gaps.",
                                            unconnectedCount ) );
 }
+
+
+/**
+ * Boards built from scratch, for fills which are compared between code paths or between items
+ * of the same board rather than against a saved board.
+ */
+struct SYNTHETIC_ZONE_FILL_FIXTURE
+{
+    SYNTHETIC_ZONE_FILL_FIXTURE() :
+            m_board( std::make_unique<BOARD>() )
+    {
+        m_board->SetCopperLayerCount( 4 );
+        m_board->SetEnabledLayers( m_board->GetEnabledLayers() | LSET::AllCuMask( 4 ) );
+
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+        m_board->BuildConnectivity();
+
+        auto drcEngine = std::make_shared<DRC_ENGINE>( m_board.get(), &bds );
+        drcEngine->InitEngine( wxFileName() );
+        bds.m_DRCEngine = drcEngine;
+    }
+
+    static int mm( double aMM ) { return pcbIUScale.mmToIU( aMM ); }
+
+    int AddNet( const wxString& aName )
+    {
+        NETINFO_ITEM* net = new NETINFO_ITEM( m_board.get(), aName );
+        m_board->Add( net );
+        return net->GetNetCode();
+    }
+
+    ZONE* AddZone( const BOX2I& aArea, PCB_LAYER_ID aLayer, int aNetCode )
+    {
+        ZONE* zone = new ZONE( m_board.get() );
+        zone->SetLayer( aLayer );
+        zone->SetNetCode( aNetCode );
+        zone->SetLocalClearance( mm( 0.2 ) );
+        zone->SetMinThickness( mm( 0.25 ) );
+        zone->SetThermalReliefGap( mm( 0.5 ) );
+        zone->SetThermalReliefSpokeWidth( mm( 0.3 ) );
+        zone->SetIslandRemovalMode( ISLAND_REMOVAL_MODE::NEVER );
+
+        SHAPE_LINE_CHAIN outline;
+        outline.Append( aArea.GetOrigin() );
+        outline.Append( VECTOR2I( aArea.GetRight(), aArea.GetTop() ) );
+        outline.Append( aArea.GetEnd() );
+        outline.Append( VECTOR2I( aArea.GetLeft(), aArea.GetBottom() ) );
+        outline.SetClosed( true );
+        zone->AddPolygon( outline );
+
+        m_board->Add( zone );
+        return zone;
+    }
+
+    PCB_VIA* AddVia( const VECTOR2I& aPos, int aNetCode )
+    {
+        PCB_VIA* via = new PCB_VIA( m_board.get() );
+        via->SetPosition( aPos );
+        via->SetLayerPair( F_Cu, B_Cu );
+        via->SetDrill( mm( 0.3 ) );
+        via->SetWidth( PADSTACK::ALL_LAYERS, mm( 0.6 ) );
+        via->SetNetCode( aNetCode );
+        m_board->Add( via );
+        return via;
+    }
+
+    PCB_TRACK* AddTrack( const VECTOR2I& aStart, const VECTOR2I& aEnd, PCB_LAYER_ID aLayer,
+                         int aNetCode )
+    {
+        PCB_TRACK* track = new PCB_TRACK( m_board.get() );
+        track->SetStart( aStart );
+        track->SetEnd( aEnd );
+        track->SetLayer( aLayer );
+        track->SetWidth( mm( 0.25 ) );
+        track->SetNetCode( aNetCode );
+        m_board->Add( track );
+        return track;
+    }
+
+    /**
+     * Add a footprint holding a single SMD pad on \a aLayer.
+     */
+    PAD* AddPad( const VECTOR2I& aPos, PAD_SHAPE aShape, const VECTOR2I& aSize,
+                 const EDA_ANGLE& aOrientation, PCB_LAYER_ID aLayer, int aNetCode )
+    {
+        FOOTPRINT* fp = new FOOTPRINT( m_board.get() );
+        fp->SetPosition( aPos );
+        fp->SetReference( wxString::Format( "U%d", (int) m_board->Footprints().size() + 1 ) );
+
+        PAD* pad = new PAD( fp );
+        pad->SetNumber( "1" );
+        pad->SetAttribute( PAD_ATTRIB::SMD );
+        pad->SetLayerSet( LSET( { aLayer } ) );
+        pad->SetShape( PADSTACK::ALL_LAYERS, aShape );
+        pad->SetSize( PADSTACK::ALL_LAYERS, aSize );
+        pad->SetPosition( aPos );
+        pad->SetOrientation( aOrientation );
+        pad->SetNetCode( aNetCode );
+        fp->Add( pad );
+
+        m_board->Add( fp );
+        return pad;
+    }
+
+    /**
+     * Fill all the zones with the hatch hole scanline enabled or not.
+     */
+    void FillZones( bool aHatchScanline )
+    {
+        ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+        bool          original = cfg.m_ZoneFillHatchScanline;
+
+        cfg.m_ZoneFillHatchScanline = aHatchScanline;
+        KI_TEST::FillZones( m_board.get() );
+        cfg.m_ZoneFillHatchScanline = original;
+    }
+
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+/**
+ * Classifying the hatch holes before clipping them must not change the fill: compare it with
+ * the fill obtained by clipping every hole.  The zone has cutouts crossing the hatch grid, and
+ * knockouts and a thermal ring cutting through the webs.
+ */
+BOOST_FIXTURE_TEST_CASE( HatchFillScanlineMatchesFullClipping, SYNTHETIC_ZONE_FILL_FIXTURE )
+{
+    int gnd = AddNet( "GND" );
+    int sig = AddNet( "SIG" );
+
+    // Not aligned on the hatch grid
+    const VECTOR2I origin( mm( 10.37 ), mm( 7.71 ) );
+
+    ZONE* zone = AddZone( BOX2I( origin, VECTOR2I( mm( 40 ), mm( 30 ) ) ), F_Cu, gnd );
+    zone->SetFillMode( ZONE_FILL_MODE::HATCH_PATTERN );
+    zone->SetHatchThickness( mm( 0.4 ) );
+    zone->SetHatchGap( mm( 1.1 ) );
+    zone->SetHatchSmoothingLevel( 1 );
+    zone->SetHatchSmoothingValue( 0.3 );
+    zone->SetHatchHoleMinArea( 0.3 );
+    zone->SetHatchBorderAlgorithm( 1 );
+
+    // A rectangular and a slanted cutout, both crossing rows and columns of the grid
+    SHAPE_LINE_CHAIN cutout;
+    cutout.Append( origin + VECTOR2I( mm( 5.13 ), mm( 4.29 ) ) );
+    cutout.Append( origin + VECTOR2I( mm( 13.61 ), mm( 4.29 ) ) );
+    cutout.Append( origin + VECTOR2I( mm( 13.61 ), mm( 9.87 ) ) );
+    cutout.Append( origin + VECTOR2I( mm( 5.13 ), mm( 9.87 ) ) );
+    cutout.SetClosed( true );
+    zone->Outline()->AddHole( cutout );
+
+    SHAPE_LINE_CHAIN slanted;
+    slanted.Append( origin + VECTOR2I( mm( 22.4 ), mm( 18.1 ) ) );
+    slanted.Append( origin + VECTOR2I( mm( 33.9 ), mm( 21.7 ) ) );
+    slanted.Append( origin + VECTOR2I( mm( 27.3 ), mm( 26.2 ) ) );
+    slanted.SetClosed( true );
+    zone->Outline()->AddHole( slanted );
+
+    // Knockouts straddling the webs
+    for( int ii = 0; ii < 6; ii++ )
+        AddVia( origin + VECTOR2I( mm( 3.1 + ii * 4.37 ), mm( 14.3 + ii * 0.29 ) ), sig );
+
+    AddTrack( origin + VECTOR2I( mm( 1.7 ), mm( 27.9 ) ), origin + VECTOR2I( mm( 38.2 ), mm( 12.3 ) ),
+              F_Cu, sig );
+
+    AddPad( origin + VECTOR2I( mm( 17.55 ), mm( 22.45 ) ), PAD_SHAPE::RECTANGLE,
+            VECTOR2I( mm( 1.2 ), mm( 0.8 ) ), ANGLE_0, F_Cu, gnd );
+
+    for( const EDA_ANGLE& orientation : { ANGLE_0, EDA_ANGLE( 30.0, DEGREES_T ), ANGLE_45 } )
+    {
+        BOOST_TEST_CONTEXT( "Hatch orientation " << orientation.AsDegrees() )
+        {
+            zone->SetHatchOrientation( orientation );
+
+            FillZones( false );
+            SHAPE_POLY_SET expected = zone->GetFilledPolysList( F_Cu )->CloneDropTriangulation();
+
+            FillZones( true );
+            SHAPE_POLY_SET actual = zone->GetFilledPolysList( F_Cu )->CloneDropTriangulation();
+
+            BOOST_REQUIRE( expected.OutlineCount() > 0 );
+
+            int expectedHoles = 0;
+            int actualHoles = 0;
+
+            for( int ii = 0; ii < expected.OutlineCount(); ii++ )
+                expectedHoles += expected.HoleCount( ii );
+
+            for( int ii = 0; ii < actual.OutlineCount(); ii++ )
+                actualHoles += actual.HoleCount( ii );
+
+            // The hatch makes hundreds of holes
+            BOOST_CHECK_GT( expectedHoles, 100 );
+
+            BOOST_CHECK_EQUAL( actual.OutlineCount(), expected.OutlineCount() );
+            BOOST_CHECK_EQUAL( actualHoles, expectedHoles );
+            BOOST_CHECK_CLOSE( actual.Area(), expected.Area(), 0.01 );
+
+            // Only round-off differences are allowed between the two fills
+            SHAPE_POLY_SET difference;
+            difference.BooleanXor( expected, actual );
+
+            BOOST_CHECK_LT( difference.Area(), expected.Area() * 1e-5 );
+        }
+    }
+}
+
+
+/**
+ * @return the part of the fill in the thermal gap around \a aPad, which only holds the spokes
+ *         of the pad: one outline per spoke.
+ */
+static SHAPE_POLY_SET thermalGapFill( const ZONE* aZone, const PAD* aPad, PCB_LAYER_ID aLayer )
+{
+    int gap = aZone->GetThermalReliefGap();
+    int maxError = aZone->GetBoard()->GetDesignSettings().m_MaxError;
+
+    SHAPE_POLY_SET inner;
+    SHAPE_POLY_SET gapArea;
+
+    aPad->TransformShapeToPolygon( inner, aLayer, gap / 4, maxError, ERROR_OUTSIDE );
+    aPad->TransformShapeToPolygon( gapArea, aLayer, gap * 3 / 4, maxError, ERROR_INSIDE );
+    gapArea.BooleanSubtract( inner );
+
+    SHAPE_POLY_SET spokes = aZone->GetFilledPolysList( aLayer )->CloneDropTriangulation();
+    spokes.BooleanIntersection( gapArea );
+    return spokes;
+}
+
+
+/**
+ * The spoke boxes are shared between pads of the same shape and the spoke ends are hit-tested
+ * through an index.  Rotated pads, pads of the same shape but another size and custom pads must
+ * still get their own spokes, and spokes blocked by other copper must still be dropped.
+ */
+BOOST_FIXTURE_TEST_CASE( ThermalSpokesSharedBoxes, SYNTHETIC_ZONE_FILL_FIXTURE )
+{
+    int gnd = AddNet( "GND" );
+    int sig = AddNet( "SIG" );
+
+    ZONE* zone = AddZone( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( mm( 40 ), mm( 20 ) ) ), F_Cu, gnd );
+
+    const VECTOR2I rectSize( mm( 1.0 ), mm( 2.0 ) );
+
+    PAD* straight = AddPad( VECTOR2I( mm( 5 ), mm( 6 ) ), PAD_SHAPE::RECTANGLE, rectSize,
+                            ANGLE_0, F_Cu, gnd );
+    PAD* rotated = AddPad( VECTOR2I( mm( 11 ), mm( 6 ) ), PAD_SHAPE::RECTANGLE, rectSize,
+                           EDA_ANGLE( 30.0, DEGREES_T ), F_Cu, gnd );
+    PAD* quarter = AddPad( VECTOR2I( mm( 17 ), mm( 6 ) ), PAD_SHAPE::RECTANGLE, rectSize,
+                           ANGLE_90, F_Cu, gnd );
+    PAD* larger = AddPad( VECTOR2I( mm( 24 ), mm( 6 ) ), PAD_SHAPE::RECTANGLE,
+                          VECTOR2I( mm( 2.0 ), mm( 3.0 ) ), ANGLE_0, F_Cu, gnd );
+
+    // Custom pads: a small round anchor with an L-shaped primitive
+    const std::vector<VECTOR2I> lShape = { VECTOR2I( 0, 0 ), VECTOR2I( mm( 1.5 ), 0 ),
+                                           VECTOR2I( mm( 1.5 ), mm( 0.5 ) ),
+                                           VECTOR2I( mm( 0.5 ), mm( 0.5 ) ),
+                                           VECTOR2I( mm( 0.5 ), mm( 1.5 ) ),
+                                           VECTOR2I( 0, mm( 1.5 ) ) };
+    std::vector<PAD*>           customPads;
+
+    for( const EDA_ANGLE& orientation : { ANGLE_0, ANGLE_90 } )
+    {
+        VECTOR2I pos( mm( 5 ) + (int) customPads.size() * mm( 7 ), mm( 14 ) );
+        PAD*     pad = AddPad( pos, PAD_SHAPE::CUSTOM, VECTOR2I( mm( 0.6 ), mm( 0.6 ) ),
+                               orientation, F_Cu, gnd );
+
+        pad->SetAnchorPadShape( F_Cu, PAD_SHAPE::CIRCLE );
+        pad->AddPrimitivePoly( F_Cu, lShape, 0, true );
+
+        customPads.push_back( pad );
+    }
+
+    // The right spoke of this pad ends in the clearance of a track
+    PAD* blocked = AddPad( VECTOR2I( mm( 24 ), mm( 14 ) ), PAD_SHAPE::RECTANGLE, rectSize,
+                           ANGLE_0, F_Cu, gnd );
+
+    AddTrack( VECTOR2I( mm( 25 ), mm( 11 ) ), VECTOR2I( mm( 25 ), mm( 17 ) ), F_Cu, sig );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    SHAPE_POLY_SET straightSpokes = thermalGapFill( zone, straight, F_Cu );
+    SHAPE_POLY_SET rotatedSpokes = thermalGapFill( zone, rotated, F_Cu );
+    SHAPE_POLY_SET quarterSpokes = thermalGapFill( zone, quarter, F_Cu );
+    SHAPE_POLY_SET largerSpokes = thermalGapFill( zone, larger, F_Cu );
+
+    BOOST_CHECK_EQUAL( straightSpokes.OutlineCount(), 4 );
+    BOOST_CHECK_EQUAL( rotatedSpokes.OutlineCount(), 4 );
+    BOOST_CHECK_EQUAL( quarterSpokes.OutlineCount(), 4 );
+    BOOST_CHECK_EQUAL( largerSpokes.OutlineCount(), 4 );
+
+    // The spokes of a rotated pad are the rotated spokes of the straight one
+    BOOST_CHECK_CLOSE( rotatedSpokes.Area(), straightSpokes.Area(), 2.0 );
+    BOOST_CHECK_CLOSE( quarterSpokes.Area(), straightSpokes.Area(), 2.0 );
+
+    SHAPE_POLY_SET customSpokes = thermalGapFill( zone, customPads[0], F_Cu );
+    SHAPE_POLY_SET rotatedCustomSpokes = thermalGapFill( zone, customPads[1], F_Cu );
+
+    BOOST_CHECK_GT( customSpokes.OutlineCount(), 0 );
+    BOOST_CHECK_EQUAL( rotatedCustomSpokes.OutlineCount(), customSpokes.OutlineCount() );
+    BOOST_CHECK_CLOSE( rotatedCustomSpokes.Area(), customSpokes.Area(), 2.0 );
+
+    SHAPE_POLY_SET blockedSpokes = thermalGapFill( zone, blocked, F_Cu );
+
+    BOOST_CHECK_EQUAL( blockedSpokes.OutlineCount(), 3 );
+
+    for( int ii = 0; ii < blockedSpokes.OutlineCount(); ii++ )
+    {
+        BOX2I spoke = blockedSpokes.COutline( ii ).BBox();
+        BOOST_CHECK_LT( spoke.GetRight(), blocked->GetPosition().x + rectSize.x / 2 );
+    }
+}
+
+
+/**
+ * The zone layers are classified in parallel.  Check the result against the serial
+ * classification, which walks every cluster of the board for each zone layer, on a board where
+ * tracks split multi-layer zones into isolated, singly and multiply connected islands.
+ */
+BOOST_FIXTURE_TEST_CASE( ParallelIslandClassification, SYNTHETIC_ZONE_FILL_FIXTURE )
+{
+    int gnd = AddNet( "GND" );
+    int pwr = AddNet( "PWR" );
+    int sig = AddNet( "SIG" );
+
+    const BOX2I area( VECTOR2I( 0, 0 ), VECTOR2I( mm( 30 ), mm( 20 ) ) );
+
+    ZONE* gndZone = AddZone( area, F_Cu, gnd );
+    gndZone->SetLayerSet( { F_Cu, B_Cu } );
+
+    ZONE* pwrZone = AddZone( area, In1_Cu, pwr );
+    pwrZone->SetLayerSet( { In1_Cu, In2_Cu } );
+
+    AddZone( BOX2I( VECTOR2I( mm( 32 ), 0 ), VECTOR2I( mm( 10 ), mm( 20 ) ) ), F_Cu, pwr );
+
+    // Split each layer of the zones into three columns
+    for( PCB_LAYER_ID layer : { F_Cu, In1_Cu, In2_Cu, B_Cu } )
+    {
+        for( int x : { mm( 10 ), mm( 20 ) } )
+            AddTrack( VECTOR2I( x, -mm( 1 ) ), VECTOR2I( x, mm( 21 ) ), layer, sig );
+    }
+
+    // GND: the first column is connected once, the second one twice, the third one not at all
+    AddVia( VECTOR2I( mm( 5 ), mm( 10 ) ), gnd );
+    AddVia( VECTOR2I( mm( 15 ), mm( 5 ) ), gnd );
+    AddVia( VECTOR2I( mm( 15 ), mm( 15 ) ), gnd );
+
+    // PWR: only the second column is connected, once
+    AddVia( VECTOR2I( mm( 15 ), mm( 10 ) ), pwr );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>> islands;
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            islands[zone][layer] = ISOLATED_ISLANDS();
+    }
+
+    m_board->GetConnectivity()->FillIsolatedIslandsMap( islands );
+
+    // Serial classification of the same connectivity
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> algo = m_board->GetConnectivity()->GetConnectivityAlgo();
+    const CN_CONNECTIVITY_ALGO::CLUSTERS  clusters =
+            algo->SearchClusters( CN_CONNECTIVITY_ALGO::CSM_CONNECTIVITY_CHECK );
+
+    int isolatedCount = 0;
+    int singleConnectionCount = 0;
+
+    for( auto& [ zone, zoneIslands ] : islands )
+    {
+        for( auto& [ layer, layerIslands ] : zoneIslands )
+        {
+            ISOLATED_ISLANDS expected;
+
+            for( const std::shared_ptr<CN_CLUSTER>& cluster : clusters )
+            {
+                for( CN_ITEM* item : *cluster )
+                {
+                    if( item->Parent() != zone || item->GetBoardLayer() != layer )
+                        continue;
+
+                    CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+
+                    if( cluster->IsOrphaned() )
+                        expected.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
+                    else if( z->HasSingleConnection() )
+                        expected.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
+                }
+            }
+
+            std::sort( expected.m_IsolatedOutlines.begin(), expected.m_IsolatedOutlines.end() );
+            std::sort( expected.m_SingleConnectionOutlines.begin(),
+                       expected.m_SingleConnectionOutlines.end() );
+
+            BOOST_TEST_CONTEXT( zone->GetNetname().ToStdString() << " zone on "
+                                << LayerName( layer ).ToStdString() )
+            {
+                BOOST_CHECK( layerIslands.m_IsolatedOutlines == expected.m_IsolatedOutlines );
+                BOOST_CHECK( layerIslands.m_SingleConnectionOutlines
+                             == expected.m_SingleConnectionOutlines );
+            }
+
+            isolatedCount += (int) layerIslands.m_IsolatedOutlines.size();
+            singleConnectionCount += (int) layerIslands.m_SingleConnectionOutlines.size();
+        }
+    }
+
+    // Both kinds of islands are present, so the comparison above means something
+    BOOST_CHECK_GT( isolatedCount, 0 );
+    BOOST_CHECK_GT( singleConnectionCount, 0 );
+}
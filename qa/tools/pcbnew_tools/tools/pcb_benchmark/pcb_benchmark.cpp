@@ -0,0 +1,484 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <set>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+#include <wx/tokenzr.h>
+
+#include <nlohmann/json.hpp>
+
+#include <core/profile.h>
+#include <core/trace_events.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <drc/drc_engine.h>
+#include <exporters/step/exporter_step.h>
+#include <pcb_io/pcb_io_mgr.h>
+#include <pcb_plot_params.h>
+#include <pcbplot.h>
+#include <plotters/plotter.h>
+#include <reporter.h>
+#include <settings/settings_manager.h>
+#include <zone.h>
+#include <zone_filler.h>
+#include <3d_rendering/raytracing/render_3d_raytrace_ram.h>
+#include <3d_rendering/track_ball.h>
+#include <3d_viewer/eda_3d_viewer_settings.h>
+
+
+namespace
+{
+
+/// Operations in the order they are run on each repetition.
+const std::vector<std::string> ALL_OPERATIONS = { "load", "connectivity", "zone_fill", "drc",
+                                                  "save", "gerber", "step", "raytrace" };
+
+
+/**
+ * Peak resident set size of the process so far, in kB.  0 where it can't be queried.
+ */
+long peakRssKb()
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+    {
+#if defined( __APPLE__ )
+        return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+
+    return 0;
+}
+
+
+nlohmann::json summarize( std::vector<double> aSamplesMs )
+{
+    nlohmann::json result;
+
+    if( aSamplesMs.empty() )
+        return result;
+
+    std::sort( aSamplesMs.begin(), aSamplesMs.end() );
+
+    const size_t n = aSamplesMs.size();
+    const double mean = std::accumulate( aSamplesMs.begin(), aSamplesMs.end(), 0.0 ) / n;
+    double       variance = 0.0;
+
+    for( double sample : aSamplesMs )
+        variance += ( sample - mean ) * ( sample - mean );
+
+    result["runs"] = n;
+    result["min_ms"] = aSamplesMs.front();
+    result["max_ms"] = aSamplesMs.back();
+    result["mean_ms"] = mean;
+    result["median_ms"] = ( n % 2 ) ? aSamplesMs[n / 2]
+                                    : ( aSamplesMs[n / 2 - 1] + aSamplesMs[n / 2] ) / 2.0;
+    result["stddev_ms"] = n > 1 ? std::sqrt( variance / ( n - 1 ) ) : 0.0;
+    result["samples_ms"] = aSamplesMs;
+
+    return result;
+}
+
+
+struct BOARD_RESULTS
+{
+    std::map<std::string, std::vector<double>> m_OperationMs;
+    long                                       m_PeakRssKb = 0;
+    std::map<std::string, std::vector<double>> m_DrcProviderMs;
+    std::vector<std::string>                   m_Errors;
+};
+
+
+void fillZones( BOARD* aBoard )
+{
+    ZONE_FILLER        filler( aBoard, nullptr );
+    std::vector<ZONE*> toFill( aBoard->Zones().begin(), aBoard->Zones().end() );
+
+    filler.Fill( toFill );
+}
+
+
+void runDrc( BOARD* aBoard, const wxFileName& aRulesFile, BOARD_RESULTS& aResults )
+{
+    BOARD_DESIGN_SETTINGS&      bds = aBoard->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> drcEngine = std::make_shared<DRC_ENGINE>( aBoard, &bds );
+
+    drcEngine->InitEngine( aRulesFile.FileExists() ? aRulesFile : wxFileName() );
+    drcEngine->SetViolationHandler(
+            []( const std::shared_ptr<DRC_ITEM>&, const VECTOR2I&, int,
+                const std::function<void( PCB_MARKER* )>& )
+            {
+            } );
+
+    bds.m_DRCEngine = drcEngine;
+
+    // The DRC engine records a zone per provider; use them for the per-provider breakdown.
+    auto drcZonesMs =
+            []()
+            {
+                std::map<std::string, double> providerMs;
+
+                TRACE_EVENTS::Instance().ForEachZone(
+                        [&]( const std::string& aName, const char* aCategory, int64_t aDurationUs )
+                        {
+                            if( std::string( aCategory ) == "drc" )
+                                providerMs[aName] += aDurationUs / 1000.0;
+                        } );
+
+                return providerMs;
+            };
+
+    // A session started with the TraceEventsFile setting is left running, and the zones it
+    // recorded before this run are subtracted.  Otherwise record a session for this run only.
+    const bool                    ownSession = !TRACE_EVENTS::IsEnabled();
+    std::map<std::string, double> previousMs;
+
+    if( ownSession )
+        TRACE_EVENTS::Instance().Start();
+    else
+        previousMs = drcZonesMs();
+
+    drcEngine->RunTests( EDA_UNITS::MM, true, false );
+
+    if( ownSession )
+        TRACE_EVENTS::Instance().Finish();
+
+    for( const auto& [name, ms] : drcZonesMs() )
+        aResults.m_DrcProviderMs[name].push_back( ms - previousMs[name] );
+
+    drcEngine->ClearViolationHandler();
+}
+
+
+void exportGerbers( BOARD* aBoard, const wxString& aOutputDir )
+{
+    PCB_PLOT_PARAMS plotOpts;
+
+    plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+    plotOpts.SetOutputDirectory( aOutputDir );
+
+    for( PCB_LAYER_ID layer : aBoard->GetEnabledLayers().UIOrder() )
+    {
+        wxFileName fn( aOutputDir, wxString::Format( wxS( "benchmark-layer%d" ), (int) layer ),
+                       wxS( "gbr" ) );
+        LSEQ       plotSequence;
+
+        plotSequence.push_back( layer );
+
+        PLOTTER* plotter = StartPlotBoard( aBoard, &plotOpts, layer, aBoard->GetLayerName( layer ),
+                                           fn.GetFullPath(), wxEmptyString, wxEmptyString );
+
+        if( plotter )
+        {
+            PlotBoardLayers( aBoard, plotter, plotSequence, plotOpts );
+            plotter->EndPlot();
+        }
+
+        delete plotter;
+    }
+}
+
+
+void exportStep( BOARD* aBoard, const wxString& aOutputDir )
+{
+    EXPORTER_STEP_PARAMS params;
+
+    params.m_Overwrite = true;
+
+    // 3D models depend on the libraries installed on the machine running the benchmark
+    params.m_ExportComponents = false;
+    params.m_ExportTracksVias = true;
+    params.m_ExportPads = true;
+    params.m_ExportZones = true;
+
+    NULL_REPORTER reporter;
+    EXPORTER_STEP stepExporter( aBoard, params, &reporter );
+
+    stepExporter.m_outputFile = wxFileName( aOutputDir, wxS( "benchmark" ), wxS( "step" ) ).GetFullPath();
+    stepExporter.Export();
+}
+
+
+void raytrace( BOARD* aBoard )
+{
+    EDA_3D_VIEWER_SETTINGS cfg;
+    BOARD_ADAPTER          boardAdapter;
+    NULL_REPORTER          reporter;
+    const wxSize           windowSize( 1600, 900 );
+
+    // No 3D models, as for the STEP export; there is no 3D cache manager here either.
+    cfg.m_Render.show_footprints_insert = false;
+    cfg.m_Render.show_footprints_normal = false;
+    cfg.m_Render.show_footprints_virtual = false;
+    cfg.m_Render.show_footprints_not_in_posfile = false;
+    cfg.m_Render.show_footprints_dnp = false;
+
+    boardAdapter.SetBoard( aBoard );
+    boardAdapter.m_IsBoardView = false;
+    boardAdapter.m_Cfg = &cfg;
+
+    TRACK_BALL camera( 2 * RANGE_SCALE_3D );
+    camera.SetCurWindowSize( windowSize );
+
+    RENDER_3D_RAYTRACE_RAM renderer( boardAdapter, camera );
+    renderer.SetCurWindowSize( windowSize );
+
+    while( renderer.Redraw( false, &reporter, &reporter ) )
+    {
+    }
+}
+
+
+BOARD_RESULTS benchmarkBoard( const wxFileName& aBoardFile, int aRepeat,
+                              const std::set<std::string>& aOperations, const wxString& aOutputDir )
+{
+    BOARD_RESULTS    results;
+    SETTINGS_MANAGER settingsManager;
+    wxFileName       projectFile( aBoardFile );
+    wxFileName       rulesFile( aBoardFile );
+    PROJECT*         project = nullptr;
+
+    projectFile.SetExt( wxS( "kicad_pro" ) );
+    rulesFile.SetExt( wxS( "kicad_dru" ) );
+
+    if( projectFile.FileExists() )
+    {
+        settingsManager.LoadProject( projectFile.GetFullPath() );
+        project = &settingsManager.Prj();
+    }
+
+    for( int run = 0; run < aRepeat; ++run )
+    {
+        std::unique_ptr<BOARD> board;
+
+        auto timed =
+                [&]( const std::string& aOperation, const std::function<void()>& aFunction )
+                {
+                    if( !aOperations.count( aOperation ) || ( aOperation != "load" && !board ) )
+                        return;
+
+                    try
+                    {
+                        PROF_TIMER timer;
+                        aFunction();
+                        results.m_OperationMs[aOperation].push_back( timer.msecs() );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        results.m_Errors.push_back( aOperation + ": " + ioe.What().ToStdString() );
+                    }
+                    catch( const std::exception& e )
+                    {
+                        results.m_Errors.push_back( aOperation + ": " + e.what() );
+                    }
+                };
+
+        timed( "load",
+               [&]()
+               {
+                   board.reset( PCB_IO_MGR::Load( PCB_IO_MGR::KICAD_SEXP, aBoardFile.GetFullPath(),
+                                                  nullptr, nullptr, project ) );
+
+                   if( board && project )
+                       board->SetProject( project );
+               } );
+
+        if( !board )
+        {
+            results.m_Errors.push_back( "load: could not load board" );
+            break;
+        }
+
+        timed( "connectivity", [&]() { board->BuildConnectivity(); } );
+        timed( "zone_fill", [&]() { fillZones( board.get() ); } );
+        timed( "drc", [&]() { runDrc( board.get(), rulesFile, results ); } );
+        timed( "save",
+               [&]()
+               {
+                   wxFileName fn( aOutputDir, wxS( "benchmark" ), wxS( "kicad_pcb" ) );
+                   PCB_IO_MGR::Save( PCB_IO_MGR::KICAD_SEXP, fn.GetFullPath(), board.get() );
+               } );
+        timed( "gerber", [&]() { exportGerbers( board.get(), aOutputDir ); } );
+        timed( "step", [&]() { exportStep( board.get(), aOutputDir ); } );
+        timed( "raytrace", [&]() { raytrace( board.get() ); } );
+
+        board->SetProject( nullptr );
+    }
+
+    // The high-water mark can't be reset, so it is only meaningful once per board.  It
+    // includes the boards benchmarked before this one.
+    results.m_PeakRssKb = peakRssKb();
+
+    return results;
+}
+
+
+const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of runs of each operation (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "o", "output", _( "JSON results file (default stdout)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "w", "work-dir",
+            _( "directory for the saved board and exported files (default temp dir)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "p", "operations",
+            _( "comma separated operations to run (default all): load, connectivity, zone_fill, "
+               "drc, save, gerber, step, raytrace" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board files" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum BENCHMARK_RET_CODES
+{
+    BENCHMARK_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int pcb_benchmark_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program times the board operations users wait on (load, "
+                               "connectivity, zone fill, DRC per provider, save, Gerber and STEP "
+                               "export and 3D raytracing) on the given reference boards, and "
+                               "writes the timing distributions and peak memory use as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long     repeat = 5;
+    wxString outputFile;
+    wxString workDir = wxFileName::GetTempDir();
+    wxString operationList;
+
+    cl_parser.Found( "repeat", &repeat );
+    cl_parser.Found( "output", &outputFile );
+    cl_parser.Found( "work-dir", &workDir );
+
+    std::set<std::string> operations( ALL_OPERATIONS.begin(), ALL_OPERATIONS.end() );
+
+    if( cl_parser.Found( "operations", &operationList ) )
+    {
+        operations.clear();
+
+        // Loading is needed by everything else
+        operations.insert( "load" );
+
+        wxStringTokenizer tokenizer( operationList, wxS( "," ) );
+
+        while( tokenizer.HasMoreTokens() )
+            operations.insert( tokenizer.GetNextToken().Trim().Trim( false ).ToStdString() );
+    }
+
+    nlohmann::json output;
+    bool           ok = true;
+
+    output["repeat"] = repeat;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+    {
+        wxFileName boardFile( cl_parser.GetParam( ii ) );
+        boardFile.MakeAbsolute();
+
+        std::cerr << "Benchmarking " << boardFile.GetFullPath().ToStdString() << std::endl;
+
+        BOARD_RESULTS  results = benchmarkBoard( boardFile, std::max( 1L, repeat ), operations,
+                                                 workDir );
+        nlohmann::json boardJson;
+
+        boardJson["file"] = boardFile.GetFullPath().ToStdString();
+
+        for( const std::string& operation : ALL_OPERATIONS )
+        {
+            if( !results.m_OperationMs.count( operation ) )
+                continue;
+
+            boardJson["operations"][operation] = summarize( results.m_OperationMs[operation] );
+        }
+
+        boardJson["peak_rss_kb"] = results.m_PeakRssKb;
+
+        for( const auto& [provider, samples] : results.m_DrcProviderMs )
+            boardJson["drc_providers"][provider] = summarize( samples );
+
+        if( !results.m_Errors.empty() )
+        {
+            boardJson["errors"] = results.m_Errors;
+            ok = false;
+        }
+
+        output["boards"].push_back( boardJson );
+    }
+
+    output["peak_rss_kb"] = peakRssKb();
+
+    if( outputFile.IsEmpty() )
+    {
+        std::cout << output.dump( 2 ) << std::endl;
+    }
+    else
+    {
+        std::ofstream stream( outputFile.ToStdString() );
+        stream << output.dump( 2 ) << std::endl;
+    }
+
+    return ok ? KI_TEST::RET_CODES::OK : BENCHMARK_RET_CODES::BENCHMARK_FAILED;
+}
+
+} // namespace
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "pcb_benchmark",
+                                                       "Time board operations on reference boards",
+                                                       pcb_benchmark_main_func } );
@@ -61,6 +61,7 @@
 #include <iterator>
 #include <limits>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #ifdef DEBUG
@@ -213,6 +214,12 @@ public:
     /// Remove all entries from tree
     void    RemoveAll();
 
+    /// Replace the contents of the tree with the given entries.  The tree is built bottom-up
+    /// with the Sort-Tile-Recursive algorithm, which is much faster than inserting the entries
+    /// one by one and gives full nodes with little overlap.
+    /// \param a_entries Bounding rects and data ids of the entries.  Copied, not modified.
+    void    BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries );
+
     /// Count the data elements in this container.  This is slow as no internal counter is maintained.
     int     Count() const;
 
@@ -604,6 +611,7 @@ protected:
         return true; // Continue searching
     }
 
+    void    StrSort( Branch* a_begin, Branch* a_end, int a_axis ) const;
     void    RemoveAllRec( Node* a_node ) const;
     void    Reset() const;
     void    CountRec( const Node* a_node, int& a_count ) const;
@@ -904,6 +912,87 @@ std::vector<std::pair<ELEMTYPE, DATATYPE>> RTREE_QUAL::NearestNeighbors(
     return result;
 }
 
+RTREE_TEMPLATE
+void RTREE_QUAL::BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries )
+{
+    RemoveAll();
+
+    if( a_entries.empty() )
+        return;
+
+    std::vector<Branch> branches( a_entries.size() );
+
+    for( size_t index = 0; index < a_entries.size(); ++index )
+    {
+        branches[index].m_rect = a_entries[index].first;
+        branches[index].m_data = a_entries[index].second;
+    }
+
+    // Pack each level into full nodes, then build the level above from the covers of
+    // these nodes, until a single node is left for the root
+    for( int level = 0; ; ++level )
+    {
+        StrSort( branches.data(), branches.data() + branches.size(), 0 );
+
+        std::vector<Branch> parents;
+        parents.reserve( ( branches.size() + MAXNODES - 1 ) / MAXNODES );
+
+        for( size_t start = 0; start < branches.size(); start += MAXNODES )
+        {
+            Node* node = AllocNode();
+            node->m_level = level;
+            node->m_count = (int) std::min<size_t>( MAXNODES, branches.size() - start );
+
+            for( int index = 0; index < node->m_count; ++index )
+                node->m_branch[index] = branches[start + index];
+
+            Branch parent;
+            parent.m_rect = NodeCover( node );
+            parent.m_child = node;
+            parents.push_back( parent );
+        }
+
+        if( parents.size() == 1 )
+        {
+            FreeNode( m_root );
+            m_root = parents.front().m_child;
+            return;
+        }
+
+        branches = std::move( parents );
+    }
+}
+
+
+// Sort the branches so that consecutive runs of MAXNODES branches are spatially close: the
+// branches are sorted along the first axis and cut in slabs, each slab being sorted along
+// the next axis, and so on.
+RTREE_TEMPLATE
+void RTREE_QUAL::StrSort( Branch* a_begin, Branch* a_end, int a_axis ) const
+{
+    const size_t count = a_end - a_begin;
+
+    std::sort( a_begin, a_end,
+               [a_axis]( const Branch& a_a, const Branch& a_b )
+               {
+                   // Compare the centers, halved first so integer coordinates cannot overflow
+                   return (ELEMTYPEREAL) a_a.m_rect.m_min[a_axis] / 2 + (ELEMTYPEREAL) a_a.m_rect.m_max[a_axis] / 2
+                        < (ELEMTYPEREAL) a_b.m_rect.m_min[a_axis] / 2 + (ELEMTYPEREAL) a_b.m_rect.m_max[a_axis] / 2;
+               } );
+
+    if( a_axis == NUMDIMS - 1 || count <= (size_t) MAXNODES )
+        return;
+
+    const size_t nodeCount = ( count + MAXNODES - 1 ) / MAXNODES;
+    const size_t slabCount = (size_t) std::ceil( std::pow( (double) nodeCount,
+                                                           1.0 / ( NUMDIMS - a_axis ) ) );
+    const size_t slabSize = MAXNODES * ( ( nodeCount + slabCount - 1 ) / slabCount );
+
+    for( size_t start = 0; start < count; start += slabSize )
+        StrSort( a_begin + start, a_begin + std::min( start + slabSize, count ), a_axis + 1 );
+}
+
+
 RTREE_TEMPLATE
 int RTREE_QUAL::Count() const
 {